@@ -0,0 +1,113 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "HeadlessContext.h"
+
+#include <EGL/eglext.h>
+
+#include <stdexcept>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+
+namespace {
+
+std::string eglErrorString(const char* what)
+{
+    char message[128];
+    std::snprintf(message, sizeof(message), "%s failed (EGL error 0x%x)", what, static_cast<unsigned>(eglGetError()));
+    return message;
+}
+
+EGLDisplay getSurfacelessDisplay()
+{
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay)
+    {
+        if (EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            display != EGL_NO_DISPLAY)
+        {
+            return display;
+        }
+    }
+    // the default display also works as long as EGL_KHR_surfaceless_context is supported
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+}// namespace
+
+HeadlessContext::HeadlessContext()
+{
+    display = getSurfacelessDisplay();
+    if (display == EGL_NO_DISPLAY)
+    {
+        throw std::runtime_error(eglErrorString("eglGetPlatformDisplayEXT"));
+    }
+
+    EGLint major = 0;
+    EGLint minor = 0;
+    if (!eglInitialize(display, &major, &minor))
+    {
+        throw std::runtime_error(eglErrorString("eglInitialize"));
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        throw std::runtime_error(eglErrorString("eglBindAPI"));
+    }
+
+    const EGLint configAttributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_NONE};
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &numConfigs) || numConfigs == 0)
+    {
+        // surfaceless displays may not expose any config, EGL_KHR_no_config_context covers that case
+        config = nullptr;
+    }
+
+    // llvmpipe only exposes 4.6 from Mesa 24.1 on, older drivers get the highest 4.x they support
+    for (EGLint minor = 6; minor >= 3 && context == EGL_NO_CONTEXT; --minor)
+    {
+        const EGLint contextAttributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION, 4,
+                EGL_CONTEXT_MINOR_VERSION, minor,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE};
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    }
+    if (context == EGL_NO_CONTEXT)
+    {
+        throw std::runtime_error(eglErrorString("eglCreateContext"));
+    }
+
+    makeCurrent();
+}
+
+HeadlessContext::~HeadlessContext()
+{
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context != EGL_NO_CONTEXT)
+    {
+        eglDestroyContext(display, context);
+    }
+    eglTerminate(display);
+}
+
+void HeadlessContext::makeCurrent() const
+{
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    {
+        throw std::runtime_error(eglErrorString("eglMakeCurrent"));
+    }
+}
+
+}// namespace bench
@@ -0,0 +1,33 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include <EGL/egl.h>
+
+namespace bench {
+
+/**
+ * @brief OpenGL 4.6 core context without any surface, created through EGL on the surfaceless platform.
+ *
+ * Works on machines without a GPU or a display server, e.g. with Mesa llvmpipe (LIBGL_ALWAYS_SOFTWARE=1).
+ * Rendering must target framebuffer objects since there is no default framebuffer.
+ */
+class HeadlessContext
+{
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    void makeCurrent() const;
+
+private:
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+};
+
+}// namespace bench
@@ -0,0 +1,731 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "Scenarios.h"
+
+#include "renderer/ImGuiInstance.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t UNIFORM_BUFFER_ALIGNMENT = 256;
+
+const char* SOLID_VERTEX_SHADER = R"(
+    #version 450
+    layout(location = 0) in vec2 aPos;
+    void main()
+    {
+        gl_Position = vec4(aPos, 0.0, 1.0);
+    }
+)";
+
+const char* SOLID_FRAGMENT_SHADER = R"(
+    #version 450
+    layout(location = 0) out vec4 FragColor;
+    void main()
+    {
+        FragColor = vec4(1.0, 0.5, 0.25, 1.0);
+    }
+)";
+
+const char* TEXTURED_VERTEX_SHADER = R"(
+    #version 450
+    layout(location = 0) in vec2 aPos;
+    layout(location = 0) out vec2 vTex;
+    void main()
+    {
+        vTex = aPos * 0.5 + 0.5;
+        gl_Position = vec4(aPos, 0.0, 1.0);
+    }
+)";
+
+const char* TEXTURED_FRAGMENT_SHADER = R"(
+    #version 450
+    layout(location = 0) in vec2 vTex;
+    layout(location = 0) out vec4 FragColor;
+    layout(binding = 1) uniform sampler2D tex;
+    void main()
+    {
+        FragColor = texture(tex, vTex);
+    }
+)";
+
+const char* STREAMING_VERTEX_SHADER = R"(
+    #version 450
+    layout(location = 0) in vec2 aPos;
+    layout(std140, binding = 0) uniform UBO
+    {
+        mat4 transform;
+    };
+    void main()
+    {
+        gl_Position = transform * vec4(aPos, 0.0, 1.0);
+    }
+)";
+
+const char* INSTANCED_VERTEX_SHADER = R"(
+    #version 450
+    layout(location = 0) in vec2 aPos;
+    layout(location = 1) in vec2 aOffset;
+    void main()
+    {
+        gl_Position = vec4(aPos + aOffset, 0.0, 1.0);
+    }
+)";
+
+const char* COMPUTE_SHADER = R"(
+    #version 450
+    layout(local_size_x = 64) in;
+    layout(std430, binding = 0) buffer Data
+    {
+        float values[];
+    };
+    void main()
+    {
+        values[gl_GlobalInvocationID.x] += 1.0;
+    }
+)";
+
+std::shared_ptr<IGraphicsPipeline> createPipeline(IDevice& device, const char* vertexShader, const char* fragmentShader, bool textured)
+{
+    auto vs = device.createShaderModule({.type = ShaderModuleType::Vertex, .code = vertexShader});
+    auto fs = device.createShaderModule({.type = ShaderModuleType::Fragment, .code = fragmentShader});
+    auto shaderStages = device.createPipelineShaderStages(PipelineShaderStagesDesc::fromRenderModules(vs, fs));
+
+    auto vertexInputState = device.createVertexInputState(VertexInputStateDescBuilder()
+                                                                  .beginBinding(0)
+                                                                  .addVertexAttribute(VertexAttributeFormat::Float2, "aPos", 0)
+                                                                  .endBinding()
+                                                                  .build());
+
+    GraphicsPipelineDesc desc = {
+            .shaderStages = shaderStages,
+            .vertexInputState = vertexInputState,
+            .colorBlendAttachmentStates = {ColorBlendAttachmentStateDesc{}},
+            .rasterizationState = {.cullMode = CullMode::None},
+    };
+    if (textured)
+    {
+        desc.fragmentUnitSamplerMap = {{1, "tex"}};
+    }
+    return device.createGraphicsPipeline(desc);
+}
+
+std::shared_ptr<IBuffer> createTriangleBuffer(IDevice& device)
+{
+    static constexpr std::array<float, 6> vertices = {
+            -0.01f, -0.01f,
+            0.01f, -0.01f,
+            0.0f, 0.01f};
+    return device.createBuffer(BufferDesc{
+            .type = BufferDesc::BufferTypeBits::Vertex,
+            .data = vertices.data(),
+            .size = sizeof(vertices),
+            .storage = ResourceStorage::Shared});
+}
+
+std::shared_ptr<ITexture> createCheckerTexture(IDevice& device, uint32_t size, uint32_t color)
+{
+    auto texture = device.createTexture(TextureDesc::new2D(TextureFormat::RGBA_UNorm8, size, size, TextureDesc::TextureUsageBits::Sampled));
+    std::vector<uint32_t> pixels(static_cast<size_t>(size) * size);
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            pixels[y * size + x] = ((x / 8 + y / 8) % 2) ? color : 0xff000000;
+        }
+    }
+    texture->upload(pixels.data(), TextureRangeDesc::new2D(0, 0, size, size));
+    return texture;
+}
+
+RenderPassBeginDesc renderPassDesc(const BenchmarkTarget& target)
+{
+    return {
+            .renderPass = {
+                    .colorAttachments = {
+                            RenderPassDesc::ColorAttachmentDesc{LoadAction::Clear, StoreAction::Store}}},
+            .framebuffer = target.framebuffer};
+}
+
+void bindTargetViewport(IGraphicsCommandBuffer& commandBuffer, const BenchmarkTarget& target)
+{
+    commandBuffer.bindViewport(Viewport{.x = 0, .y = 0, .width = static_cast<float>(target.width), .height = static_cast<float>(target.height)});
+    commandBuffer.bindScissor(ScissorRect{0, 0, target.width, target.height});
+}
+
+// N draws of a small triangle, all with the same pipeline and vertex buffer
+class SinglePipelineScenario : public IScenario
+{
+public:
+    explicit SinglePipelineScenario(uint32_t drawCount)
+        : drawCount(drawCount)
+    {}
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return "draw_single_pipeline";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return "draw";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        pipeline = createPipeline(target.device, SOLID_VERTEX_SHADER, SOLID_FRAGMENT_SHADER, false);
+        vertexBuffer = createTriangleBuffer(target.device);
+        depthStencilState = target.device.createDepthStencilState({});
+        commandPool = target.device.createCommandPool({});
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        auto commandBuffer = commandPool->acquireGraphicsCommandBuffer({});
+        commandBuffer->beginRenderPass(renderPassDesc(target));
+        bindTargetViewport(*commandBuffer, target);
+        commandBuffer->bindDepthStencilState(depthStencilState);
+        commandBuffer->bindGraphicsPipeline(pipeline);
+        commandBuffer->bindBuffer(0, vertexBuffer, 0);
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            commandBuffer->draw(PrimitiveType::Triangle, 0, 3);
+        }
+        commandBuffer->endRenderPass();
+        commandPool->submitCommandBuffer(std::move(commandBuffer));
+        return {drawCount, 0};
+    }
+
+private:
+    uint32_t drawCount;
+    std::shared_ptr<IGraphicsPipeline> pipeline;
+    std::shared_ptr<IBuffer> vertexBuffer;
+    std::shared_ptr<IDepthStencilState> depthStencilState;
+    std::shared_ptr<ICommandPool> commandPool;
+};
+
+// the N triangles of SinglePipelineScenario positioned by a per-instance vertex buffer, either as the instances of a
+// single draw or as N single-instance draws of one multi-draw-indirect call
+class InstancedScenario : public IScenario
+{
+public:
+    InstancedScenario(uint32_t instanceCount, bool indirect)
+        : instanceCount(instanceCount), indirect(indirect)
+    {}
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return indirect ? "draw_multi_indirect" : "draw_instanced";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return indirect ? "draw" : "instance";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        auto vs = target.device.createShaderModule({.type = ShaderModuleType::Vertex, .code = INSTANCED_VERTEX_SHADER});
+        auto fs = target.device.createShaderModule({.type = ShaderModuleType::Fragment, .code = SOLID_FRAGMENT_SHADER});
+        auto vertexInputState = target.device.createVertexInputState(VertexInputStateDescBuilder()
+                                                                             .beginBinding(0)
+                                                                             .addVertexAttribute(VertexAttributeFormat::Float2, "aPos", 0)
+                                                                             .endBinding()
+                                                                             .beginBinding(1, VertexInputRate::INSTANCE)
+                                                                             .addVertexAttribute(VertexAttributeFormat::Float2, "aOffset", 1)
+                                                                             .endBinding()
+                                                                             .build());
+        pipeline = target.device.createGraphicsPipeline({
+                .shaderStages = target.device.createPipelineShaderStages(PipelineShaderStagesDesc::fromRenderModules(vs, fs)),
+                .vertexInputState = vertexInputState,
+                .colorBlendAttachmentStates = {ColorBlendAttachmentStateDesc{}},
+                .rasterizationState = {.cullMode = CullMode::None},
+        });
+
+        std::vector<float> offsets(static_cast<size_t>(instanceCount) * 2);
+        for (uint32_t i = 0; i < instanceCount; ++i)
+        {
+            offsets[i * 2] = static_cast<float>(i % 256) / 128.0f - 1.0f;
+            offsets[i * 2 + 1] = static_cast<float>(i / 256 % 256) / 128.0f - 1.0f;
+        }
+        vertexBuffer = createTriangleBuffer(target.device);
+        instanceBuffer = target.device.createBuffer(BufferDesc{
+                .type = BufferDesc::BufferTypeBits::Vertex,
+                .data = offsets.data(),
+                .size = static_cast<uint32_t>(offsets.size() * sizeof(float)),
+                .storage = ResourceStorage::Shared});
+        indirect = indirect && target.device.hasFeature(DeviceFeatures::DrawIndexedIndirect);
+        if (indirect)
+        {
+            std::vector<DrawIndirectArgs> draws(instanceCount);
+            for (uint32_t i = 0; i < instanceCount; ++i)
+            {
+                draws[i] = {.vertexCount = 3, .instanceCount = 1, .firstVertex = 0, .baseInstance = i};
+            }
+            indirectBuffer = target.device.createBuffer(BufferDesc{
+                    .type = BufferDesc::BufferTypeBits::Indirect,
+                    .data = draws.data(),
+                    .size = static_cast<uint32_t>(draws.size() * sizeof(DrawIndirectArgs)),
+                    .storage = ResourceStorage::Managed});
+        }
+        depthStencilState = target.device.createDepthStencilState({});
+        commandPool = target.device.createCommandPool({});
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        auto commandBuffer = commandPool->acquireGraphicsCommandBuffer({});
+        commandBuffer->beginRenderPass(renderPassDesc(target));
+        bindTargetViewport(*commandBuffer, target);
+        commandBuffer->bindDepthStencilState(depthStencilState);
+        commandBuffer->bindGraphicsPipeline(pipeline);
+        commandBuffer->bindBuffer(0, vertexBuffer, 0);
+        commandBuffer->bindBuffer(1, instanceBuffer, 0);
+        if (indirect)
+        {
+            commandBuffer->drawIndirect(PrimitiveType::Triangle, *indirectBuffer, 0, instanceCount, 0);
+        }
+        else
+        {
+            commandBuffer->drawInstanced(PrimitiveType::Triangle, 0, 3, instanceCount, 0);
+        }
+        commandBuffer->endRenderPass();
+        commandPool->submitCommandBuffer(std::move(commandBuffer));
+        return {instanceCount, 0};
+    }
+
+private:
+    uint32_t instanceCount;
+    bool indirect;
+    std::shared_ptr<IGraphicsPipeline> pipeline;
+    std::shared_ptr<IBuffer> vertexBuffer;
+    std::shared_ptr<IBuffer> instanceBuffer;
+    std::shared_ptr<IBuffer> indirectBuffer;
+    std::shared_ptr<IDepthStencilState> depthStencilState;
+    std::shared_ptr<ICommandPool> commandPool;
+};
+
+// N draws switching pipeline and texture on every draw, the worst case for state changes
+class AlternatingStateScenario : public IScenario
+{
+public:
+    explicit AlternatingStateScenario(uint32_t drawCount)
+        : drawCount(drawCount)
+    {}
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return "draw_alternating_state";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return "draw";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        // two pipelines, each one with its own program
+        pipelines[0] = createPipeline(target.device, TEXTURED_VERTEX_SHADER, TEXTURED_FRAGMENT_SHADER, true);
+        pipelines[1] = createPipeline(target.device, TEXTURED_VERTEX_SHADER, TEXTURED_FRAGMENT_SHADER, true);
+        textures[0] = createCheckerTexture(target.device, 64, 0xff00ffff);
+        textures[1] = createCheckerTexture(target.device, 64, 0xffff00ff);
+        samplerState = target.device.createSamplerState(SamplerStateDesc::newLinear());
+        vertexBuffer = createTriangleBuffer(target.device);
+        depthStencilState = target.device.createDepthStencilState({});
+        commandPool = target.device.createCommandPool({});
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        auto commandBuffer = commandPool->acquireGraphicsCommandBuffer({});
+        commandBuffer->beginRenderPass(renderPassDesc(target));
+        bindTargetViewport(*commandBuffer, target);
+        commandBuffer->bindDepthStencilState(depthStencilState);
+        commandBuffer->bindSamplerState(1, BindTarget::BindTarget_Fragment, samplerState);
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            commandBuffer->bindGraphicsPipeline(pipelines[i % 2]);
+            commandBuffer->bindBuffer(0, vertexBuffer, 0);
+            commandBuffer->bindTexture(1, BindTarget::BindTarget_Fragment, textures[(i / 2) % 2]);
+            commandBuffer->draw(PrimitiveType::Triangle, 0, 3);
+        }
+        commandBuffer->endRenderPass();
+        commandPool->submitCommandBuffer(std::move(commandBuffer));
+        return {drawCount, 0};
+    }
+
+private:
+    uint32_t drawCount;
+    std::array<std::shared_ptr<IGraphicsPipeline>, 2> pipelines;
+    std::array<std::shared_ptr<ITexture>, 2> textures;
+    std::shared_ptr<ISamplerState> samplerState;
+    std::shared_ptr<IBuffer> vertexBuffer;
+    std::shared_ptr<IDepthStencilState> depthStencilState;
+    std::shared_ptr<ICommandPool> commandPool;
+};
+
+// N draws, each one writing a fresh transform into its own range of a uniform buffer,
+// either through IBuffer::data or by sub-allocating from a persistently mapped ring buffer
+class UniformStreamingScenario : public IScenario
+{
+public:
+    UniformStreamingScenario(uint32_t drawCount, bool useRing)
+        : drawCount(drawCount), useRing(useRing)
+    {}
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return useRing ? "uniform_streaming_ring" : "uniform_streaming";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return "draw";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        pipeline = createPipeline(target.device, STREAMING_VERTEX_SHADER, SOLID_FRAGMENT_SHADER, false);
+        vertexBuffer = createTriangleBuffer(target.device);
+        useRing = useRing && target.device.hasFeature(DeviceFeatures::BufferRing);
+        // the ring holds a few frames worth of transforms so the CPU rarely waits on the GPU
+        uniformBuffer = target.device.createBuffer(BufferDesc{
+                .type = BufferDesc::BufferTypeBits::Uniform,
+                .data = nullptr,
+                .size = drawCount * UNIFORM_BUFFER_ALIGNMENT * (useRing ? 3 : 1),
+                .storage = useRing ? ResourceStorage::Ring : ResourceStorage::Shared});
+        depthStencilState = target.device.createDepthStencilState({});
+        commandPool = target.device.createCommandPool({});
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        auto commandBuffer = commandPool->acquireGraphicsCommandBuffer({});
+        commandBuffer->beginRenderPass(renderPassDesc(target));
+        bindTargetViewport(*commandBuffer, target);
+        commandBuffer->bindDepthStencilState(depthStencilState);
+        commandBuffer->bindGraphicsPipeline(pipeline);
+        commandBuffer->bindBuffer(0, vertexBuffer, 0);
+
+        std::array<float, 16> transform = {
+                1.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 1.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 1.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 1.0f};
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            transform[12] = static_cast<float>(i % 100) * 0.02f - 1.0f;
+            transform[13] = static_cast<float>(i / 100 % 100) * 0.02f - 1.0f;
+            uint32_t offset = i * UNIFORM_BUFFER_ALIGNMENT;
+            if (useRing)
+            {
+                auto allocation = uniformBuffer->allocate(sizeof(transform));
+                std::memcpy(allocation.data, transform.data(), sizeof(transform));
+                offset = allocation.offset;
+            }
+            else
+            {
+                uniformBuffer->data(transform.data(), sizeof(transform), offset);
+            }
+            commandBuffer->bindBuffer(0, uniformBuffer, offset);
+            commandBuffer->draw(PrimitiveType::Triangle, 0, 3);
+        }
+        commandBuffer->endRenderPass();
+        commandPool->submitCommandBuffer(std::move(commandBuffer));
+        return {drawCount, static_cast<uint64_t>(drawCount) * sizeof(transform)};
+    }
+
+private:
+    uint32_t drawCount;
+    bool useRing;
+    std::shared_ptr<IGraphicsPipeline> pipeline;
+    std::shared_ptr<IBuffer> vertexBuffer;
+    std::shared_ptr<IBuffer> uniformBuffer;
+    std::shared_ptr<IDepthStencilState> depthStencilState;
+    std::shared_ptr<ICommandPool> commandPool;
+};
+
+// N draws of distinct small meshes, each one with its own vertex and index buffer, either as buffer objects of
+// their own or sub-allocated from the device buffer heaps
+class ManyMeshesScenario : public IScenario
+{
+public:
+    ManyMeshesScenario(uint32_t drawCount, bool subAllocate)
+        : drawCount(drawCount), subAllocate(subAllocate)
+    {}
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return subAllocate ? "draw_many_meshes_heap" : "draw_many_meshes";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return "draw";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        pipeline = createPipeline(target.device, SOLID_VERTEX_SHADER, SOLID_FRAGMENT_SHADER, false);
+        depthStencilState = target.device.createDepthStencilState({});
+        commandPool = target.device.createCommandPool({});
+
+        constexpr std::array<uint16_t, 6> indices = {0, 1, 2, 2, 1, 3};
+        meshes.resize(std::min(drawCount, MAX_MESHES));
+        for (uint32_t i = 0; i < meshes.size(); ++i)
+        {
+            const float x = static_cast<float>(i % 64) / 32.0f - 1.0f;
+            const float y = static_cast<float>(i / 64 % 64) / 32.0f - 1.0f;
+            const std::array<float, 8> vertices = {
+                    x, y,
+                    x + 0.02f, y,
+                    x, y + 0.02f,
+                    x + 0.02f, y + 0.02f};
+            meshes[i].vertexBuffer = target.device.createBuffer(BufferDesc{
+                    .type = BufferDesc::BufferTypeBits::Vertex,
+                    .data = vertices.data(),
+                    .size = sizeof(vertices),
+                    .storage = ResourceStorage::Managed,
+                    .subAllocate = subAllocate,
+                    .vertexStride = 2 * sizeof(float)});
+            meshes[i].indexBuffer = target.device.createBuffer(BufferDesc{
+                    .type = BufferDesc::BufferTypeBits::Index,
+                    .data = indices.data(),
+                    .size = sizeof(indices),
+                    .storage = ResourceStorage::Managed,
+                    .subAllocate = subAllocate});
+        }
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        auto commandBuffer = commandPool->acquireGraphicsCommandBuffer({});
+        commandBuffer->beginRenderPass(renderPassDesc(target));
+        bindTargetViewport(*commandBuffer, target);
+        commandBuffer->bindDepthStencilState(depthStencilState);
+        commandBuffer->bindGraphicsPipeline(pipeline);
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            const auto& mesh = meshes[i % meshes.size()];
+            commandBuffer->bindBuffer(0, mesh.vertexBuffer, 0);
+            commandBuffer->drawIndexed(PrimitiveType::Triangle, 6, IndexFormat::UInt16, *mesh.indexBuffer, 0);
+        }
+        commandBuffer->endRenderPass();
+        commandPool->submitCommandBuffer(std::move(commandBuffer));
+        return {drawCount, 0};
+    }
+
+private:
+    static constexpr uint32_t MAX_MESHES = 4096;
+
+    struct Mesh
+    {
+        std::shared_ptr<IBuffer> vertexBuffer;
+        std::shared_ptr<IBuffer> indexBuffer;
+    };
+
+    uint32_t drawCount;
+    bool subAllocate;
+    std::vector<Mesh> meshes;
+    std::shared_ptr<IGraphicsPipeline> pipeline;
+    std::shared_ptr<IDepthStencilState> depthStencilState;
+    std::shared_ptr<ICommandPool> commandPool;
+};
+
+// full uploads of a set of RGBA8 textures, either synchronous or through the staging queue of uploadAsync
+class TextureUploadScenario : public IScenario
+{
+public:
+    TextureUploadScenario(uint32_t textureCount, uint32_t textureSize, bool async)
+        : textureCount(textureCount)
+        , textureSize(textureSize)
+        , async(async)
+    {}
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return async ? "texture_upload_async" : "texture_upload";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return "upload";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        for (uint32_t i = 0; i < textureCount; ++i)
+        {
+            textures.push_back(target.device.createTexture(TextureDesc::new2D(TextureFormat::RGBA_UNorm8, textureSize, textureSize, TextureDesc::TextureUsageBits::Sampled)));
+        }
+        pixels.resize(static_cast<size_t>(textureSize) * textureSize);
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = static_cast<uint32_t>(i * 2654435761u);
+        }
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        const auto range = TextureRangeDesc::new2D(0, 0, textureSize, textureSize);
+        for (auto& texture : textures)
+        {
+            if (async)
+            {
+                texture->uploadAsync(pixels.data(), range);
+            }
+            else
+            {
+                texture->upload(pixels.data(), range);
+            }
+        }
+        return {textureCount, static_cast<uint64_t>(textureCount) * pixels.size() * sizeof(uint32_t)};
+    }
+
+private:
+    uint32_t textureCount;
+    uint32_t textureSize;
+    bool async;
+    std::vector<std::shared_ptr<ITexture>> textures;
+    std::vector<uint32_t> pixels;
+};
+
+// N dispatches of a small compute shader incrementing a storage buffer
+class ComputeDispatchScenario : public IScenario
+{
+public:
+    explicit ComputeDispatchScenario(uint32_t dispatchCount)
+        : dispatchCount(dispatchCount)
+    {}
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return "compute_dispatch";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return "dispatch";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        auto cs = target.device.createShaderModule({.type = ShaderModuleType::Compute, .code = COMPUTE_SHADER});
+        auto shaderStages = target.device.createPipelineShaderStages(PipelineShaderStagesDesc::fromComputeModule(cs));
+        pipeline = target.device.createComputePipeline({.shaderStages = shaderStages, .buffersMap = {{0, "Data"}}});
+
+        std::vector<float> values(64 * 64, 0.0f);
+        storageBuffer = target.device.createBuffer(BufferDesc{
+                .type = BufferDesc::BufferTypeBits::Storage,
+                .data = values.data(),
+                .size = static_cast<uint32_t>(values.size() * sizeof(float)),
+                .storage = ResourceStorage::Shared});
+        commandPool = target.device.createCommandPool({});
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        auto commandBuffer = commandPool->acquireComputeCommandBuffer({});
+        commandBuffer->begin();
+        commandBuffer->bindComputePipeline(pipeline);
+        commandBuffer->bindBuffer(0, storageBuffer, 0);
+        for (uint32_t i = 0; i < dispatchCount; ++i)
+        {
+            commandBuffer->dispatch({64, 1, 1});
+        }
+        commandBuffer->end();
+        commandPool->submitCommandBuffer(std::move(commandBuffer));
+        return {dispatchCount, 0};
+    }
+
+private:
+    uint32_t dispatchCount;
+    std::shared_ptr<IComputePipeline> pipeline;
+    std::shared_ptr<IBuffer> storageBuffer;
+    std::shared_ptr<ICommandPool> commandPool;
+};
+
+// replays the ImGui demo window with a fixed time step, so every run records the same draw lists
+class ImGuiDemoScenario : public IScenario
+{
+public:
+    ~ImGuiDemoScenario() override
+    {
+        if (instance)
+        {
+            instance->shutdown();
+        }
+    }
+
+    [[nodiscard]] const char* getName() const override
+    {
+        return "imgui_demo";
+    }
+    [[nodiscard]] const char* getOperationName() const override
+    {
+        return "draw";
+    }
+
+    void setup(BenchmarkTarget& target) override
+    {
+        instance = std::make_unique<imgui::ImGuiInstance>(imgui::ImGuiInstanceDesc{});
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(static_cast<float>(target.width), static_cast<float>(target.height));
+        io.DeltaTime = 1.0f / 60.0f;
+        io.IniFilename = nullptr;
+        instance->initialize(target.device, target.width, target.height);
+        commandPool = target.device.createCommandPool({});
+    }
+
+    FrameWork runFrame(BenchmarkTarget& target) override
+    {
+        instance->beginFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(static_cast<float>(target.width), static_cast<float>(target.height)));
+        ImGui::ShowDemoWindow();
+        instance->endFrame();
+
+        auto commandBuffer = commandPool->acquireGraphicsCommandBuffer({});
+        commandBuffer->beginRenderPass(renderPassDesc(target));
+        instance->renderFrame(target.device, *commandBuffer, nullptr, target.width, target.height);
+        commandBuffer->endRenderPass();
+        commandPool->submitCommandBuffer(std::move(commandBuffer));
+
+        FrameWork work;
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        for (int i = 0; i < drawData->CmdListsCount; ++i)
+        {
+            const ImDrawList* drawList = drawData->CmdLists[i];
+            work.operations += drawList->CmdBuffer.Size;
+            work.bytes += drawList->VtxBuffer.Size * sizeof(ImDrawVert) + drawList->IdxBuffer.Size * sizeof(ImDrawIdx);
+        }
+        return work;
+    }
+
+private:
+    std::unique_ptr<imgui::ImGuiInstance> instance;
+    std::shared_ptr<ICommandPool> commandPool;
+};
+
+}// namespace
+
+std::vector<std::unique_ptr<IScenario>> createScenarios(const ScenarioParams& params)
+{
+    std::vector<std::unique_ptr<IScenario>> scenarios;
+    scenarios.push_back(std::make_unique<SinglePipelineScenario>(params.operationsPerFrame));
+    scenarios.push_back(std::make_unique<InstancedScenario>(params.operationsPerFrame, false));
+    scenarios.push_back(std::make_unique<InstancedScenario>(params.operationsPerFrame, true));
+    scenarios.push_back(std::make_unique<AlternatingStateScenario>(params.operationsPerFrame));
+    scenarios.push_back(std::make_unique<ManyMeshesScenario>(params.operationsPerFrame, false));
+    scenarios.push_back(std::make_unique<ManyMeshesScenario>(params.operationsPerFrame, true));
+    scenarios.push_back(std::make_unique<UniformStreamingScenario>(params.operationsPerFrame, false));
+    scenarios.push_back(std::make_unique<UniformStreamingScenario>(params.operationsPerFrame, true));
+    scenarios.push_back(std::make_unique<TextureUploadScenario>(params.texturesPerFrame, params.textureSize, false));
+    scenarios.push_back(std::make_unique<TextureUploadScenario>(params.texturesPerFrame, params.textureSize, true));
+    scenarios.push_back(std::make_unique<ComputeDispatchScenario>(params.operationsPerFrame));
+    scenarios.push_back(std::make_unique<ImGuiDemoScenario>());
+    return scenarios;
+}
+
+}// namespace bench
@@ -0,0 +1,58 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/Device.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct BenchmarkTarget
+{
+    IDevice& device;
+    std::shared_ptr<IFramebuffer> framebuffer;
+    uint32_t width;
+    uint32_t height;
+};
+
+/**
+ * @brief Work done by one frame of a scenario. An operation is a draw, a dispatch or a texture upload.
+ */
+struct FrameWork
+{
+    uint64_t operations = 0;
+    uint64_t bytes = 0;
+};
+
+class IScenario
+{
+public:
+    virtual ~IScenario() = default;
+
+    [[nodiscard]] virtual const char* getName() const = 0;
+    // what a single operation of the scenario is, used as the unit of the report
+    [[nodiscard]] virtual const char* getOperationName() const = 0;
+
+    virtual void setup(BenchmarkTarget& target) = 0;
+    // records and submits one frame
+    virtual FrameWork runFrame(BenchmarkTarget& target) = 0;
+};
+
+struct ScenarioParams
+{
+    // draws or dispatches recorded per frame
+    uint32_t operationsPerFrame = 10000;
+    // textures uploaded per frame by the texture upload scenario
+    uint32_t texturesPerFrame = 16;
+    uint32_t textureSize = 512;
+};
+
+std::vector<std::unique_ptr<IScenario>> createScenarios(const ScenarioParams& params);
+
+}// namespace bench
@@ -0,0 +1,201 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "HeadlessContext.h"
+#include "Scenarios.h"
+
+#include "graphicsAPI/opengl/Context.h"
+#include "graphicsAPI/opengl/Device.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+struct Options
+{
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    uint32_t warmupFrames = 10;
+    uint32_t frames = 100;
+    std::string_view scenario;
+    bench::ScenarioParams params;
+};
+
+void printUsage(const char* program)
+{
+    std::cout << "usage: " << program << " [options]\n"
+              << "  --scenario <name>   only run the given scenario\n"
+              << "  --frames <n>        measured frames per scenario (default 100)\n"
+              << "  --warmup <n>        frames run before measuring (default 10)\n"
+              << "  --ops <n>           draws or dispatches per frame (default 10000)\n"
+              << "  --textures <n>      textures uploaded per frame (default 16)\n"
+              << "  --texture-size <n>  width and height of the uploaded textures (default 512)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc)
+        {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--scenario")
+        {
+            options.scenario = value;
+        }
+        else if (arg == "--frames")
+        {
+            options.frames = std::strtoul(value, nullptr, 10);
+        }
+        else if (arg == "--warmup")
+        {
+            options.warmupFrames = std::strtoul(value, nullptr, 10);
+        }
+        else if (arg == "--ops")
+        {
+            options.params.operationsPerFrame = std::strtoul(value, nullptr, 10);
+        }
+        else if (arg == "--textures")
+        {
+            options.params.texturesPerFrame = std::strtoul(value, nullptr, 10);
+        }
+        else if (arg == "--texture-size")
+        {
+            options.params.textureSize = std::strtoul(value, nullptr, 10);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return options.frames > 0;
+}
+
+struct ScenarioResult
+{
+    uint64_t operations = 0;
+    uint64_t bytes = 0;
+    uint64_t glCalls = 0;
+    // recording and submission, on the CPU
+    std::chrono::nanoseconds cpuTime{0};
+    // including glFinish, so it also covers the time the driver takes to execute the frame
+    std::chrono::nanoseconds frameTime{0};
+};
+
+ScenarioResult runScenario(bench::IScenario& scenario, bench::BenchmarkTarget& target, opengl::Context& context, const Options& options)
+{
+    using clock = std::chrono::steady_clock;
+
+    scenario.setup(target);
+    for (uint32_t i = 0; i < options.warmupFrames; ++i)
+    {
+        context.beginFrame();
+        scenario.runFrame(target);
+        context.endFrame();
+        glFinish();
+    }
+
+    ScenarioResult result;
+    for (uint32_t i = 0; i < options.frames; ++i)
+    {
+        context.beginFrame();
+        const auto start = clock::now();
+        const auto work = scenario.runFrame(target);
+        const auto recorded = clock::now();
+        context.endFrame();
+        glFinish();
+        const auto finished = clock::now();
+
+        result.operations += work.operations;
+        result.bytes += work.bytes;
+        result.glCalls += context.getFrameStats().getTotalCallCount();
+        result.cpuTime += recorded - start;
+        result.frameTime += finished - start;
+    }
+    return result;
+}
+
+void printResult(const bench::IScenario& scenario, const ScenarioResult& result, const Options& options)
+{
+    const double operations = static_cast<double>(std::max<uint64_t>(result.operations, 1));
+    const double nsPerOperation = static_cast<double>(result.cpuTime.count()) / operations;
+    const double frameMs = static_cast<double>(result.frameTime.count()) / 1e6 / options.frames;
+    const double seconds = static_cast<double>(result.frameTime.count()) / 1e9;
+    const double megabytesPerSecond = seconds > 0.0 ? static_cast<double>(result.bytes) / 1e6 / seconds : 0.0;
+
+    char glCallsPerOperation[32] = "n/a";
+    if (opengl::Context::isStatsEnabled())
+    {
+        std::snprintf(glCallsPerOperation, sizeof(glCallsPerOperation), "%.2f", static_cast<double>(result.glCalls) / operations);
+    }
+
+    std::printf("%-24s %-9s %12.0f %12.1f %14s %12.1f %10.2f\n",
+                scenario.getName(),
+                scenario.getOperationName(),
+                static_cast<double>(result.operations) / options.frames,
+                nsPerOperation,
+                glCallsPerOperation,
+                megabytesPerSecond,
+                frameMs);
+}
+
+}// namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        bench::HeadlessContext headlessContext;
+
+        auto device = std::make_unique<opengl::Device>(std::make_unique<opengl::Context>());
+        auto& context = device->getContext();
+
+        std::cout << "renderer: " << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << "\n"
+                  << "version:  " << reinterpret_cast<const char*>(glGetString(GL_VERSION)) << "\n";
+        if (!opengl::Context::isStatsEnabled())
+        {
+            std::cout << "GL call counts are unavailable, configure with -DGRAPHICSAPI_CONTEXT_STATS=ON\n";
+        }
+        std::cout << "\n";
+
+        // there is no default framebuffer without a surface, every scenario renders into this one
+        auto colorTexture = device->createTexture(TextureDesc::new2D(TextureFormat::RGBA_UNorm8, options.width, options.height, TextureDesc::TextureUsageBits::Attachment));
+        FramebufferDesc framebufferDesc;
+        framebufferDesc.colorAttachments[0].texture = colorTexture;
+        bench::BenchmarkTarget target{*device, device->createFramebuffer(framebufferDesc), options.width, options.height};
+
+        std::printf("%-24s %-9s %12s %12s %14s %12s %10s\n", "scenario", "op", "ops/frame", "ns/op", "GL calls/op", "MB/s", "frame ms");
+        for (auto& scenario : bench::createScenarios(options.params))
+        {
+            if (!options.scenario.empty() && options.scenario != scenario->getName())
+            {
+                continue;
+            }
+            const auto result = runScenario(*scenario, target, context, options);
+            printResult(*scenario, result, options);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
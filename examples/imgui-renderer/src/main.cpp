@@ -33,6 +33,7 @@ int main()
     // OpenGL Context init
     auto oglContext = std::make_unique<opengl::Context>();
     std::unique_ptr<IDevice> device = std::make_unique<opengl::Device>(std::move(oglContext));
+    auto& glContext = static_cast<opengl::Device&>(*device).getContext();
 
     // Initialize the ImGui context
     imgui::ImGuiInstance imguiInstance({});
@@ -59,6 +60,13 @@ int main()
         {
             ImGui::Begin("Menu");// Create a window called "Hello, world!" and append into it.
             ImGui::Text("Hello, world!");
+            if (opengl::Context::isStatsEnabled())
+            {
+                const auto& stats = glContext.getFrameStats();
+                ImGui::Text("GL calls: %llu (%llu redundant)", static_cast<unsigned long long>(stats.getTotalCallCount()), static_cast<unsigned long long>(stats.getTotalRedundantCallCount()));
+                ImGui::Text("Draw calls: %u", stats.getDrawCallCount());
+                ImGui::Text("Uploaded: %llu buffer bytes, %llu texture bytes", static_cast<unsigned long long>(stats.bufferUploadBytes), static_cast<unsigned long long>(stats.textureUploadBytes));
+            }
             ImGui::ShowDemoWindow();
             ImGui::End();// End of ImGui window
         }
@@ -68,6 +76,8 @@ int main()
 
         // After ending the ImGui frame, we render the ImGui frame onto the current frame
         {
+            glContext.beginFrame();
+
             auto commandPool = device->createCommandPool({});
             auto commandBuffer = commandPool->acquireGraphicsCommandBuffer({});
 
@@ -87,6 +97,8 @@ int main()
             commandBuffer->endRenderPass();
 
             commandPool->submitCommandBuffer(std::move(commandBuffer));
+
+            glContext.endFrame();
         }
 
         glfwSwapBuffers(window);
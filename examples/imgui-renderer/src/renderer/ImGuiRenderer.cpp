@@ -3,10 +3,31 @@
 //
 
 #include "ImGuiRenderer.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace imgui {
 
+namespace {
+
+BufferAllocation allocateFromRing(IDevice& device, std::shared_ptr<IBuffer>& ringBuffer, BufferDesc::BufferType type, size_t size)
+{
+    if (size <= ringBuffer->getSize())
+    {
+        if (auto allocation = ringBuffer->tryAllocate(static_cast<uint32_t>(size)))
+        {
+            return *allocation;
+        }
+    }
+    // the frame outgrows the ring, the command buffers that bound the previous one keep it alive
+    const size_t ringSize = std::max(ringBuffer->getSize(), size) * 2;
+    ringBuffer = device.createBuffer(BufferDesc{ .type = type, .data = nullptr, .size = static_cast<uint32_t>(ringSize), .storage = ResourceStorage::Ring});
+    return ringBuffer->allocate(static_cast<uint32_t>(size));
+}
+
+}// namespace
+
 void ImGuiRenderer::initialize(IDevice& device, uint32_t width, uint32_t height)
 {
     // Create buffers
@@ -14,6 +35,15 @@ void ImGuiRenderer::initialize(IDevice& device, uint32_t width, uint32_t height)
         vertexBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Vertex, .data = nullptr, .size = 0, .storage = ResourceStorage::Shared});
         indexBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Index, .data = nullptr, .size = 0, .storage = ResourceStorage::Shared});
         uniformBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Uniform, .data = nullptr, .size = 4*4*sizeof(float), .storage = ResourceStorage::Shared});
+
+        useRingBuffers = device.hasFeature(DeviceFeatures::BufferRing);
+        if (useRingBuffers)
+        {
+            // sized for a few frames in flight of a busy UI, replaced by larger rings when a frame outgrows them
+            vertexRingBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Vertex, .data = nullptr, .size = 4 * 1024 * 1024, .storage = ResourceStorage::Ring});
+            indexRingBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Index, .data = nullptr, .size = 1024 * 1024, .storage = ResourceStorage::Ring});
+            uniformRingBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Uniform, .data = nullptr, .size = 64 * 1024, .storage = ResourceStorage::Ring});
+        }
     }
 
     // Create font texture
@@ -28,6 +58,8 @@ void ImGuiRenderer::initialize(IDevice& device, uint32_t width, uint32_t height)
         fontTexture->upload(pixels, TextureRangeDesc::new2D(0, 0, texWidth, texHeight));
 
         io.Fonts->TexID = (ImTextureID)fontTexture.get();
+        // draws address their vertices through a base vertex, so meshes may exceed 64k vertices with 16-bit indices
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
     }
 
     // Create sampler state
@@ -127,18 +159,13 @@ void ImGuiRenderer::newFrame()
 {
 }
 
-void ImGuiRenderer::setupRenderState(ImDrawData* drawData, std::shared_ptr<IGraphicsPipeline>& pipeline, IGraphicsCommandBuffer& commandBuffer, uint32_t fbWidth, uint32_t fbHeight)
+void ImGuiRenderer::setupRenderState(ImDrawData* drawData, IDevice& device, std::shared_ptr<IGraphicsPipeline>& pipeline, IGraphicsCommandBuffer& commandBuffer, uint32_t fbWidth, uint32_t fbHeight)
 {
     // Bind pipeline
     {
         commandBuffer.bindGraphicsPipeline(pipeline);
     }
 
-    // Bind vertex buffer
-    {
-        commandBuffer.bindBuffer(0, vertexBuffer, 0);
-    }
-
     {
         commandBuffer.bindViewport(Viewport{.x = 0, .y = 0, .width = static_cast<float>(fbWidth), .height = static_cast<float>(fbHeight)});
     }
@@ -157,9 +184,17 @@ void ImGuiRenderer::setupRenderState(ImDrawData* drawData, std::shared_ptr<IGrap
                 { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
         };
 
-        uniformBuffer->data(ortho_projection, 4*4*sizeof(float), 0);
-
-        commandBuffer.bindBuffer(0, uniformBuffer, 0);
+        if (useRingBuffers)
+        {
+            auto allocation = allocateFromRing(device, uniformRingBuffer, BufferDesc::BufferTypeBits::Uniform, sizeof(ortho_projection));
+            std::memcpy(allocation.data, ortho_projection, sizeof(ortho_projection));
+            commandBuffer.bindBuffer(0, uniformRingBuffer, allocation.offset);
+        }
+        else
+        {
+            uniformBuffer->data(ortho_projection, 4*4*sizeof(float), 0);
+            commandBuffer.bindBuffer(0, uniformBuffer, 0);
+        }
     }
 
     // Bind sampler state
@@ -181,7 +216,7 @@ void ImGuiRenderer::renderDrawData(ImDrawData* drawData, IDevice& device, IGraph
         return;
 
     // Setup render state
-    setupRenderState(drawData, pipeline, commandBuffer, fbWidth, fbHeight);
+    setupRenderState(drawData, device, pipeline, commandBuffer, fbWidth, fbHeight);
 
     Viewport viewport = {
             /*.x = */ 0.0,
@@ -193,28 +228,79 @@ void ImGuiRenderer::renderDrawData(ImDrawData* drawData, IDevice& device, IGraph
     ImVec2 clip_off = drawData->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = drawData->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
-    // Render command lists
-    for (int n = 0; n < drawData->CmdListsCount; n++)
+    const size_t vertexBufferSize = drawData->TotalVtxCount * sizeof(ImDrawVert);
+    const size_t indexBufferSize = drawData->TotalIdxCount * sizeof(ImDrawIdx);
+    if (vertexBufferSize == 0 || indexBufferSize == 0)
     {
-        const ImDrawList* cmd_list = drawData->CmdLists[n];
-
-        const size_t vertexBufferSize = cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
-        const size_t indexBufferSize = cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+        return;
+    }
 
+    // All the command lists of the frame are packed in one vertex and one index buffer, draws address the geometry of
+    // their list through a base vertex and an index offset, so the vertex attributes are set up once per frame
+    std::shared_ptr<IBuffer> drawVertexBuffer;
+    IBuffer* drawIndexBuffer = nullptr;
+    uint32_t vertexBufferOffset = 0;
+    size_t indexBufferOffset = 0;
+    std::byte* vertexData = nullptr;
+    std::byte* indexData = nullptr;
+    if (useRingBuffers)
+    {
+        // write straight into the persistently mapped ring buffers, no driver copy nor implicit sync
+        auto vertexAllocation = allocateFromRing(device, vertexRingBuffer, BufferDesc::BufferTypeBits::Vertex, vertexBufferSize);
+        auto indexAllocation = allocateFromRing(device, indexRingBuffer, BufferDesc::BufferTypeBits::Index, indexBufferSize);
+        drawVertexBuffer = vertexRingBuffer;
+        drawIndexBuffer = indexRingBuffer.get();
+        vertexBufferOffset = vertexAllocation.offset;
+        indexBufferOffset = indexAllocation.offset;
+        vertexData = static_cast<std::byte*>(vertexAllocation.data);
+        indexData = static_cast<std::byte*>(indexAllocation.data);
+    }
+    else
+    {
         // Update vertex and index buffer if needed
         if (vertexBuffer == nullptr || vertexBuffer->getSize() < vertexBufferSize)
         {
             vertexBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Vertex, .data = nullptr, .size = static_cast<uint32_t>(vertexBufferSize), .storage = ResourceStorage::Shared});
-            commandBuffer.bindBuffer(0, vertexBuffer, 0);
         }
         if (indexBuffer == nullptr || indexBuffer->getSize() < indexBufferSize)
         {
             indexBuffer = device.createBuffer(BufferDesc{ .type = BufferDesc::BufferTypeBits::Index, .data = nullptr, .size = static_cast<uint32_t>(indexBufferSize), .storage = ResourceStorage::Shared});
         }
+        drawVertexBuffer = vertexBuffer;
+        drawIndexBuffer = indexBuffer.get();
+    }
+
+    // Upload vertex and index data
+    {
+        size_t vertexOffset = 0;
+        size_t indexOffset = 0;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = drawData->CmdLists[n];
+            const size_t listVertexSize = cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+            const size_t listIndexSize = cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+            if (useRingBuffers)
+            {
+                std::memcpy(vertexData + vertexOffset, cmd_list->VtxBuffer.Data, listVertexSize);
+                std::memcpy(indexData + indexOffset, cmd_list->IdxBuffer.Data, listIndexSize);
+            }
+            else
+            {
+                vertexBuffer->data(cmd_list->VtxBuffer.Data, listVertexSize, vertexOffset);
+                indexBuffer->data(cmd_list->IdxBuffer.Data, listIndexSize, indexOffset);
+            }
+            vertexOffset += listVertexSize;
+            indexOffset += listIndexSize;
+        }
+    }
+    commandBuffer.bindBuffer(0, drawVertexBuffer, vertexBufferOffset);
 
-        // Upload vertex and index data
-        vertexBuffer->data(cmd_list->VtxBuffer.Data, vertexBufferSize, 0);
-        indexBuffer->data(cmd_list->IdxBuffer.Data, indexBufferSize, 0);
+    // Render command lists
+    int32_t globalVertexOffset = 0;
+    size_t globalIndexOffset = 0;
+    for (int n = 0; n < drawData->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = drawData->CmdLists[n];
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -252,9 +338,13 @@ void ImGuiRenderer::renderDrawData(ImDrawData* drawData, IDevice& device, IGraph
                 }
 
                 // Draw
-                commandBuffer.drawIndexed(PrimitiveType::Triangle, pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? IndexFormat::UInt16 : IndexFormat::UInt32, *indexBuffer, pcmd->IdxOffset * sizeof(ImDrawIdx));
+                commandBuffer.drawIndexed(PrimitiveType::Triangle, pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? IndexFormat::UInt16 : IndexFormat::UInt32, *drawIndexBuffer,
+                                          indexBufferOffset + (globalIndexOffset + pcmd->IdxOffset) * sizeof(ImDrawIdx),
+                                          globalVertexOffset + static_cast<int32_t>(pcmd->VtxOffset));
             }
         }
+        globalVertexOffset += cmd_list->VtxBuffer.Size;
+        globalIndexOffset += cmd_list->IdxBuffer.Size;
     }
 }
 
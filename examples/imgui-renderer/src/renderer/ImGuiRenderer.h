@@ -17,7 +17,7 @@ public:
 
     void initialize(IDevice& device, uint32_t width, uint32_t height);
     void newFrame();
-    void setupRenderState(ImDrawData* drawData, std::shared_ptr<IGraphicsPipeline>& pipeline, IGraphicsCommandBuffer& commandBuffer, uint32_t fbWidth, uint32_t fbHeight);
+    void setupRenderState(ImDrawData* drawData, IDevice& device, std::shared_ptr<IGraphicsPipeline>& pipeline, IGraphicsCommandBuffer& commandBuffer, uint32_t fbWidth, uint32_t fbHeight);
     void renderDrawData(ImDrawData* drawData, IDevice& device, IGraphicsCommandBuffer& commandBuffer, std::shared_ptr<IGraphicsPipeline> pipeline);
 
 private:
@@ -25,6 +25,12 @@ private:
     std::shared_ptr<IBuffer> indexBuffer;
     std::shared_ptr<IBuffer> uniformBuffer;
 
+    // persistently mapped ring buffers, used instead of the buffers above when the device supports them
+    bool useRingBuffers = false;
+    std::shared_ptr<IBuffer> vertexRingBuffer;
+    std::shared_ptr<IBuffer> indexRingBuffer;
+    std::shared_ptr<IBuffer> uniformRingBuffer;
+
     std::shared_ptr<ITexture> fontTexture;
     std::shared_ptr<ISamplerState> samplerState;
 
@@ -8,6 +8,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
 
 struct BufferDesc
 {
@@ -25,15 +27,52 @@ struct BufferDesc
     const void* data = nullptr;
     uint32_t size = 0;
     ResourceStorage storage = ResourceStorage::Invalid;
+    /**
+     * @brief Places a Vertex or Index buffer in a range of a large buffer shared with other sub-allocated buffers of
+     * the same type, instead of creating a buffer object of its own. Draws from buffers sharing a heap buffer do not
+     * need to respecify their vertex attributes.
+     */
+    bool subAllocate = false;
+    /**
+     * @brief Size of one vertex in bytes of a sub-allocated vertex buffer. The buffer is placed at a multiple of it,
+     * so that draws can address its vertices through a base vertex, 0 if unknown.
+     */
+    uint32_t vertexStride = 0;
 };
 
-class IBuffer
+/**
+ * @brief A range of a ResourceStorage::Ring buffer handed out by IBuffer::allocate.
+ *
+ * data points to the mapped memory of the range, which is written directly by the CPU. Bind the buffer with offset
+ * to use the range. The range must only be used during the frame it was allocated in.
+ */
+struct BufferAllocation
+{
+    void* data = nullptr;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+// shared from this, so that deferred command buffers can retain the buffers passed to them by reference
+class IBuffer : public std::enable_shared_from_this<IBuffer>
 {
 public:
     virtual ~IBuffer() = default;
     virtual void data(const void* data, uint32_t size, uint32_t offset) const = 0;
     [[nodiscard]] virtual void* map(uint32_t size, uint32_t offset) const = 0;
     virtual void unmap() const = 0;
+    /**
+     * @brief Sub-allocates size bytes of a ResourceStorage::Ring buffer.
+     *
+     * @param alignment Alignment of the offset, 0 uses the minimum offset alignment of the buffer type (e.g.
+     * GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT for uniform buffers)
+     */
+    [[nodiscard]] virtual BufferAllocation allocate(uint32_t size, uint32_t alignment = 0) const = 0;
+    /**
+     * @brief Same as allocate, but returns nothing instead of throwing when the allocations of the current frame
+     * leave no room, for callers moving on to a larger ring.
+     */
+    [[nodiscard]] virtual std::optional<BufferAllocation> tryAllocate(uint32_t size, uint32_t alignment = 0) const = 0;
 
     [[nodiscard]] virtual size_t getSize() const = 0;
 };
\ No newline at end of file
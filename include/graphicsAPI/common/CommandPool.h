@@ -10,6 +10,9 @@
 
 struct CommandPoolDesc
 {
+    /** @brief A Deferred pool belongs to a single recording thread, which does not need a device context. Every
+     * graphics command buffer acquired from it records in deferred mode and is handed over to the device on submit. */
+    RecordingMode recordingMode = RecordingMode::Immediate;
 };
 
 class ICommandPool
@@ -22,4 +25,11 @@ public:
 
     virtual std::unique_ptr<IComputeCommandBuffer> acquireComputeCommandBuffer(const CommandBufferDesc& desc) = 0;
     virtual void submitCommandBuffer(std::unique_ptr<IComputeCommandBuffer> commandBuffer) = 0;
+
+    /** @brief Whether acquireComputeCommandBuffer can be called, backends may only record compute work in
+     * immediate pools. */
+    [[nodiscard]] virtual bool hasComputeCommandBuffers() const
+    {
+        return true;
+    }
 };
\ No newline at end of file
@@ -62,7 +62,8 @@ enum class ResourceStorage
     Private,  /// Memory private to GPU access (fastest)
     Shared,   /// Memory shared between CPU and GPU
     Managed,  /// Memory pair synchronized between CPU and GPU
-    Memoryless/// Memory can be accessed only by the GPU and only exist temporarily during a render
+    Memoryless,/// Memory can be accessed only by the GPU and only exist temporarily during a render
+    Ring      /// Memory shared between CPU and GPU, persistently mapped and sub-allocated per frame with IBuffer::allocate
 };
 
 
@@ -136,9 +137,30 @@ enum ImageAccessFlags : uint8_t
     ReadWrite = ReadOnly | WriteOnly
 };
 
+/**
+ * @brief Kinds of accesses that a memory barrier makes see the shader storage and image writes issued before it.
+ */
+enum BarrierBits : uint32_t
+{
+    Barrier_VertexBuffer = 1 << 0,
+    Barrier_IndexBuffer = 1 << 1,
+    Barrier_UniformBuffer = 1 << 2,
+    Barrier_TextureFetch = 1 << 3,
+    Barrier_ShaderImage = 1 << 4,
+    Barrier_IndirectBuffer = 1 << 5,
+    Barrier_BufferUpdate = 1 << 6,
+    Barrier_Framebuffer = 1 << 7,
+    Barrier_ShaderStorage = 1 << 8,
+    Barrier_TextureUpdate = 1 << 9,
+};
+
 constexpr size_t MAX_TEXTURE_SAMPLERS = 16;
 constexpr size_t MAX_TEXTURE_UNITS = 16;
 constexpr size_t MAX_VERTEX_BUFFERS = 32;
+// bytes of push constants, backends without native push constants expose them as a uniform block at
+// PUSH_CONSTANTS_BINDING, declared as layout(std140, binding = 31) uniform PushConstants { ... };
+constexpr size_t MAX_PUSH_CONSTANTS_SIZE = 128;
+constexpr uint32_t PUSH_CONSTANTS_BINDING = 31;
 
 // Get value of enum by stripping enum class type
 template<typename E>
@@ -152,3 +174,18 @@ inline void hash_combine(std::size_t& seed, const T& v)
     std::hash<T> hasher;
     seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
 }
+
+// hashes the entries of an unordered map independently of their iteration order, so equal maps hash the same
+template <class Map>
+inline void hash_combine_unordered(std::size_t& seed, const Map& map)
+{
+    std::size_t entries = 0;
+    for (const auto& [key, value] : map)
+    {
+        std::size_t entry = 0;
+        hash_combine(entry, key);
+        hash_combine(entry, value);
+        entries += entry;
+    }
+    hash_combine(seed, entries);
+}
@@ -33,4 +33,14 @@ public:
     virtual void bindImage(size_t index, std::shared_ptr<ITexture> texture, uint8_t accessFlags, uint32_t mipLevel = 0, uint32_t layer = 0) = 0;
     virtual void bindTexture(size_t index, std::shared_ptr<ITexture> texture) = 0;
     virtual void bindSamplerState(size_t index, std::shared_ptr<ISamplerState> samplerState) = 0;
+    /**
+     * @brief Writes size bytes of data at offset of the push constants read by the following dispatches, see
+     * IGraphicsCommandBuffer::pushConstants.
+     */
+    virtual void pushConstants(uint32_t offset, const void* data, uint32_t size) = 0;
+    /**
+     * @brief Makes the shader storage and image writes of the previous dispatches visible to the accesses in barriers
+     * (BarrierBits) of the following commands, see CommandBufferDesc::automaticMemoryBarriers.
+     */
+    virtual void memoryBarrier(uint32_t barriers) = 0;
 };
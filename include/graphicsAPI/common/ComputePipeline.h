@@ -18,6 +18,8 @@ struct ComputePipelineDesc
     std::unordered_map<size_t, std::string> imagesMap;
     std::unordered_map<size_t, std::string> texturesMap;
     std::unordered_map<size_t, std::string> buffersMap;
+
+    bool operator==(const ComputePipelineDesc& other) const = default;
 };
 
 class IComputePipeline
@@ -32,16 +34,9 @@ struct ComputePipelineDescHash
     {
         size_t hash = 0;
         hash_combine(hash, std::hash<std::shared_ptr<IPipelineShaderStages>>{}(desc.shaderStages));
-        for (const auto& [unit, image] : desc.imagesMap)
-        {
-            hash_combine(hash, unit);
-            hash_combine(hash, std::hash<std::string>{}(image));
-        }
-        for (const auto& [unit, buffer] : desc.buffersMap)
-        {
-            hash_combine(hash, unit);
-            hash_combine(hash, std::hash<std::string>{}(buffer));
-        }
+        hash_combine_unordered(hash, desc.imagesMap);
+        hash_combine_unordered(hash, desc.texturesMap);
+        hash_combine_unordered(hash, desc.buffersMap);
 
         return hash;
     }
@@ -35,6 +35,36 @@ public:
     virtual std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc) = 0;
     virtual std::shared_ptr<ITexture> createTexture(const TextureDesc& desc) = 0;
 
+    /**
+     * @brief Render targets recycled across frames, for textures and framebuffers that would otherwise be created
+     * again every frame or on every resize.
+     *
+     * acquireRenderTarget returns a texture of an equal description that is no longer used, or creates one, and
+     * acquireFramebuffer the framebuffer with the same attachments. The objects return to the pool once every copy of
+     * the returned pointers is released, and are deleted after being unused for a few frames.
+     */
+    virtual std::shared_ptr<ITexture> acquireRenderTarget(const TextureDesc& desc) = 0;
+    virtual std::shared_ptr<IFramebuffer> acquireFramebuffer(const FramebufferDesc& desc) = 0;
+
+    /**
+     * @brief Returns the bindless handle of texture sampled with samplerState (nullptr samples with the parameters of
+     * the texture), for shaders reading their textures from a uniform or storage buffer instead of bound slots.
+     *
+     * The handle stays usable while it is requested every frame it is used. Returns 0 without
+     * DeviceFeatures::TextureBindless, textures are then bound with IGraphicsCommandBuffer::bindTexture.
+     */
+    virtual uint64_t getBindlessTextureHandle(const std::shared_ptr<ITexture>& texture, const std::shared_ptr<ISamplerState>& samplerState) = 0;
+
+    /**
+     * @brief Frame boundaries, every frame must be enclosed in a beginFrame/endFrame pair.
+     *
+     * endFrame advances the frame index: ring buffer memory and pushed constants are recycled once the frame is no
+     * longer in flight, asynchronous texture uploads are issued and retired, and the render target pool and the
+     * bindless residency age their entries. Without it these keep growing until they fail.
+     */
+    virtual void beginFrame() = 0;
+    virtual void endFrame() = 0;
+
     template<typename T, typename = std::enable_if_t<std::is_base_of<IPlatformDevice, T>::value>>
     T* getPlatformDevice() noexcept {
         return const_cast<T*>(static_cast<const IDevice*>(this)->getPlatformDevice<T>());
@@ -0,0 +1,259 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "CommandPool.h"
+#include "Device.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Handle of one version of a frame graph resource. Every write returns a new version of the resource, passes
+ * reading a version run after the pass that wrote it.
+ */
+struct FrameGraphResource
+{
+    static constexpr uint32_t INVALID = ~0u;
+
+    uint32_t id = INVALID;
+
+    [[nodiscard]] bool isValid() const
+    {
+        return id != INVALID;
+    }
+};
+
+/**
+ * @brief How a pass accesses a resource, determines the memory barriers issued before the pass.
+ *
+ * Sampled : Read through a sampler, or as a texel buffer
+ * StorageRead : Image load or storage buffer read
+ * StorageWrite : Image store or storage buffer write, the accesses of later passes need a memory barrier
+ * VertexBuffer, IndexBuffer, UniformBuffer, IndirectBuffer : Buffer read by the fixed function stages
+ * Attachment : Render target of a graphics pass, set by the attachment functions of FrameGraphBuilder
+ */
+enum class FrameGraphAccess : uint8_t
+{
+    Sampled,
+    StorageRead,
+    StorageWrite,
+    VertexBuffer,
+    IndexBuffer,
+    UniformBuffer,
+    IndirectBuffer,
+    Attachment,
+};
+
+class FrameGraph;
+
+/**
+ * @brief Declares the resources a pass reads and writes, handed to the setup function of the pass.
+ */
+class FrameGraphBuilder
+{
+public:
+    FrameGraphResource read(FrameGraphResource resource, FrameGraphAccess access = FrameGraphAccess::Sampled);
+    /**
+     * @brief Returns the version of the resource written by the pass. Only the latest version of a resource can be
+     * written, the pass does not see the previous content unless it reads it as well.
+     */
+    FrameGraphResource write(FrameGraphResource resource, FrameGraphAccess access = FrameGraphAccess::StorageWrite);
+
+    /**
+     * @brief Renders into the texture at color attachment index. The attachment is cleared to clearColor if given,
+     * otherwise the previous content is loaded if there is any.
+     */
+    FrameGraphResource setColorAttachment(uint32_t index, FrameGraphResource resource, std::optional<Color> clearColor = std::nullopt);
+    FrameGraphResource setDepthAttachment(FrameGraphResource resource, std::optional<float> clearDepth = std::nullopt);
+    FrameGraphResource setStencilAttachment(FrameGraphResource resource, std::optional<uint32_t> clearStencil = std::nullopt);
+
+    void setDrawReorderMode(DrawReorderMode mode);
+    /**
+     * @brief The pass is never culled, e.g. because it writes data read back by the CPU.
+     */
+    void setSideEffect();
+
+private:
+    friend class FrameGraph;
+
+    FrameGraphBuilder(FrameGraph& graph, uint32_t pass);
+
+    FrameGraphResource setAttachment(int32_t index, FrameGraphResource resource, bool clear);
+
+private:
+    FrameGraph& graph;
+    uint32_t pass;
+};
+
+/**
+ * @brief Orders the passes of a frame by the resources they declare and allocates the resources only used inside of
+ * the frame.
+ *
+ * compile() culls the passes whose outputs are never consumed, the outputs are the imported resources and the passes
+ * with side effects. Transient textures are assigned to device textures from the lifetime intervals of the resources,
+ * so that resources with equal descriptions and disjoint lifetimes share a texture. The textures and framebuffers are
+ * acquired from IDevice::acquireRenderTarget and IDevice::acquireFramebuffer, and are recycled across frames. The load and store actions of the
+ * attachments follow from the declared reads and writes, and the minimal memory barriers are issued between passes
+ * storing into a resource and the passes accessing it afterwards. Dispatches within a compute pass are not separated
+ * by barriers, compute passes record the ones they need with IComputeCommandBuffer::memoryBarrier.
+ *
+ * Passes run in the order they are added, which is always a valid order since a pass can only use the versions of
+ * resources written before. The graph is recorded anew every frame, reset() releases the transient resources.
+ */
+class FrameGraph
+{
+public:
+    using SetupFunction = std::function<void(FrameGraphBuilder&)>;
+    using GraphicsExecuteFunction = std::function<void(IGraphicsCommandBuffer&, const FrameGraph&)>;
+    using ComputeExecuteFunction = std::function<void(IComputeCommandBuffer&, const FrameGraph&)>;
+
+    explicit FrameGraph(IDevice& device);
+
+    /**
+     * @brief Declares a texture allocated by the graph, it only exists between its first and last use.
+     */
+    FrameGraphResource createTexture(std::string name, const TextureDesc& desc);
+    FrameGraphResource importTexture(std::string name, std::shared_ptr<ITexture> texture);
+    FrameGraphResource importBuffer(std::string name, std::shared_ptr<IBuffer> buffer);
+    /**
+     * @brief The default framebuffer, passes using it as their color attachment render into it.
+     */
+    FrameGraphResource importBackbuffer(std::string name);
+
+    /**
+     * @brief Adds a pass rendering into the attachments declared by setup, execute records its draws inside of the
+     * render pass begun by the graph. Returns the index of the pass.
+     */
+    uint32_t addGraphicsPass(std::string name, const SetupFunction& setup, GraphicsExecuteFunction execute);
+    uint32_t addComputePass(std::string name, const SetupFunction& setup, ComputeExecuteFunction execute);
+
+    /**
+     * @brief Culls the unused passes, allocates the transient resources and derives the attachment actions and the
+     * memory barriers. Called by execute() if needed.
+     */
+    void compile();
+    /**
+     * @brief Records every pass that was not culled into its own command buffer acquired from commandPool.
+     *
+     * Throws before recording anything if a compute pass remains and commandPool has no compute command buffers, as
+     * the deferred pools of the OpenGL backend.
+     */
+    void execute(ICommandPool& commandPool, const CommandBufferDesc& desc = {});
+    /**
+     * @brief Removes every pass and resource, the transient textures return to the render target pool.
+     */
+    void reset();
+
+    /**
+     * @brief Resources of the executing pass, only valid during execute().
+     */
+    [[nodiscard]] std::shared_ptr<ITexture> getTexture(FrameGraphResource resource) const;
+    [[nodiscard]] std::shared_ptr<IBuffer> getBuffer(FrameGraphResource resource) const;
+
+    [[nodiscard]] bool isPassCulled(uint32_t pass) const;
+    /**
+     * @brief Barrier bits issued before the pass by execute(), derived by the last compile().
+     */
+    [[nodiscard]] uint32_t getPassBarriers(uint32_t pass) const;
+    /**
+     * @brief Number of textures acquired for the transient resources by the last compile().
+     */
+    [[nodiscard]] size_t getTransientTextureCount() const;
+
+private:
+    friend class FrameGraphBuilder;
+
+    static constexpr uint32_t INVALID_INDEX = ~0u;
+
+    struct ResourceEntry
+    {
+        std::string name;
+        bool imported = false;
+        bool backbuffer = false;
+        TextureDesc textureDesc;
+        std::shared_ptr<ITexture> texture;
+        std::shared_ptr<IBuffer> buffer;
+        // latest version, only that one can be written
+        uint32_t latestNode = INVALID_INDEX;
+        // passes of the first and last access, transient textures are allocated for that interval
+        uint32_t firstPass = INVALID_INDEX;
+        uint32_t lastPass = INVALID_INDEX;
+        // barrier tracking, see compile()
+        bool pendingStore = false;
+        uint32_t visibleBarriers = 0;
+    };
+
+    struct ResourceNode
+    {
+        uint32_t entry;
+        uint32_t producer;
+        uint32_t readCount;
+    };
+
+    struct ResourceAccess
+    {
+        uint32_t node;
+        FrameGraphAccess access;
+    };
+
+    struct Attachment
+    {
+        // attachment index, -1 for depth and -2 for stencil
+        int32_t index;
+        uint32_t node;
+        bool clear;
+        bool load;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        bool compute = false;
+        bool sideEffect = false;
+        DrawReorderMode drawReorderMode = DrawReorderMode::None;
+        std::vector<ResourceAccess> reads;
+        std::vector<ResourceAccess> writes;
+        std::vector<Attachment> attachments;
+        RenderPassDesc renderPass;
+        GraphicsExecuteFunction executeGraphics;
+        ComputeExecuteFunction executeCompute;
+
+        // results of compile()
+        uint32_t refCount = 0;
+        bool culled = false;
+        uint32_t barriers = 0;
+        std::shared_ptr<IFramebuffer> framebuffer;
+    };
+
+    struct TransientTexture
+    {
+        std::shared_ptr<ITexture> texture;
+        TextureDesc desc;
+        uint32_t lastPass;
+    };
+
+    FrameGraphResource addResource(ResourceEntry entry);
+    FrameGraphResource addNode(uint32_t entry, uint32_t producer);
+    uint32_t addPass(std::string name, bool compute, const SetupFunction& setup);
+    [[nodiscard]] const ResourceEntry& getEntry(FrameGraphResource resource) const;
+
+    void cullPasses();
+    void allocateTransientTextures();
+    void createRenderPasses();
+    void computeBarriers();
+
+private:
+    IDevice& device;
+    std::vector<ResourceEntry> entries;
+    std::vector<ResourceNode> nodes;
+    std::vector<Pass> passes;
+    std::vector<TransientTexture> transientTextures;
+    bool compiled = false;
+};
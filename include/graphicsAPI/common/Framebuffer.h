@@ -16,6 +16,8 @@ struct FramebufferAttachmentDesc
 {
     std::shared_ptr<ITexture> texture;
     std::shared_ptr<ITexture> resolveTexture;
+
+    bool operator==(const FramebufferAttachmentDesc& other) const = default;
 };
 
 /**
@@ -29,6 +31,9 @@ struct FramebufferDesc {
     FramebufferAttachmentDesc depthAttachment;
     /** @brief The stencil texture attachment */
     FramebufferAttachmentDesc stencilAttachment;
+
+    /** @brief Equal if the same textures are attached to the same attachments */
+    bool operator==(const FramebufferDesc& other) const = default;
 };
 
 class IFramebuffer
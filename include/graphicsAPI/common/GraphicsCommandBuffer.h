@@ -12,16 +12,93 @@
 #include "RenderPass.h"
 #include "SamplerState.h"
 
+/**
+ * @brief RecordingMode determines when the commands of a command buffer reach the device.
+ *
+ * Immediate : Commands are executed as they are recorded, a device context must be current on the recording thread.
+ * Deferred : Commands are encoded and executed when the command buffer is submitted. Recording does not require a
+ * device context. The resources of the commands are kept alive until the command buffer is executed, buffers passed by
+ * reference (e.g. index buffers) only if they are owned by a shared_ptr, otherwise they must stay alive until then.
+ */
+enum class RecordingMode : uint8_t
+{
+    Immediate,
+    Deferred,
+};
+
 struct CommandBufferDesc
 {
+    RecordingMode recordingMode = RecordingMode::Immediate;
+    /** @brief Deferred command buffers submitted from different threads execute in increasing submissionOrder,
+     * command buffers with the same submissionOrder execute in the order they were submitted */
+    uint32_t submissionOrder = 0;
+    /** @brief Compute command buffers issue a memory barrier covering every kind of access after each dispatch.
+     * Disable it when the barriers are recorded explicitly with memoryBarrier, e.g. by a FrameGraph */
+    bool automaticMemoryBarriers = true;
+};
+
+/**
+ * @brief DrawReorderMode determines how the draws recorded inside a render pass may be reordered before execution.
+ * Reordering only applies to command buffers recorded in RecordingMode::Deferred.
+ *
+ * None : Draws execute in recording order.
+ * MinimizeStateChanges : Draws are grouped by pipeline, depth stencil state, textures and vertex buffers.
+ * FrontToBack : Draws are ordered by their DrawSortHint depth first, then by state.
+ */
+enum class DrawReorderMode : uint8_t
+{
+    None,
+    MinimizeStateChanges,
+    FrontToBack,
 };
 
 struct RenderPassBeginDesc
 {
     RenderPassDesc renderPass;
     std::shared_ptr<IFramebuffer> framebuffer;
+    DrawReorderMode drawReorderMode = DrawReorderMode::None;
+    /**
+     * @brief Region of the framebuffer the pass renders to, null for the whole framebuffer. Draws are not clipped to
+     * it, it restricts the clears and lets the discarded content outside of it be kept.
+     */
+    ScissorRect renderArea;
 };
 
+/**
+ * @brief Per draw hints used when the draws of a render pass are reordered.
+ */
+struct DrawSortHint
+{
+    /** @brief Normalized view depth of the draw, 0 is the nearest */
+    float depth = 0.0f;
+    /** @brief Order dependent draws keep their position relative to every other draw of the render pass.
+     * Draws using a pipeline with blending enabled are never reordered. */
+    bool reorderable = true;
+};
+
+
+/**
+ * @brief Layout of the draws read by IGraphicsCommandBuffer::drawIndirect from an Indirect buffer.
+ */
+struct DrawIndirectArgs
+{
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t baseInstance;
+};
+
+/**
+ * @brief Layout of the draws read by IGraphicsCommandBuffer::drawIndexedIndirect from an Indirect buffer.
+ */
+struct DrawIndexedIndirectArgs
+{
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
 
 enum BindTarget : uint8_t
 {
@@ -39,15 +116,72 @@ public:
     virtual void bindGraphicsPipeline(std::shared_ptr<IGraphicsPipeline> pipeline) = 0;
     virtual void bindBuffer(uint32_t index, std::shared_ptr<IBuffer> buffer, uint32_t offset) = 0;
     virtual void draw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount) = 0;
+    /**
+     * @brief Draws indexCount indices read from indexBuffer at indexBufferOffset, baseVertex is added to every index
+     * before fetching vertices, so that several meshes can share a vertex buffer and its attribute setup.
+     */
     virtual void drawIndexed(PrimitiveType primitiveType,
                      size_t indexCount,
                      IndexFormat indexFormat,
                      IBuffer& indexBuffer,
-                     size_t indexBufferOffset) = 0;
+                     size_t indexBufferOffset,
+                     int32_t baseVertex = 0) = 0;
+    /** @brief Draws instanceCount instances, per-instance vertex inputs start at element baseInstance */
+    virtual void drawInstanced(PrimitiveType primitiveType,
+                               size_t vertexStart,
+                               size_t vertexCount,
+                               size_t instanceCount,
+                               size_t baseInstance) = 0;
+    virtual void drawIndexedInstanced(PrimitiveType primitiveType,
+                                      size_t indexCount,
+                                      IndexFormat indexFormat,
+                                      IBuffer& indexBuffer,
+                                      size_t indexBufferOffset,
+                                      int32_t baseVertex,
+                                      size_t instanceCount,
+                                      size_t baseInstance) = 0;
+    /**
+     * @brief Executes drawCount draws whose DrawIndirectArgs are read from indirectBuffer, starting at
+     * indirectBufferOffset and stride bytes apart (0 for tightly packed). Requires DeviceFeatures::DrawIndexedIndirect.
+     */
+    virtual void drawIndirect(PrimitiveType primitiveType,
+                              IBuffer& indirectBuffer,
+                              size_t indirectBufferOffset,
+                              uint32_t drawCount,
+                              uint32_t stride) = 0;
+    /**
+     * @brief Indexed variant of drawIndirect reading DrawIndexedIndirectArgs, firstIndex is counted from the start of
+     * indexBuffer, which must not be sub-allocated.
+     */
+    virtual void drawIndexedIndirect(PrimitiveType primitiveType,
+                                     IndexFormat indexFormat,
+                                     IBuffer& indexBuffer,
+                                     IBuffer& indirectBuffer,
+                                     size_t indirectBufferOffset,
+                                     uint32_t drawCount,
+                                     uint32_t stride) = 0;
     virtual void bindViewport(const Viewport& viewport) = 0;
     virtual void bindScissor(const ScissorRect& scissor) = 0;
     virtual void bindDepthStencilState(const std::shared_ptr<IDepthStencilState>& depthStencilState) = 0;
     virtual void bindTexture(uint32_t index, uint8_t target, std::shared_ptr<ITexture> texture) = 0;
     virtual void bindSamplerState(uint32_t index, uint8_t target, std::shared_ptr<ISamplerState> samplerState) = 0;
+    /**
+     * @brief Writes size bytes of data at offset of the push constants read by the following draws, the other bytes
+     * keep their value. Offset and size must stay within MAX_PUSH_CONSTANTS_SIZE. Requires DeviceFeatures::PushConstants.
+     *
+     * Only the bytes written since begin() are streamed to the GPU, every byte of the block a shader declares must be
+     * written before a draw reads it, as with the push constant ranges of Vulkan.
+     *
+     * @param target BindTarget bits of the stages reading the data, the block is shared by all stages on backends
+     * emulating push constants
+     */
+    virtual void pushConstants(uint8_t target, uint32_t offset, const void* data, uint32_t size) = 0;
+    /**
+     * @brief Makes the shader storage and image writes of the previous commands visible to the accesses in barriers
+     * (BarrierBits) of the following ones. Must be recorded outside of render passes.
+     */
+    virtual void memoryBarrier(uint32_t barriers) = 0;
+    /** @brief Sets the sort hint used by the following draws, reset at the beginning of every render pass */
+    virtual void setDrawSortHint(const DrawSortHint& hint) = 0;
 
 };
@@ -78,6 +78,8 @@ struct ColorBlendAttachmentStateDesc
     BlendFactor dstAlphaBlendFactor = BlendFactor::Zero;
     BlendOp alphaBlendOp = BlendOp::Add;
     ColorWriteMask colorWriteMask = ColorWriteMask::All;
+
+    bool operator==(const ColorBlendAttachmentStateDesc& other) const = default;
 };
 
 struct RasterizationStateDesc
@@ -85,6 +87,8 @@ struct RasterizationStateDesc
     CullMode cullMode = CullMode::None;
     FrontFace frontFace = FrontFace::CounterClockwise;
     PolygonFillMode polygonFillMode = PolygonFillMode::Fill;
+
+    bool operator==(const RasterizationStateDesc& other) const = default;
 };
 
 struct GraphicsPipelineDesc
@@ -102,6 +106,8 @@ struct GraphicsPipelineDesc
    */
     std::unordered_map<size_t, std::string> vertexUnitSamplerMap;
     std::unordered_map<size_t, std::string> fragmentUnitSamplerMap;
+
+    bool operator==(const GraphicsPipelineDesc& other) const = default;
 };
 
 struct ColorBlendAttachmentStateDescHash
@@ -145,16 +151,8 @@ struct GraphicsPipelineDescHash
             hash_combine(hash, ColorBlendAttachmentStateDescHash{}(colorBlendAttachmentState));
         }
         hash_combine(hash, RasterizationStateDescHash{}(desc.rasterizationState));
-        for (const auto& [unit, sampler] : desc.vertexUnitSamplerMap)
-        {
-            hash_combine(hash, unit);
-            hash_combine(hash, sampler);
-        }
-        for (const auto& [unit, sampler] : desc.fragmentUnitSamplerMap)
-        {
-            hash_combine(hash, unit);
-            hash_combine(hash, sampler);
-        }
+        hash_combine_unordered(hash, desc.vertexUnitSamplerMap);
+        hash_combine_unordered(hash, desc.fragmentUnitSamplerMap);
 //
 //        // print all individual hashes
 //        std::cout << "hash: " << hash << std::endl;
@@ -186,4 +184,14 @@ public:
     virtual ~IGraphicsPipeline() = default;
 
     [[nodiscard]] virtual const GraphicsPipelineDesc& getDesc() const = 0;
+
+    /**
+     * @brief Whether the shader stages of the pipeline are linked and the pipeline can draw, never blocks.
+     *
+     * Command buffers skip the draws of a pipeline that is not ready yet.
+     */
+    [[nodiscard]] virtual bool isReady()
+    {
+        return true;
+    }
 };
\ No newline at end of file
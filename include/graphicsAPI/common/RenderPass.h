@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include "Common.h"
+
+#include <cstdint>
 #include <vector>
 
 /**
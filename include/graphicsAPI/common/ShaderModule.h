@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 enum class ShaderModuleType
 {
@@ -19,6 +20,10 @@ struct ShaderModuleDesc
     ShaderModuleType type;
     std::string code;
     std::string entryPoint;
+    // preprocessor definitions ("NAME" or "NAME VALUE") inserted after the #version directive
+    std::vector<std::string> defines;
+    // returns without waiting for the compiler, the module stays pending until isReady() reports it compiled
+    bool compileAsync = false;
 };
 
 class IShaderModule
@@ -29,6 +34,17 @@ public:
 
     [[nodiscard]] ShaderModuleType getType() const;
 
+    /**
+     * @brief Whether the module finished compiling successfully, never blocks.
+     *
+     * Only modules created with ShaderModuleDesc::compileAsync can be pending, a failed compilation stays not ready.
+     * Backends with a program binary cache may defer the compilation until a program links the module, this starts it.
+     */
+    [[nodiscard]] virtual bool isReady()
+    {
+        return true;
+    }
+
 protected:
     ShaderModuleDesc desc;
 };
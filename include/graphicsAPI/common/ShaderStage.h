@@ -25,6 +25,8 @@ struct PipelineShaderStagesDesc
     std::shared_ptr<IShaderModule> computeModule;
 
     ShaderStagesType type = ShaderStagesType::Graphics;
+    // returns without waiting for the linker, the stages stay pending until isReady() reports them linked
+    bool linkAsync = false;
 };
 
 class IPipelineShaderStages
@@ -38,4 +40,14 @@ public:
     [[nodiscard]] virtual const std::shared_ptr<IShaderModule>& getComputeShader() const = 0;
 
     [[nodiscard]] virtual ShaderStagesType getType() const = 0;
+
+    /**
+     * @brief Whether the program finished linking successfully, never blocks.
+     *
+     * Only stages created with PipelineShaderStagesDesc::linkAsync can be pending, a failed link stays not ready.
+     */
+    [[nodiscard]] virtual bool isReady()
+    {
+        return true;
+    }
 };
@@ -8,6 +8,8 @@
 #include "TextureStructures.h"
 
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 
 enum class TextureType : uint8_t {
@@ -133,6 +135,19 @@ public:
 
     virtual void upload(const void* data, const TextureRangeDesc& range, size_t bytesPerRow = 0) const = 0;
     virtual void uploadCube(const void* data, TextureCubeFace face, const TextureRangeDesc& range, size_t bytesPerRow) const = 0;
+    /**
+     * @brief Uploads without waiting for the driver, may be called from any thread.
+     *
+     * The data is copied into staging memory before the call returns. The OpenGL backend issues the upload from a
+     * pixel buffer at the next Context::endFrame and completes it once the GPU is done with it.
+     *
+     * @param onComplete Called on the device thread once the texture can be sampled with the new data
+     * @return A future that becomes ready once the texture can be sampled with the new data
+     */
+    virtual std::future<void> uploadAsync(const void* data,
+                                          const TextureRangeDesc& range,
+                                          size_t bytesPerRow = 0,
+                                          std::function<void()> onComplete = nullptr) const = 0;
 
     [[nodiscard]] virtual float getAspectRatio() const = 0;
     [[nodiscard]] virtual size_t getWidth() const = 0;
@@ -68,11 +68,11 @@ enum class VertexAttributeFormat
 
 uint32_t getVertexAttributeFormatSize(VertexAttributeFormat format);
 
-//enum class VertexInputRate
-//{
-//    VERTEX,
-//    INSTANCE,
-//};
+enum class VertexInputRate
+{
+    VERTEX,
+    INSTANCE,
+};
 
 //struct VertexInputBindingDesc
 //{
@@ -103,7 +103,7 @@ struct VertexInputBindingDesc
 {
     uint32_t binding = 0; // buffer index
     uint32_t stride = 0; // size of each vertex in bytes
-    //VertexInputRate inputRate = VertexInputRate::VERTEX; // per vertex or per instance
+    VertexInputRate inputRate = VertexInputRate::VERTEX; // per vertex or per instance
 };
 
 struct VertexInputAttributeDesc
@@ -127,7 +127,7 @@ class VertexInputStateDescBuilder
 {
 public:
     VertexInputStateDescBuilder() = default;
-    VertexInputStateDescBuilder& beginBinding(uint32_t binding);
+    VertexInputStateDescBuilder& beginBinding(uint32_t binding, VertexInputRate inputRate = VertexInputRate::VERTEX);
     VertexInputStateDescBuilder& addVertexAttribute(VertexAttributeFormat format, const std::string& name, uint32_t location = 0);
     VertexInputStateDescBuilder& endBinding();
     [[nodiscard]] VertexInputStateDesc build() const;
@@ -0,0 +1,229 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/ComputeCommandBuffer.h"
+#include "graphicsAPI/common/GraphicsCommandBuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace null {
+
+/**
+ * @brief Commands recorded by the null backend. Resources are referenced by address, for identity only.
+ */
+namespace command {
+
+struct BeginRenderPass
+{
+    RenderPassDesc renderPass;
+    const IFramebuffer* framebuffer;
+    DrawReorderMode drawReorderMode;
+    ScissorRect renderArea;
+};
+
+struct EndRenderPass
+{
+};
+
+struct BindGraphicsPipeline
+{
+    const IGraphicsPipeline* pipeline;
+};
+
+struct BindBuffer
+{
+    uint32_t index;
+    const IBuffer* buffer;
+    uint32_t offset;
+};
+
+struct Draw
+{
+    PrimitiveType primitiveType;
+    size_t vertexStart;
+    size_t vertexCount;
+    size_t instanceCount = 1;
+    size_t baseInstance = 0;
+};
+
+struct DrawIndexed
+{
+    PrimitiveType primitiveType;
+    size_t indexCount;
+    IndexFormat indexFormat;
+    const IBuffer* indexBuffer;
+    size_t indexBufferOffset;
+    int32_t baseVertex = 0;
+    size_t instanceCount = 1;
+    size_t baseInstance = 0;
+};
+
+struct DrawIndirect
+{
+    PrimitiveType primitiveType;
+    const IBuffer* indirectBuffer;
+    size_t indirectBufferOffset;
+    uint32_t drawCount;
+    uint32_t stride;
+};
+
+struct DrawIndexedIndirect
+{
+    PrimitiveType primitiveType;
+    IndexFormat indexFormat;
+    const IBuffer* indexBuffer;
+    const IBuffer* indirectBuffer;
+    size_t indirectBufferOffset;
+    uint32_t drawCount;
+    uint32_t stride;
+};
+
+struct BindViewport
+{
+    Viewport viewport;
+};
+
+struct BindScissor
+{
+    ScissorRect scissor;
+};
+
+struct BindDepthStencilState
+{
+    const IDepthStencilState* depthStencilState;
+};
+
+struct BindTexture
+{
+    uint32_t index;
+    uint8_t target;
+    const ITexture* texture;
+};
+
+struct BindSamplerState
+{
+    uint32_t index;
+    uint8_t target;
+    const ISamplerState* samplerState;
+};
+
+struct PushConstants
+{
+    uint8_t target;
+    uint32_t offset;
+    std::vector<std::byte> data;
+};
+
+struct Barrier
+{
+    uint32_t barriers;
+};
+
+struct SetDrawSortHint
+{
+    DrawSortHint hint;
+};
+
+struct BeginCompute
+{
+};
+
+struct EndCompute
+{
+};
+
+struct BindComputePipeline
+{
+    const IComputePipeline* pipeline;
+};
+
+struct Dispatch
+{
+    ThreadGroupDimensions dimensions;
+};
+
+struct BindComputeBuffer
+{
+    size_t index;
+    const IBuffer* buffer;
+    size_t offset;
+};
+
+struct BindImage
+{
+    size_t index;
+    const ITexture* texture;
+    uint8_t accessFlags;
+    uint32_t mipLevel;
+    uint32_t layer;
+};
+
+struct BindComputeTexture
+{
+    size_t index;
+    const ITexture* texture;
+};
+
+struct BindComputeSamplerState
+{
+    size_t index;
+    const ISamplerState* samplerState;
+};
+
+struct ComputePushConstants
+{
+    uint32_t offset;
+    std::vector<std::byte> data;
+};
+
+struct ComputeBarrier
+{
+    uint32_t barriers;
+};
+
+}// namespace command
+
+using Command = std::variant<
+        command::BeginRenderPass,
+        command::EndRenderPass,
+        command::BindGraphicsPipeline,
+        command::BindBuffer,
+        command::Draw,
+        command::DrawIndexed,
+        command::DrawIndirect,
+        command::DrawIndexedIndirect,
+        command::BindViewport,
+        command::BindScissor,
+        command::BindDepthStencilState,
+        command::BindTexture,
+        command::BindSamplerState,
+        command::PushConstants,
+        command::Barrier,
+        command::SetDrawSortHint,
+        command::BeginCompute,
+        command::EndCompute,
+        command::BindComputePipeline,
+        command::Dispatch,
+        command::BindComputeBuffer,
+        command::BindImage,
+        command::BindComputeTexture,
+        command::BindComputeSamplerState,
+        command::ComputePushConstants,
+        command::ComputeBarrier>;
+
+struct CommandLogEntry
+{
+    /** @brief Index of the submission that contained the command, in submission order */
+    uint32_t submission;
+    Command command;
+};
+
+using CommandLog = std::vector<CommandLogEntry>;
+
+}// namespace null
@@ -0,0 +1,86 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "CommandLog.h"
+#include "graphicsAPI/common/Device.h"
+
+#include <memory>
+#include <mutex>
+
+namespace null {
+
+class CommandPool;
+
+/**
+ * @brief Device that never touches a GPU.
+ *
+ * Buffers and textures live in CPU memory and every command of a submitted command buffer is appended to an
+ * inspectable command log. Useful to measure the CPU overhead of the abstraction, or to test renderers without a
+ * display.
+ */
+class Device : public IDevice
+{
+public:
+    explicit Device(bool commandLogEnabled = true);
+
+    std::shared_ptr<ICommandPool> createCommandPool(const CommandPoolDesc& desc) override;
+    std::unique_ptr<IBuffer> createBuffer(const BufferDesc& desc) override;
+    std::shared_ptr<IShaderModule> createShaderModule(const ShaderModuleDesc& desc) override;
+    std::shared_ptr<IPipelineShaderStages> createPipelineShaderStages(const PipelineShaderStagesDesc& desc) override;
+    std::shared_ptr<IGraphicsPipeline> createGraphicsPipeline(const GraphicsPipelineDesc& desc) override;
+    std::shared_ptr<IComputePipeline> createComputePipeline(const ComputePipelineDesc& desc) override;
+    std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc) override;
+    std::shared_ptr<ITexture> createTexture(const TextureDesc& desc) override;
+    /** @brief Not pooled, creates a new texture every time */
+    std::shared_ptr<ITexture> acquireRenderTarget(const TextureDesc& desc) override;
+    /** @brief Not pooled, creates a new framebuffer every time */
+    std::shared_ptr<IFramebuffer> acquireFramebuffer(const FramebufferDesc& desc) override;
+    std::shared_ptr<IVertexInputState> createVertexInputState(const VertexInputStateDesc& desc) override;
+    std::shared_ptr<IDepthStencilState> createDepthStencilState(const DepthStencilStateDesc& desc) override;
+    std::shared_ptr<ISamplerState> createSamplerState(const SamplerStateDesc& desc) override;
+    /** @brief Always 0, DeviceFeatures::TextureBindless is not reported */
+    uint64_t getBindlessTextureHandle(const std::shared_ptr<ITexture>& texture, const std::shared_ptr<ISamplerState>& samplerState) override;
+    void beginFrame() override;
+    void endFrame() override;
+
+    [[nodiscard]] ShaderVersion getShaderVersion() const override
+    {
+        return {
+            .family = ShaderFamily::GLSL,
+            .major = 4,
+            .minor = 6
+        };
+    }
+
+    [[nodiscard]] bool hasFeature(DeviceFeatures feature) const override;
+    [[nodiscard]] TextureFormatCapabilities getTextureFormatCapabilities(TextureFormat format) const override;
+
+    /**
+     * @brief Commands of every command buffer submitted since the last clearCommandLog(), in submission order.
+     */
+    [[nodiscard]] const CommandLog& getCommandLog() const
+    {
+        return commandLog;
+    }
+    void clearCommandLog();
+
+    [[nodiscard]] bool isCommandLogEnabled() const
+    {
+        return commandLogEnabled;
+    }
+
+    // called by the command pools on submit
+    void appendToCommandLog(std::vector<Command>& commands);
+
+private:
+    bool commandLogEnabled;
+
+    std::mutex commandLogMutex;
+    CommandLog commandLog;
+    uint32_t submissionCount = 0;
+};
+
+}// namespace null
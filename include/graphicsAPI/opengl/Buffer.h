@@ -7,7 +7,12 @@
 #include "Context.h"
 #include "graphicsAPI/common/Buffer.h"
 
+#include <memory>
+#include <optional>
+
 namespace opengl {
+class ArrayBuffer;
+
 class Buffer : public IBuffer, public WithContext
 {
 public:
@@ -16,7 +21,8 @@ public:
         Attribute,
         Index,
         Uniform,
-        Storage
+        Storage,
+        Indirect
     };
 
     explicit Buffer(Context& context) : WithContext(context){};
@@ -24,6 +30,12 @@ public:
     [[nodiscard]] virtual Type getType() const noexcept = 0;
 
     virtual void initialize(const BufferDesc& desc) = 0;
+
+    /** @brief GL buffer object holding the data, shared by all the buffers sub-allocated from the same heap page */
+    [[nodiscard]] virtual const ArrayBuffer& getStorageBuffer() const noexcept = 0;
+    /** @brief Byte offset of the data inside of the storage buffer */
+    [[nodiscard]] virtual uint32_t getStorageOffset() const noexcept = 0;
+    [[nodiscard]] virtual bool isSubAllocated() const noexcept = 0;
 };
 
 class ArrayBuffer : public Buffer
@@ -42,9 +54,17 @@ public:
     void data(const void* data, uint32_t size, uint32_t offset) const override;
     void* map(uint32_t size, uint32_t offset) const override;
     void unmap() const override;
+    [[nodiscard]] BufferAllocation allocate(uint32_t size, uint32_t alignment = 0) const override;
+    [[nodiscard]] std::optional<BufferAllocation> tryAllocate(uint32_t size, uint32_t alignment = 0) const override;
 
     [[nodiscard]] size_t getSize() const override;
 
+    [[nodiscard]] bool isRing() const noexcept { return ring_ != nullptr; }
+
+    [[nodiscard]] const ArrayBuffer& getStorageBuffer() const noexcept override { return *this; }
+    [[nodiscard]] uint32_t getStorageOffset() const noexcept override { return 0; }
+    [[nodiscard]] bool isSubAllocated() const noexcept override { return false; }
+
     [[nodiscard]] GLuint getId() const noexcept { return id_; }
     [[nodiscard]] Type getType() const noexcept override { return type_; }
     [[nodiscard]] GLenum getTarget() const noexcept { return target_; }
@@ -53,7 +73,12 @@ private:
     void savePreviousBuffer() const;
     void restorePreviousBuffer() const;
 
+    void initializeRing(const BufferDesc& desc);
+
 private:
+    // state of a ResourceStorage::Ring buffer, see Buffer.cpp
+    struct Ring;
+
     GLuint id_;
     GLenum target_;
     Type type_;
@@ -61,6 +86,8 @@ private:
     uint32_t size_;
 
     mutable GLint lastBoundBuffer_ = 0;
+
+    std::unique_ptr<Ring> ring_;
 };
 
 }// namespace opengl
@@ -5,21 +5,115 @@
 #pragma once
 
 #include "GL/glew.h"
+#include "ContextStats.h"
 #include "graphicsAPI/common/GraphicsCommandBuffer.h"
 #include "graphicsAPI/common/ComputeCommandBuffer.h"
 
+#include <array>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 
 namespace opengl {
 
+class TextureUploadQueue;
+class PushConstantStream;
+
 class Context
 {
 public:
-    Context() = default;
-    ~Context() = default;
+    Context();
+    ~Context();
     void init();
 
+    /**
+     * @brief Forgets everything the state cache knows about the GL context.
+     *
+     * Must be called after foreign code (e.g. a third party renderer or windowing backend) issued GL calls
+     * behind the back of this context, so that the next call to each wrapper reaches the driver again.
+     */
+    void invalidateStateCache();
+
+    /**
+     * @brief Starts a new accounting frame, the counters of the current frame are reset.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Ends the current accounting frame and publishes its counters through getFrameStats().
+     *
+     * Also issues the texture uploads queued with ITexture::uploadAsync and completes the finished ones.
+     */
+    void endFrame();
+
+    /**
+     * @brief Returns the call statistics of the last frame closed with endFrame().
+     */
+    [[nodiscard]] const ContextStats& getFrameStats() const
+    {
+        return lastFrameStats;
+    }
+
+    /**
+     * @brief Number of frames closed with endFrame(), also the index of the frame being recorded and of its stats.
+     * Ring buffers recycle their memory per frame. IDevice::endFrame() forwards here.
+     */
+    [[nodiscard]] uint64_t getFrameIndex() const
+    {
+        return frameIndex;
+    }
+
+    /**
+     * @brief Whether the library was built with GRAPHICSAPI_CONTEXT_STATS and actually collects statistics.
+     */
+    [[nodiscard]] static bool isStatsEnabled();
+
+    /**
+     * @brief Whether KHR/ARB_parallel_shader_compile is available, i.e. compile and link completion can be polled.
+     */
+    [[nodiscard]] bool hasParallelShaderCompile() const
+    {
+        return parallelShaderCompile;
+    }
+
+    /**
+     * @brief Whether GL 4.3 or ARB_vertex_attrib_binding is available, i.e. attribute formats and vertex buffer bindings
+     * can be specified separately.
+     */
+    [[nodiscard]] bool hasVertexAttribBinding() const
+    {
+        return vertexAttribBinding_;
+    }
+
+    /**
+     * @brief Whether GL 4.4 or ARB_multi_bind is available, bindTextures and bindSamplers then bind a whole range of
+     * units with a single call instead of one per unit.
+     */
+    [[nodiscard]] bool hasMultiBind() const
+    {
+        return multiBind_;
+    }
+
+    /**
+     * @brief Whether ARB_bindless_texture is available, i.e. textures can be read through 64-bit handles instead of
+     * texture units.
+     */
+    [[nodiscard]] bool hasBindlessTexture() const
+    {
+        return bindlessTexture_;
+    }
+
+    [[nodiscard]] TextureUploadQueue& getTextureUploadQueue()
+    {
+        return *textureUploadQueue;
+    }
+
+    [[nodiscard]] PushConstantStream& getPushConstantStream()
+    {
+        return *pushConstantStream;
+    }
+
     auto& getGraphicsCommandBufferPool() {
         return graphicsCommandBuffers;
     }
@@ -41,6 +135,10 @@ public: // OpenGL functions
     void stencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
     void stencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
     void clear(GLbitfield mask);
+    void clearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat* value);
+    void clearBufferiv(GLenum buffer, GLint drawbuffer, const GLint* value);
+    void clearBufferuiv(GLenum buffer, GLint drawbuffer, const GLuint* value);
+    void clearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil);
     void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
     void blendFunc(GLenum sfactor, GLenum dfactor);
     void frontFace(GLenum mode);
@@ -49,11 +147,22 @@ public: // OpenGL functions
     void depthMask(GLboolean flag);
     void drawArrays(GLenum mode, GLint first, GLsizei count);
     void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+    void drawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex);
+    void drawArraysInstancedBaseInstance(GLenum mode, GLint first, GLsizei count, GLsizei instancecount, GLuint baseinstance);
+    void drawElementsInstancedBaseVertexBaseInstance(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance);
+    void multiDrawArraysIndirect(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride);
+    void multiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
     void useProgram(GLuint program);
     void bindVertexArray(GLuint array);
     void bindBuffer(GLenum target, GLuint buffer);
     void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    // binds buffers[i] to the binding point first + i, unlike bindBufferRange the generic binding point is left alone
+    void bindBuffersRange(GLenum target, GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizeiptr* sizes);
     void bindTexture(GLenum target, GLuint texture);
+    void bindSampler(GLuint unit, GLuint sampler);
+    // binds textures[i] to its target targets[i] on unit first + i, 0 unbinds the unit
+    void bindTextures(GLuint first, GLsizei count, const GLuint* textures, const GLenum* targets);
+    void bindSamplers(GLuint first, GLsizei count, const GLuint* samplers);
     void activeTexture(GLenum texture);
     void getActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
     GLint getUniformLocation(GLuint program, const GLchar* name);
@@ -70,6 +179,7 @@ public: // OpenGL functions
     void linkProgram(GLuint program);
     void shaderSource(GLuint shader, GLsizei count, const GLchar** string, const GLint* length);
     void compileShader(GLuint shader);
+    void maxShaderCompilerThreads(GLuint count);
     void getShaderiv(GLuint shader, GLenum pname, GLint* params);
     void getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
     void getProgramiv(GLuint program, GLenum pname, GLint* params);
@@ -77,6 +187,10 @@ public: // OpenGL functions
     void getProgramResourceName(GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name);
     GLuint getProgramResourceIndex(GLuint program, GLenum programInterface, const GLchar* name);
     void getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+    void programParameteri(GLuint program, GLenum pname, GLint value);
+    void getProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+    void programBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+    const GLubyte* getString(GLenum name);
     void attachShader(GLuint program, GLuint shader);
     void detachShader(GLuint program, GLuint shader);
     GLuint createShader(GLenum type);
@@ -95,14 +209,24 @@ public: // OpenGL functions
     void vertexAttribDivisor(GLuint index, GLuint divisor);
     void vertexAttribFormat(GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset);
     void vertexAttribBinding(GLuint attribindex, GLuint bindingindex);
+    void vertexBindingDivisor(GLuint bindingindex, GLuint divisor);
+    void bindVertexBuffer(GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride);
     void genVertexArrays(GLsizei n, GLuint* arrays);
     void genBuffers(GLsizei n, GLuint* buffers);
     void genTextures(GLsizei n, GLuint* textures);
+    void genSamplers(GLsizei n, GLuint* samplers);
+    void samplerParameteri(GLuint sampler, GLenum pname, GLint param);
+    void samplerParameterf(GLuint sampler, GLenum pname, GLfloat param);
+    GLuint64 getTextureHandle(GLuint texture);
+    GLuint64 getTextureSamplerHandle(GLuint texture, GLuint sampler);
+    void makeTextureHandleResident(GLuint64 handle);
+    void makeTextureHandleNonResident(GLuint64 handle);
     void genFramebuffers(GLsizei n, GLuint* framebuffers);
     void genRenderbuffers(GLsizei n, GLuint* renderbuffers);
     void deleteVertexArrays(GLsizei n, const GLuint* arrays);
     void deleteBuffers(GLsizei n, const GLuint* buffers);
     void deleteTextures(GLsizei n, const GLuint* textures);
+    void deleteSamplers(GLsizei n, const GLuint* samplers);
     void deleteFramebuffers(GLsizei n, const GLuint* framebuffers);
     void deleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
     void bindFramebuffer(GLenum target, GLuint framebuffer);
@@ -112,6 +236,10 @@ public: // OpenGL functions
     void bufferSubData(GLenum get_target, uint32_t uint32, uint32_t size, const void* data);
     void* mapBufferRange(GLenum get_target, uint32_t uint32, uint32_t size, int i);
     void unmapBuffer(GLenum target);
+    void bufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+    GLsync fenceSync(GLenum condition, GLbitfield flags);
+    GLenum clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
+    void deleteSync(GLsync sync);
     void bindBufferBase(GLenum target, GLuint index, GLuint id);
     void framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
     void framebufferTexture2DMultisample(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples);
@@ -135,6 +263,7 @@ public: // OpenGL functions
     void generateMipmap(GLenum target);
     void bindRenderbuffer(GLenum target, GLuint renderbuffer);
     void invalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments);
+    void invalidateSubFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments, GLint x, GLint y, GLsizei width, GLsizei height);
     GLenum checkFramebufferStatus(GLenum target);
     void blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
     void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
@@ -143,15 +272,149 @@ public: // OpenGL functions
     void getProgramInterfaceiv(GLuint program, GLenum programInterface, GLenum pname, GLint* params);
     void dispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
     void memoryBarrier(GLbitfield barriers);
-    GLuint getBoundBuffer(GLenum target) { return buffers[target]; }
+    GLuint getBoundBuffer(GLenum target);
 
+private:
+    enum CapIndex : uint8_t
+    {
+        Cap_Blend,
+        Cap_CullFace,
+        Cap_DepthTest,
+        Cap_StencilTest,
+        Cap_ScissorTest,
+        Cap_FramebufferSRGB,
+        Cap_PolygonOffsetFill,
+        Cap_RasterizerDiscard,
+        Cap_PrimitiveRestartFixedIndex,
+        Cap_Multisample,
+        Cap_SampleAlphaToCoverage,
+        Cap_Dither,
+        Cap_ProgramPointSize,
+        Cap_TextureCubeMapSeamless,
+        Cap_Count
+    };
+
+    enum BufferTargetIndex : uint8_t
+    {
+        BufferTarget_Array,
+        BufferTarget_ElementArray,
+        BufferTarget_Uniform,
+        BufferTarget_ShaderStorage,
+        BufferTarget_DrawIndirect,
+        BufferTarget_DispatchIndirect,
+        BufferTarget_PixelPack,
+        BufferTarget_PixelUnpack,
+        BufferTarget_CopyRead,
+        BufferTarget_CopyWrite,
+        BufferTarget_Texture,
+        BufferTarget_Count
+    };
+
+    enum TextureTargetIndex : uint8_t
+    {
+        TextureTarget_2D,
+        TextureTarget_2DArray,
+        TextureTarget_3D,
+        TextureTarget_Cube,
+        TextureTarget_2DMultisample,
+        TextureTarget_2DMultisampleArray,
+        TextureTarget_Buffer,
+        TextureTarget_Count
+    };
+
+    static constexpr size_t MAX_INDEXED_BUFFER_BINDINGS = 32;
+
+    struct IndexedBufferBinding
+    {
+        GLuint buffer = 0;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0; // 0 means the whole buffer (glBindBufferBase)
+
+        bool operator==(const IndexedBufferBinding& other) const = default;
+    };
+
+    struct StencilFaceState
+    {
+        std::optional<std::array<GLuint, 3>> func; // func, ref, mask
+        std::optional<std::array<GLenum, 3>> op;   // sfail, dpfail, dppass
+        std::optional<GLuint> writeMask;
+    };
+
+    /**
+     * @brief Shadow copy of the GL context state.
+     *
+     * Every member is an optional, an empty optional means that the value is unknown (never set through this
+     * context, or invalidated) and the next call has to reach the driver.
+     */
+    struct StateCache
+    {
+        std::array<std::optional<bool>, Cap_Count> caps;
+
+        std::optional<GLuint> program;
+        std::optional<GLuint> vertexArray;
+        // element array buffer of the vertex arrays bound through this context, restored when one is bound again
+        std::unordered_map<GLuint, GLuint> vertexArrayElementBuffers;
+        std::optional<GLenum> activeTexture;
+        std::array<std::array<std::optional<GLuint>, TextureTarget_Count>, MAX_TEXTURE_UNITS> textures;
+        std::array<std::optional<GLuint>, MAX_TEXTURE_UNITS> samplers;
+
+        std::array<std::optional<GLuint>, BufferTarget_Count> buffers;
+        std::array<std::optional<IndexedBufferBinding>, MAX_INDEXED_BUFFER_BINDINGS> uniformBuffers;
+        std::array<std::optional<IndexedBufferBinding>, MAX_INDEXED_BUFFER_BINDINGS> storageBuffers;
+
+        std::optional<GLuint> drawFramebuffer;
+        std::optional<GLuint> readFramebuffer;
+        std::optional<GLuint> renderbuffer;
+
+        std::optional<std::array<GLboolean, 4>> colorMask;
+        std::optional<std::array<GLenum, 2>> blendEquation;
+        std::optional<std::array<GLenum, 4>> blendFunc;
+
+        std::optional<GLenum> depthFunc;
+        std::optional<GLboolean> depthMask;
+        StencilFaceState stencilFront;
+        StencilFaceState stencilBack;
+
+        std::optional<GLenum> cullFace;
+        std::optional<GLenum> frontFace;
+        std::optional<GLenum> polygonMode;
+        std::optional<std::array<GLenum, 2>> clipControl;
+
+        std::optional<std::array<GLint, 4>> viewport;
+        std::optional<std::array<GLint, 4>> scissor;
+
+        std::optional<std::array<GLfloat, 4>> clearColor;
+        std::optional<GLfloat> clearDepth;
+        std::optional<GLint> clearStencil;
+    };
+
+    static int toCapIndex(GLenum cap);
+    static int toBufferTargetIndex(GLenum target);
+    static int toTextureTargetIndex(GLenum target);
+
+    std::optional<IndexedBufferBinding>* getIndexedBufferBinding(GLenum target, GLuint index);
+    void forgetDeletedBuffer(GLuint buffer);
+    void forgetDeletedTexture(GLuint texture);
 
 private:
     bool isInit = false;
+    bool parallelShaderCompile = false;
+    bool vertexAttribBinding_ = false;
+    bool multiBind_ = false;
+    bool bindlessTexture_ = false;
+    uint64_t frameIndex = 0;
 
     std::vector<std::unique_ptr<IGraphicsCommandBuffer>> graphicsCommandBuffers;
     std::vector<std::unique_ptr<IComputeCommandBuffer>> computeCommandBuffers;
-    std::unordered_map<GLuint, GLuint> buffers;
+
+    StateCache state;
+
+    ContextStats frameStats;
+    ContextStats lastFrameStats;
+
+    // destroyed first, they release their GL objects through the state cache
+    std::unique_ptr<TextureUploadQueue> textureUploadQueue;
+    std::unique_ptr<PushConstantStream> pushConstantStream;
 };
 
 class WithContext {
@@ -0,0 +1,242 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// X MACRO listing every wrapped OpenGL entry point of opengl::Context
+#define GRAPHICSAPI_CONTEXT_CALLS(X) \
+    X(clipControl) \
+    X(enable) \
+    X(disable) \
+    X(clearColor) \
+    X(clearDepth) \
+    X(clearStencil) \
+    X(colorMask) \
+    X(stencilMask) \
+    X(stencilMaskSeparate) \
+    X(stencilFuncSeparate) \
+    X(stencilOpSeparate) \
+    X(clear) \
+    X(clearBufferfv) \
+    X(clearBufferiv) \
+    X(clearBufferuiv) \
+    X(clearBufferfi) \
+    X(viewport) \
+    X(blendFunc) \
+    X(frontFace) \
+    X(cullFace) \
+    X(depthFunc) \
+    X(depthMask) \
+    X(drawArrays) \
+    X(drawElements) \
+    X(drawElementsBaseVertex) \
+    X(drawArraysInstancedBaseInstance) \
+    X(drawElementsInstancedBaseVertexBaseInstance) \
+    X(multiDrawArraysIndirect) \
+    X(multiDrawElementsIndirect) \
+    X(useProgram) \
+    X(bindVertexArray) \
+    X(bindBuffer) \
+    X(bindBufferRange) \
+    X(bindBuffersRange) \
+    X(bindTexture) \
+    X(bindSampler) \
+    X(bindTextures) \
+    X(bindSamplers) \
+    X(activeTexture) \
+    X(getActiveUniform) \
+    X(getUniformLocation) \
+    X(uniform1i) \
+    X(uniform1f) \
+    X(uniform2f) \
+    X(uniform3f) \
+    X(uniform4f) \
+    X(uniformMatrix4fv) \
+    X(getUniformiv) \
+    X(bindImageTexture) \
+    X(deleteShader) \
+    X(deleteProgram) \
+    X(linkProgram) \
+    X(shaderSource) \
+    X(compileShader) \
+    X(maxShaderCompilerThreads) \
+    X(getShaderiv) \
+    X(getShaderInfoLog) \
+    X(getProgramiv) \
+    X(getProgramResourceiv) \
+    X(getProgramResourceName) \
+    X(getProgramResourceIndex) \
+    X(getProgramInfoLog) \
+    X(programParameteri) \
+    X(getProgramBinary) \
+    X(programBinary) \
+    X(getString) \
+    X(attachShader) \
+    X(detachShader) \
+    X(createShader) \
+    X(createProgram) \
+    X(isBuffer) \
+    X(isEnabled) \
+    X(isFramebuffer) \
+    X(isProgram) \
+    X(isRenderbuffer) \
+    X(isShader) \
+    X(isTexture) \
+    X(enableVertexAttribArray) \
+    X(disableVertexAttribArray) \
+    X(vertexAttribPointer) \
+    X(vertexAttribIPointer) \
+    X(vertexAttribDivisor) \
+    X(vertexAttribFormat) \
+    X(vertexAttribBinding) \
+    X(vertexBindingDivisor) \
+    X(bindVertexBuffer) \
+    X(genVertexArrays) \
+    X(genBuffers) \
+    X(genTextures) \
+    X(genSamplers) \
+    X(samplerParameteri) \
+    X(samplerParameterf) \
+    X(getTextureHandle) \
+    X(getTextureSamplerHandle) \
+    X(makeTextureHandleResident) \
+    X(makeTextureHandleNonResident) \
+    X(genFramebuffers) \
+    X(genRenderbuffers) \
+    X(deleteVertexArrays) \
+    X(deleteBuffers) \
+    X(deleteTextures) \
+    X(deleteSamplers) \
+    X(deleteFramebuffers) \
+    X(deleteRenderbuffers) \
+    X(bindFramebuffer) \
+    X(deleteBuffer) \
+    X(unbindBuffer) \
+    X(bufferData) \
+    X(bufferSubData) \
+    X(mapBufferRange) \
+    X(unmapBuffer) \
+    X(bufferStorage) \
+    X(fenceSync) \
+    X(clientWaitSync) \
+    X(deleteSync) \
+    X(bindBufferBase) \
+    X(framebufferTexture2D) \
+    X(framebufferTexture2DMultisample) \
+    X(framebufferRenderbuffer) \
+    X(renderbufferStorage) \
+    X(renderbufferStorageMultisample) \
+    X(drawBuffers) \
+    X(scissor) \
+    X(texParameteri) \
+    X(texImage2D) \
+    X(texImage3D) \
+    X(texSubImage2D) \
+    X(texSubImage3D) \
+    X(texStorage2D) \
+    X(texStorage3D) \
+    X(pixelStorei) \
+    X(compressedTexImage2D) \
+    X(compressedTexSubImage2D) \
+    X(compressedTexImage3D) \
+    X(compressedTexSubImage3D) \
+    X(generateMipmap) \
+    X(bindRenderbuffer) \
+    X(invalidateFramebuffer) \
+    X(invalidateSubFramebuffer) \
+    X(checkFramebufferStatus) \
+    X(blendEquationSeparate) \
+    X(blendFuncSeparate) \
+    X(polygonFillMode) \
+    X(getIntegerv) \
+    X(getProgramInterfaceiv) \
+    X(dispatchCompute) \
+    X(memoryBarrier) \
+    X(getBoundBuffer)
+
+namespace opengl {
+
+enum class ContextCall : uint8_t
+{
+#define X(name) name,
+    GRAPHICSAPI_CONTEXT_CALLS(X)
+#undef X
+    Count
+};
+
+inline const char* toString(ContextCall call)
+{
+    switch (call)
+    {
+#define X(name) case ContextCall::name: return #name;
+        GRAPHICSAPI_CONTEXT_CALLS(X)
+#undef X
+    default:
+        return "Unknown";
+    }
+}
+
+/**
+ * @brief Per-frame accounting of the calls made through opengl::Context.
+ *
+ * Only collected when the library is built with GRAPHICSAPI_CONTEXT_STATS, otherwise every counter stays zero.
+ */
+struct ContextStats
+{
+    static constexpr size_t CALL_COUNT = static_cast<size_t>(ContextCall::Count);
+
+    uint64_t frameIndex = 0;
+    /** @brief Number of calls that reached the driver, per entry point */
+    std::array<uint32_t, CALL_COUNT> calls = {};
+    /** @brief Number of calls dropped by the state cache because they would not change the GL state */
+    std::array<uint32_t, CALL_COUNT> redundantCalls = {};
+    /** @brief Bytes uploaded through bufferData and bufferSubData */
+    uint64_t bufferUploadBytes = 0;
+    /** @brief Bytes uploaded through texImage, texSubImage and their compressed variants */
+    uint64_t textureUploadBytes = 0;
+
+    [[nodiscard]] uint32_t getCallCount(ContextCall call) const
+    {
+        return calls[static_cast<size_t>(call)];
+    }
+
+    [[nodiscard]] uint32_t getRedundantCallCount(ContextCall call) const
+    {
+        return redundantCalls[static_cast<size_t>(call)];
+    }
+
+    [[nodiscard]] uint64_t getTotalCallCount() const
+    {
+        uint64_t total = 0;
+        for (auto count : calls)
+        {
+            total += count;
+        }
+        return total;
+    }
+
+    [[nodiscard]] uint64_t getTotalRedundantCallCount() const
+    {
+        uint64_t total = 0;
+        for (auto count : redundantCalls)
+        {
+            total += count;
+        }
+        return total;
+    }
+
+    /** @brief Number of draw calls submitted to the driver, an indirect call counts once whatever its draw count */
+    [[nodiscard]] uint32_t getDrawCallCount() const
+    {
+        return getCallCount(ContextCall::drawArrays) + getCallCount(ContextCall::drawElements) + getCallCount(ContextCall::drawElementsBaseVertex) +
+               getCallCount(ContextCall::drawArraysInstancedBaseInstance) + getCallCount(ContextCall::drawElementsInstancedBaseVertexBaseInstance) +
+               getCallCount(ContextCall::multiDrawArraysIndirect) + getCallCount(ContextCall::multiDrawElementsIndirect);
+    }
+};
+
+}// namespace opengl
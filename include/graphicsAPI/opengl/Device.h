@@ -6,12 +6,26 @@
 
 #include "../../../src/opengl/CommandPool.h"
 #include "Context.h"
+#include "PipelineCacheStats.h"
 #include "PlatformDevice.h"
+#include "RenderTargetPoolStats.h"
+#include "ShaderCacheStats.h"
 #include "graphicsAPI/common/Device.h"
 
+#include <filesystem>
+#include <unordered_map>
+
 namespace opengl
 {
 
+class BufferHeap;
+class RenderTargetPool;
+class SamplerState;
+class ShaderCache;
+class TextureResidency;
+template<typename Desc, typename DescHash, typename Pipeline>
+class PipelineCache;
+
 class Device : public IDevice
 {
 public:
@@ -25,9 +39,25 @@ public:
     std::shared_ptr<IComputePipeline> createComputePipeline(const ComputePipelineDesc& desc) override;
     std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc) override;
     std::shared_ptr<ITexture> createTexture(const TextureDesc& desc) override;
+    /**
+     * @brief Must be called on the GL thread, pooled objects are deleted by later calls.
+     */
+    std::shared_ptr<ITexture> acquireRenderTarget(const TextureDesc& desc) override;
+    std::shared_ptr<IFramebuffer> acquireFramebuffer(const FramebufferDesc& desc) override;
     std::shared_ptr<IVertexInputState> createVertexInputState(const VertexInputStateDesc& desc) override;
     std::shared_ptr<IDepthStencilState> createDepthStencilState(const DepthStencilStateDesc &desc) override;
+    /**
+     * @brief Returns the live sampler state of an equal description if there is one, so that identical descriptions
+     * share a single GL sampler object.
+     */
     std::shared_ptr<ISamplerState> createSamplerState(const SamplerStateDesc &desc) override;
+    /**
+     * @brief Must be called on the GL thread, the handle is made resident until it is evicted, see
+     * setBindlessResidencyBudget.
+     */
+    uint64_t getBindlessTextureHandle(const std::shared_ptr<ITexture>& texture, const std::shared_ptr<ISamplerState>& samplerState) override;
+    void beginFrame() override;
+    void endFrame() override;
 
     [[nodiscard]] ShaderVersion getShaderVersion() const override
     {
@@ -43,6 +73,49 @@ public:
 
     [[nodiscard]] Context& getContext() const;
 
+    /**
+     * @brief Replays the command buffers submitted by deferred command pools, must be called on the GL thread.
+     */
+    void executeSubmittedCommandBuffers();
+
+    /**
+     * @brief Stores linked programs as program binaries in the given directory and loads them back on later runs.
+     *
+     * Disabled by default and when passed an empty path, or if the driver does not support program binaries. While
+     * enabled, shader modules are compiled by the first program linking them from source, so the compile errors of
+     * synchronous modules are thrown by createPipelineShaderStages instead of createShaderModule.
+     */
+    void setShaderCacheDirectory(const std::filesystem::path& directory);
+
+    /**
+     * @brief Hit and miss counters of the shader module and program binary caches.
+     */
+    [[nodiscard]] const ShaderCacheStats& getShaderCacheStats() const;
+
+    /**
+     * @brief Maximum number of graphics and of compute pipelines kept by the pipeline caches, 0 disables them.
+     *
+     * createGraphicsPipeline and createComputePipeline return the cached pipeline of an equal description, the least
+     * recently used pipelines are dropped once a cache is full.
+     */
+    void setPipelineCacheCapacity(size_t capacity);
+    [[nodiscard]] const PipelineCacheStats& getGraphicsPipelineCacheStats() const;
+    [[nodiscard]] const PipelineCacheStats& getComputePipelineCacheStats() const;
+
+    /**
+     * @brief Maximum number of resident bindless handles. The least recently requested handles are made non-resident
+     * beyond it, as are the handles not requested for a while.
+     */
+    void setBindlessResidencyBudget(size_t budget);
+    [[nodiscard]] size_t getResidentTextureHandleCount() const;
+
+    /**
+     * @brief Number of frames pooled render targets and framebuffers are kept while unused, 0 deletes them on the
+     * first acquire of the next frame.
+     */
+    void setRenderTargetPoolMaxIdleFrames(uint64_t frames);
+    [[nodiscard]] const RenderTargetPoolStats& getRenderTargetPoolStats() const;
+
 private:
     TextureDesc sanitizeTextureDesc(const TextureDesc& desc) const;
 
@@ -50,6 +123,18 @@ private:
     PlatformDevice platformDevice;
     std::shared_ptr<Context> context;
     std::shared_ptr<CommandPool> commandPool;
+    std::shared_ptr<CommandQueue> commandQueue;
+    // heaps of the buffers created with BufferDesc::subAllocate, created on first use
+    std::shared_ptr<BufferHeap> vertexBufferHeap;
+    std::shared_ptr<BufferHeap> indexBufferHeap;
+    std::shared_ptr<ShaderCache> shaderCache;
+    std::shared_ptr<PipelineCache<GraphicsPipelineDesc, GraphicsPipelineDescHash, IGraphicsPipeline>> graphicsPipelineCache;
+    std::shared_ptr<PipelineCache<ComputePipelineDesc, ComputePipelineDescHash, IComputePipeline>> computePipelineCache;
+    // not owning, sampler objects nobody uses anymore are deleted and created again on the next request
+    std::unordered_map<SamplerStateDesc, std::weak_ptr<SamplerState>, SamplerStateDescHash> samplerStates;
+    // null without ARB_bindless_texture
+    std::shared_ptr<TextureResidency> textureResidency;
+    std::shared_ptr<RenderTargetPool> renderTargetPool;
 };
 
 }
@@ -0,0 +1,27 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace opengl {
+
+/**
+ * @brief Counters of a pipeline cache of opengl::Device, accumulated since creation.
+ */
+struct PipelineCacheStats
+{
+    /** @brief create*Pipeline calls that returned a cached pipeline */
+    uint64_t hits = 0;
+    /** @brief create*Pipeline calls that created a new pipeline */
+    uint64_t misses = 0;
+    /** @brief Least recently used pipelines dropped to stay within the capacity */
+    uint64_t evictions = 0;
+    /** @brief Number of pipelines in the cache */
+    size_t size = 0;
+};
+
+}// namespace opengl
@@ -0,0 +1,31 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace opengl {
+
+/**
+ * @brief Counters of the render target pool of opengl::Device, hits and misses are accumulated since creation.
+ */
+struct RenderTargetPoolStats
+{
+    /** @brief acquire* calls that returned a pooled texture or framebuffer */
+    uint64_t hits = 0;
+    /** @brief acquire* calls that created a new texture or framebuffer */
+    uint64_t misses = 0;
+    /** @brief Textures and framebuffers released after being unused for too many frames */
+    uint64_t evictions = 0;
+    /** @brief Number of pooled textures, in use or not */
+    size_t textureCount = 0;
+    /** @brief Number of pooled framebuffers, in use or not */
+    size_t framebufferCount = 0;
+    /** @brief Estimated size in bytes of the pooled textures */
+    size_t memory = 0;
+};
+
+}// namespace opengl
@@ -0,0 +1,28 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace opengl {
+
+/**
+ * @brief Counters of the shader module and program binary caches of opengl::Device, accumulated since creation.
+ */
+struct ShaderCacheStats
+{
+    /** @brief createShaderModule calls that returned an already compiled module */
+    uint64_t moduleHits = 0;
+    /** @brief createShaderModule calls that compiled the source */
+    uint64_t moduleMisses = 0;
+    /** @brief Programs loaded from an on-disk program binary */
+    uint64_t programBinaryHits = 0;
+    /** @brief Programs linked from source because no program binary was stored for them */
+    uint64_t programBinaryMisses = 0;
+    /** @brief Program binaries found on disk but rejected by the driver, the program was linked from source */
+    uint64_t programBinaryRejects = 0;
+};
+
+}// namespace opengl
@@ -0,0 +1,571 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "graphicsAPI/common/FrameGraph.h"
+#include "graphicsAPI/common/Util.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr int32_t DEPTH_ATTACHMENT = -1;
+constexpr int32_t STENCIL_ATTACHMENT = -2;
+
+uint32_t toBarrierBits(FrameGraphAccess access, bool isBuffer)
+{
+    switch (access)
+    {
+        case FrameGraphAccess::Sampled:
+            return Barrier_TextureFetch;
+        case FrameGraphAccess::StorageRead:
+        case FrameGraphAccess::StorageWrite:
+            return isBuffer ? Barrier_ShaderStorage : Barrier_ShaderImage;
+        case FrameGraphAccess::VertexBuffer:
+            return Barrier_VertexBuffer;
+        case FrameGraphAccess::IndexBuffer:
+            return Barrier_IndexBuffer;
+        case FrameGraphAccess::UniformBuffer:
+            return Barrier_UniformBuffer;
+        case FrameGraphAccess::IndirectBuffer:
+            return Barrier_IndirectBuffer;
+        case FrameGraphAccess::Attachment:
+            return Barrier_Framebuffer;
+    }
+    return 0;
+}
+
+}// namespace
+
+FrameGraphBuilder::FrameGraphBuilder(FrameGraph& graph, uint32_t pass)
+    : graph(graph), pass(pass)
+{
+}
+
+FrameGraphResource FrameGraphBuilder::read(FrameGraphResource resource, FrameGraphAccess access)
+{
+    // validates the handle
+    (void) graph.getEntry(resource);
+    graph.passes[pass].reads.push_back({resource.id, access});
+    return resource;
+}
+
+FrameGraphResource FrameGraphBuilder::write(FrameGraphResource resource, FrameGraphAccess access)
+{
+    const auto& entry = graph.getEntry(resource);
+    if (entry.latestNode != resource.id)
+    {
+        throw std::runtime_error("Only the latest version of the frame graph resource " + entry.name + " can be written");
+    }
+    const auto written = graph.addNode(graph.nodes[resource.id].entry, pass);
+    graph.passes[pass].writes.push_back({written.id, access});
+    return written;
+}
+
+FrameGraphResource FrameGraphBuilder::setColorAttachment(uint32_t index, FrameGraphResource resource, std::optional<Color> clearColor)
+{
+    if (index >= MAX_COLOR_ATTACHMENTS)
+    {
+        throw std::runtime_error("Color attachment index out of range");
+    }
+    auto& colorAttachments = graph.passes[pass].renderPass.colorAttachments;
+    if (colorAttachments.size() <= index)
+    {
+        colorAttachments.resize(index + 1, RenderPassDesc::ColorAttachmentDesc(LoadAction::DontCare, StoreAction::DontCare));
+    }
+    if (clearColor)
+    {
+        colorAttachments[index].clearColor = *clearColor;
+    }
+    return setAttachment(static_cast<int32_t>(index), resource, clearColor.has_value());
+}
+
+FrameGraphResource FrameGraphBuilder::setDepthAttachment(FrameGraphResource resource, std::optional<float> clearDepth)
+{
+    graph.passes[pass].renderPass.depthAttachment.clearDepth = clearDepth.value_or(1.0f);
+    return setAttachment(DEPTH_ATTACHMENT, resource, clearDepth.has_value());
+}
+
+FrameGraphResource FrameGraphBuilder::setStencilAttachment(FrameGraphResource resource, std::optional<uint32_t> clearStencil)
+{
+    graph.passes[pass].renderPass.stencilAttachment.clearStencil = clearStencil.value_or(0);
+    return setAttachment(STENCIL_ATTACHMENT, resource, clearStencil.has_value());
+}
+
+FrameGraphResource FrameGraphBuilder::setAttachment(int32_t index, FrameGraphResource resource, bool clear)
+{
+    if (graph.passes[pass].compute)
+    {
+        throw std::runtime_error("Compute passes have no attachments");
+    }
+    const auto& entry = graph.getEntry(resource);
+    if (entry.buffer)
+    {
+        throw std::runtime_error("The buffer " + entry.name + " cannot be used as an attachment");
+    }
+    // the previous content is only kept if it exists, the read keeps the pass that wrote it alive
+    const bool load = !clear && (graph.nodes[resource.id].producer != FrameGraph::INVALID_INDEX || entry.imported);
+    if (load)
+    {
+        read(resource, FrameGraphAccess::Attachment);
+    }
+    const auto written = write(resource, FrameGraphAccess::Attachment);
+    graph.passes[pass].attachments.push_back({index, written.id, clear, load});
+    return written;
+}
+
+void FrameGraphBuilder::setDrawReorderMode(DrawReorderMode mode)
+{
+    graph.passes[pass].drawReorderMode = mode;
+}
+
+void FrameGraphBuilder::setSideEffect()
+{
+    graph.passes[pass].sideEffect = true;
+}
+
+FrameGraph::FrameGraph(IDevice& device)
+    : device(device)
+{
+}
+
+FrameGraphResource FrameGraph::createTexture(std::string name, const TextureDesc& desc)
+{
+    ResourceEntry entry;
+    entry.name = std::move(name);
+    entry.textureDesc = desc;
+    return addResource(std::move(entry));
+}
+
+FrameGraphResource FrameGraph::importTexture(std::string name, std::shared_ptr<ITexture> texture)
+{
+    if (!texture)
+    {
+        throw std::runtime_error("Cannot import a null texture into the frame graph");
+    }
+    ResourceEntry entry;
+    entry.name = std::move(name);
+    entry.imported = true;
+    entry.texture = std::move(texture);
+    return addResource(std::move(entry));
+}
+
+FrameGraphResource FrameGraph::importBuffer(std::string name, std::shared_ptr<IBuffer> buffer)
+{
+    if (!buffer)
+    {
+        throw std::runtime_error("Cannot import a null buffer into the frame graph");
+    }
+    ResourceEntry entry;
+    entry.name = std::move(name);
+    entry.imported = true;
+    entry.buffer = std::move(buffer);
+    return addResource(std::move(entry));
+}
+
+FrameGraphResource FrameGraph::importBackbuffer(std::string name)
+{
+    ResourceEntry entry;
+    entry.name = std::move(name);
+    entry.imported = true;
+    entry.backbuffer = true;
+    return addResource(std::move(entry));
+}
+
+FrameGraphResource FrameGraph::addResource(ResourceEntry entry)
+{
+    entries.push_back(std::move(entry));
+    return addNode(static_cast<uint32_t>(entries.size() - 1), INVALID_INDEX);
+}
+
+FrameGraphResource FrameGraph::addNode(uint32_t entry, uint32_t producer)
+{
+    const auto node = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({entry, producer, 0});
+    entries[entry].latestNode = node;
+    compiled = false;
+    return {node};
+}
+
+uint32_t FrameGraph::addGraphicsPass(std::string name, const SetupFunction& setup, GraphicsExecuteFunction execute)
+{
+    const uint32_t pass = addPass(std::move(name), false, setup);
+    passes[pass].executeGraphics = std::move(execute);
+    return pass;
+}
+
+uint32_t FrameGraph::addComputePass(std::string name, const SetupFunction& setup, ComputeExecuteFunction execute)
+{
+    const uint32_t pass = addPass(std::move(name), true, setup);
+    passes[pass].executeCompute = std::move(execute);
+    return pass;
+}
+
+uint32_t FrameGraph::addPass(std::string name, bool compute, const SetupFunction& setup)
+{
+    const auto index = static_cast<uint32_t>(passes.size());
+    auto& pass = passes.emplace_back();
+    pass.name = std::move(name);
+    pass.compute = compute;
+    // only the attachments declared by the pass are cleared
+    pass.renderPass.depthAttachment.loadAction = LoadAction::DontCare;
+    pass.renderPass.stencilAttachment.loadAction = LoadAction::DontCare;
+    compiled = false;
+
+    FrameGraphBuilder builder(*this, index);
+    setup(builder);
+    return index;
+}
+
+const FrameGraph::ResourceEntry& FrameGraph::getEntry(FrameGraphResource resource) const
+{
+    if (!resource.isValid() || resource.id >= nodes.size())
+    {
+        throw std::runtime_error("Invalid frame graph resource");
+    }
+    return entries[nodes[resource.id].entry];
+}
+
+void FrameGraph::compile()
+{
+    transientTextures.clear();
+    for (auto& entry : entries)
+    {
+        entry.firstPass = INVALID_INDEX;
+        entry.lastPass = INVALID_INDEX;
+        if (!entry.imported)
+        {
+            entry.texture = nullptr;
+        }
+    }
+    for (auto& pass : passes)
+    {
+        pass.framebuffer = nullptr;
+    }
+
+    cullPasses();
+    allocateTransientTextures();
+    createRenderPasses();
+    computeBarriers();
+    compiled = true;
+}
+
+void FrameGraph::cullPasses()
+{
+    for (auto& node : nodes)
+    {
+        node.readCount = 0;
+    }
+    for (auto& pass : passes)
+    {
+        pass.refCount = static_cast<uint32_t>(pass.writes.size());
+        pass.culled = false;
+        for (const auto& read : pass.reads)
+        {
+            ++nodes[read.node].readCount;
+        }
+    }
+    // imported resources outlive the frame, their final version is its output
+    for (const auto& entry : entries)
+    {
+        if (entry.imported)
+        {
+            ++nodes[entry.latestNode].readCount;
+        }
+    }
+
+    std::vector<uint32_t> unreferenced;
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].readCount == 0)
+        {
+            unreferenced.push_back(i);
+        }
+    }
+
+    auto cull = [&](Pass& pass) {
+        pass.culled = true;
+        for (const auto& read : pass.reads)
+        {
+            if (--nodes[read.node].readCount == 0)
+            {
+                unreferenced.push_back(read.node);
+            }
+        }
+    };
+    for (auto& pass : passes)
+    {
+        if (pass.refCount == 0 && !pass.sideEffect)
+        {
+            cull(pass);
+        }
+    }
+    // a pass is culled once none of the versions it writes is read anymore
+    while (!unreferenced.empty())
+    {
+        const uint32_t producer = nodes[unreferenced.back()].producer;
+        unreferenced.pop_back();
+        if (producer == INVALID_INDEX)
+        {
+            continue;
+        }
+        auto& pass = passes[producer];
+        if (!pass.culled && !pass.sideEffect && --pass.refCount == 0)
+        {
+            cull(pass);
+        }
+    }
+}
+
+void FrameGraph::allocateTransientTextures()
+{
+    for (uint32_t i = 0; i < passes.size(); ++i)
+    {
+        if (passes[i].culled)
+        {
+            continue;
+        }
+        for (const auto* accesses : {&passes[i].reads, &passes[i].writes})
+        {
+            for (const auto& access : *accesses)
+            {
+                auto& entry = entries[nodes[access.node].entry];
+                entry.firstPass = std::min(entry.firstPass, i);
+                entry.lastPass = entry.lastPass == INVALID_INDEX ? i : std::max(entry.lastPass, i);
+            }
+        }
+    }
+
+    std::vector<ResourceEntry*> transients;
+    for (auto& entry : entries)
+    {
+        if (!entry.imported && entry.firstPass != INVALID_INDEX)
+        {
+            transients.push_back(&entry);
+        }
+    }
+    std::ranges::sort(transients, {}, &ResourceEntry::firstPass);
+
+    // GL cannot alias the memory of different textures, resources alias at the granularity of equal descriptions
+    for (auto* entry : transients)
+    {
+        auto it = std::ranges::find_if(transientTextures, [entry](const TransientTexture& transient) {
+            return transient.lastPass < entry->firstPass && transient.desc == entry->textureDesc;
+        });
+        if (it == transientTextures.end())
+        {
+            auto texture = device.acquireRenderTarget(entry->textureDesc);
+            if (!texture)
+            {
+                throw std::runtime_error("Failed to create the transient texture " + entry->name);
+            }
+            it = transientTextures.insert(transientTextures.end(), {std::move(texture), entry->textureDesc, 0});
+        }
+        it->lastPass = entry->lastPass;
+        entry->texture = it->texture;
+    }
+}
+
+void FrameGraph::createRenderPasses()
+{
+    for (auto& pass : passes)
+    {
+        if (pass.culled || pass.compute)
+        {
+            continue;
+        }
+
+        FramebufferDesc framebufferDesc;
+        bool backbuffer = false;
+        bool offscreen = false;
+        for (const auto& attachment : pass.attachments)
+        {
+            const auto& entry = entries[nodes[attachment.node].entry];
+            const LoadAction loadAction = attachment.clear ? LoadAction::Clear : attachment.load ? LoadAction::Load : LoadAction::DontCare;
+            // stored only if a later pass reads this version, or it is the final version of an imported texture
+            const StoreAction storeAction = nodes[attachment.node].readCount > 0 ? StoreAction::Store : StoreAction::DontCare;
+            (entry.backbuffer ? backbuffer : offscreen) = true;
+
+            RenderPassDesc::BaseAttachmentDesc* attachmentDesc = nullptr;
+            if (attachment.index == DEPTH_ATTACHMENT)
+            {
+                attachmentDesc = &pass.renderPass.depthAttachment;
+                framebufferDesc.depthAttachment.texture = entry.texture;
+            }
+            else if (attachment.index == STENCIL_ATTACHMENT)
+            {
+                attachmentDesc = &pass.renderPass.stencilAttachment;
+                framebufferDesc.stencilAttachment.texture = entry.texture;
+            }
+            else
+            {
+                attachmentDesc = &pass.renderPass.colorAttachments[attachment.index];
+                framebufferDesc.colorAttachments[attachment.index].texture = entry.texture;
+            }
+            attachmentDesc->loadAction = loadAction;
+            attachmentDesc->storeAction = storeAction;
+        }
+
+        if (backbuffer && offscreen)
+        {
+            throw std::runtime_error("The pass " + pass.name + " mixes backbuffer and texture attachments");
+        }
+        if (!backbuffer && !offscreen)
+        {
+            throw std::runtime_error("The graphics pass " + pass.name + " has no attachments");
+        }
+        if (backbuffer)
+        {
+            // the default framebuffer is bound for a null framebuffer
+            continue;
+        }
+
+        // passes with the same attachments share the framebuffer
+        pass.framebuffer = device.acquireFramebuffer(framebufferDesc);
+    }
+}
+
+void FrameGraph::computeBarriers()
+{
+    for (auto& entry : entries)
+    {
+        entry.pendingStore = false;
+        entry.visibleBarriers = 0;
+    }
+
+    for (auto& pass : passes)
+    {
+        pass.barriers = 0;
+        if (pass.culled)
+        {
+            continue;
+        }
+
+        // only shader stores are incoherent, attachment writes and uploads are ordered by GL
+        for (const auto* accesses : {&pass.reads, &pass.writes})
+        {
+            for (const auto& access : *accesses)
+            {
+                const auto& entry = entries[nodes[access.node].entry];
+                if (entry.pendingStore)
+                {
+                    pass.barriers |= toBarrierBits(access.access, entry.buffer != nullptr) & ~entry.visibleBarriers;
+                }
+            }
+        }
+        // a barrier covers every store issued before it
+        if (pass.barriers != 0)
+        {
+            for (auto& entry : entries)
+            {
+                if (entry.pendingStore)
+                {
+                    entry.visibleBarriers |= pass.barriers;
+                }
+            }
+        }
+        for (const auto& write : pass.writes)
+        {
+            if (write.access == FrameGraphAccess::StorageWrite)
+            {
+                auto& entry = entries[nodes[write.node].entry];
+                entry.pendingStore = true;
+                entry.visibleBarriers = 0;
+            }
+        }
+    }
+}
+
+void FrameGraph::execute(ICommandPool& commandPool, const CommandBufferDesc& desc)
+{
+    if (!compiled)
+    {
+        compile();
+    }
+
+    // a failure partway through would leave the passes before it submitted
+    if (!commandPool.hasComputeCommandBuffers())
+    {
+        const auto it = std::ranges::find_if(passes, [](const Pass& pass) { return pass.compute && !pass.culled; });
+        if (it != passes.end())
+        {
+            throw std::runtime_error("The compute pass " + it->name + " cannot be recorded with a command pool without compute command buffers");
+        }
+    }
+
+    for (auto& pass : passes)
+    {
+        if (pass.culled)
+        {
+            continue;
+        }
+
+        if (pass.compute)
+        {
+            CommandBufferDesc computeDesc = desc;
+            computeDesc.automaticMemoryBarriers = false;
+            auto commandBuffer = commandPool.acquireComputeCommandBuffer(computeDesc);
+            commandBuffer->begin();
+            if (pass.barriers != 0)
+            {
+                commandBuffer->memoryBarrier(pass.barriers);
+            }
+            if (pass.executeCompute)
+            {
+                pass.executeCompute(*commandBuffer, *this);
+            }
+            commandBuffer->end();
+            commandPool.submitCommandBuffer(std::move(commandBuffer));
+            continue;
+        }
+
+        auto commandBuffer = commandPool.acquireGraphicsCommandBuffer(desc);
+        if (pass.barriers != 0)
+        {
+            commandBuffer->memoryBarrier(pass.barriers);
+        }
+        // the passes render to their whole framebuffer
+        commandBuffer->beginRenderPass({pass.renderPass, pass.framebuffer, pass.drawReorderMode, ScissorRect{}});
+        if (pass.executeGraphics)
+        {
+            pass.executeGraphics(*commandBuffer, *this);
+        }
+        commandBuffer->endRenderPass();
+        commandPool.submitCommandBuffer(std::move(commandBuffer));
+    }
+}
+
+void FrameGraph::reset()
+{
+    entries.clear();
+    nodes.clear();
+    passes.clear();
+    transientTextures.clear();
+    compiled = false;
+}
+
+std::shared_ptr<ITexture> FrameGraph::getTexture(FrameGraphResource resource) const
+{
+    return getEntry(resource).texture;
+}
+
+std::shared_ptr<IBuffer> FrameGraph::getBuffer(FrameGraphResource resource) const
+{
+    return getEntry(resource).buffer;
+}
+
+bool FrameGraph::isPassCulled(uint32_t pass) const
+{
+    return passes.at(pass).culled;
+}
+
+uint32_t FrameGraph::getPassBarriers(uint32_t pass) const
+{
+    return passes.at(pass).barriers;
+}
+
+size_t FrameGraph::getTransientTextureCount() const
+{
+    return transientTextures.size();
+}
@@ -147,11 +147,12 @@ Float4,
     return 0;
 }
 
-VertexInputStateDescBuilder& VertexInputStateDescBuilder::beginBinding(uint32_t binding)
+VertexInputStateDescBuilder& VertexInputStateDescBuilder::beginBinding(uint32_t binding, VertexInputRate inputRate)
 {
     currentBindingDesc = {
         .binding = binding,
         .stride = 0,
+        .inputRate = inputRate,
     };
     bindingStarted = true;
     return *this;
@@ -0,0 +1,84 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "Buffer.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace null {
+
+Buffer::Buffer(const BufferDesc& desc)
+    : type(desc.type)
+    , resourceStorage(desc.storage)
+    , storage(desc.size)
+{
+    if (desc.data && desc.size > 0)
+    {
+        std::memcpy(storage.data(), desc.data, desc.size);
+    }
+}
+
+void Buffer::data(const void* data, uint32_t size, uint32_t offset) const
+{
+    if (static_cast<size_t>(offset) + size > storage.size())
+    {
+        throw std::runtime_error("Buffer data out of range");
+    }
+    if (data && size > 0)
+    {
+        std::memcpy(storage.data() + offset, data, size);
+    }
+}
+
+void* Buffer::map(uint32_t size, uint32_t offset) const
+{
+    if (static_cast<size_t>(offset) + size > storage.size())
+    {
+        throw std::runtime_error("Buffer map out of range");
+    }
+    return storage.data() + offset;
+}
+
+void Buffer::unmap() const
+{
+}
+
+BufferAllocation Buffer::allocate(uint32_t size, uint32_t alignment) const
+{
+    if (resourceStorage != ResourceStorage::Ring)
+    {
+        throw std::runtime_error("Only ResourceStorage::Ring buffers can be sub-allocated");
+    }
+    if (size == 0 || size > storage.size())
+    {
+        throw std::runtime_error("Ring buffer allocation size out of range");
+    }
+
+    if (alignment == 0)
+    {
+        // same as the usual GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+        alignment = (type & (BufferDesc::BufferTypeBits::Uniform | BufferDesc::BufferTypeBits::Storage)) ? 256 : 16;
+    }
+    uint32_t start = (ringHead + alignment - 1) / alignment * alignment;
+    if (static_cast<size_t>(start) + size > storage.size())
+    {
+        start = 0;
+    }
+    ringHead = start + size;
+    return {storage.data() + start, start, size};
+}
+
+std::optional<BufferAllocation> Buffer::tryAllocate(uint32_t size, uint32_t alignment) const
+{
+    // the ring always has room, nothing is ever in flight
+    return allocate(size, alignment);
+}
+
+size_t Buffer::getSize() const
+{
+    return storage.size();
+}
+
+}// namespace null
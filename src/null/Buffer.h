@@ -0,0 +1,45 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/Buffer.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace null {
+
+class Buffer : public IBuffer
+{
+public:
+    explicit Buffer(const BufferDesc& desc);
+
+    void data(const void* data, uint32_t size, uint32_t offset) const override;
+    [[nodiscard]] void* map(uint32_t size, uint32_t offset) const override;
+    void unmap() const override;
+    [[nodiscard]] BufferAllocation allocate(uint32_t size, uint32_t alignment = 0) const override;
+    [[nodiscard]] std::optional<BufferAllocation> tryAllocate(uint32_t size, uint32_t alignment = 0) const override;
+
+    [[nodiscard]] size_t getSize() const override;
+
+    [[nodiscard]] BufferDesc::BufferType getType() const
+    {
+        return type;
+    }
+
+    [[nodiscard]] const std::byte* getData() const
+    {
+        return storage.data();
+    }
+
+private:
+    BufferDesc::BufferType type;
+    ResourceStorage resourceStorage;
+    mutable std::vector<std::byte> storage;
+    // ring buffers never wait, there is no GPU reading them
+    mutable uint32_t ringHead = 0;
+};
+
+}// namespace null
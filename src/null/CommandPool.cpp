@@ -0,0 +1,65 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "CommandPool.h"
+
+#include "graphicsAPI/null/Device.h"
+
+#include <utility>
+
+namespace null {
+
+CommandPool::CommandPool(Device& device)
+    : device(device)
+{
+}
+
+std::unique_ptr<IGraphicsCommandBuffer> CommandPool::acquireGraphicsCommandBuffer(const CommandBufferDesc& desc)
+{
+    std::unique_ptr<GraphicsCommandBuffer> commandBuffer;
+    if (freeGraphicsCommandBuffers.empty())
+    {
+        commandBuffer = std::make_unique<GraphicsCommandBuffer>(device.isCommandLogEnabled());
+    }
+    else
+    {
+        commandBuffer = std::move(freeGraphicsCommandBuffers.back());
+        freeGraphicsCommandBuffers.pop_back();
+    }
+    commandBuffer->begin(desc);
+    return commandBuffer;
+}
+
+void CommandPool::submitCommandBuffer(std::unique_ptr<IGraphicsCommandBuffer> commandBuffer)
+{
+    auto nullCommandBuffer = std::unique_ptr<GraphicsCommandBuffer>(static_cast<GraphicsCommandBuffer*>(commandBuffer.release()));
+    device.appendToCommandLog(nullCommandBuffer->getCommands());
+    nullCommandBuffer->reset();
+    freeGraphicsCommandBuffers.push_back(std::move(nullCommandBuffer));
+}
+
+std::unique_ptr<IComputeCommandBuffer> CommandPool::acquireComputeCommandBuffer(const CommandBufferDesc& /*desc*/)
+{
+    std::unique_ptr<ComputeCommandBuffer> commandBuffer;
+    if (freeComputeCommandBuffers.empty())
+    {
+        commandBuffer = std::make_unique<ComputeCommandBuffer>(device.isCommandLogEnabled());
+    }
+    else
+    {
+        commandBuffer = std::move(freeComputeCommandBuffers.back());
+        freeComputeCommandBuffers.pop_back();
+    }
+    return commandBuffer;
+}
+
+void CommandPool::submitCommandBuffer(std::unique_ptr<IComputeCommandBuffer> commandBuffer)
+{
+    auto nullCommandBuffer = std::unique_ptr<ComputeCommandBuffer>(static_cast<ComputeCommandBuffer*>(commandBuffer.release()));
+    device.appendToCommandLog(nullCommandBuffer->getCommands());
+    nullCommandBuffer->reset();
+    freeComputeCommandBuffers.push_back(std::move(nullCommandBuffer));
+}
+
+}// namespace null
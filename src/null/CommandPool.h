@@ -0,0 +1,40 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "ComputeCommandBuffer.h"
+#include "GraphicsCommandBuffer.h"
+#include "graphicsAPI/common/CommandPool.h"
+
+#include <memory>
+#include <vector>
+
+namespace null {
+
+class Device;
+
+/**
+ * @brief Command pool of the null device. Immediate and deferred pools behave the same: commands are recorded on the
+ * calling thread and appended to the device command log when submitted, in submission order.
+ */
+class CommandPool : public ICommandPool
+{
+public:
+    explicit CommandPool(Device& device);
+
+    std::unique_ptr<IGraphicsCommandBuffer> acquireGraphicsCommandBuffer(const CommandBufferDesc& desc) override;
+    void submitCommandBuffer(std::unique_ptr<IGraphicsCommandBuffer> commandBuffer) override;
+
+    std::unique_ptr<IComputeCommandBuffer> acquireComputeCommandBuffer(const CommandBufferDesc& desc) override;
+    void submitCommandBuffer(std::unique_ptr<IComputeCommandBuffer> commandBuffer) override;
+
+private:
+    Device& device;
+
+    std::vector<std::unique_ptr<GraphicsCommandBuffer>> freeGraphicsCommandBuffers;
+    std::vector<std::unique_ptr<ComputeCommandBuffer>> freeComputeCommandBuffers;
+};
+
+}// namespace null
@@ -0,0 +1,137 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "ComputeCommandBuffer.h"
+
+#include "graphicsAPI/common/Common.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace null {
+
+ComputeCommandBuffer::ComputeCommandBuffer(bool commandLogEnabled)
+    : commandLogEnabled(commandLogEnabled)
+{
+}
+
+void ComputeCommandBuffer::reset()
+{
+    commands.clear();
+    retainedResources.clear();
+    isRecording = false;
+    hasPipeline = false;
+}
+
+void ComputeCommandBuffer::record(Command&& command)
+{
+    if (commandLogEnabled)
+    {
+        commands.push_back(std::move(command));
+    }
+}
+
+void ComputeCommandBuffer::retain(std::shared_ptr<void> resource)
+{
+    if (commandLogEnabled && resource)
+    {
+        retainedResources.push_back(std::move(resource));
+    }
+}
+
+void ComputeCommandBuffer::begin()
+{
+    if (isRecording)
+    {
+        std::cerr << "Command buffer is already recording" << std::endl;
+        return;
+    }
+    isRecording = true;
+    record(command::BeginCompute{});
+}
+
+void ComputeCommandBuffer::end()
+{
+    if (!isRecording)
+    {
+        std::cerr << "Command buffer is not recording" << std::endl;
+        return;
+    }
+    isRecording = false;
+    record(command::EndCompute{});
+}
+
+void ComputeCommandBuffer::bindComputePipeline(const std::shared_ptr<IComputePipeline>& pipeline)
+{
+    hasPipeline = pipeline != nullptr;
+    record(command::BindComputePipeline{pipeline.get()});
+    retain(pipeline);
+}
+
+void ComputeCommandBuffer::dispatch(const ThreadGroupDimensions& dimensions)
+{
+    if (!hasPipeline)
+    {
+        std::cerr << "No compute pipeline bound" << std::endl;
+        return;
+    }
+    record(command::Dispatch{dimensions});
+}
+
+void ComputeCommandBuffer::bindBuffer(size_t index, std::shared_ptr<IBuffer> buffer, size_t offset)
+{
+    record(command::BindComputeBuffer{index, buffer.get(), offset});
+    retain(std::move(buffer));
+}
+
+void ComputeCommandBuffer::bindImage(size_t index, std::shared_ptr<ITexture> texture, uint8_t accessFlags, uint32_t mipLevel, uint32_t layer)
+{
+    if (index >= MAX_TEXTURE_UNITS)
+    {
+        std::cerr << "Texture index out of range" << std::endl;
+        return;
+    }
+    record(command::BindImage{index, texture.get(), accessFlags, mipLevel, layer});
+    retain(std::move(texture));
+}
+
+void ComputeCommandBuffer::bindTexture(size_t index, std::shared_ptr<ITexture> texture)
+{
+    if (index >= MAX_TEXTURE_UNITS)
+    {
+        std::cerr << "Texture index out of range" << std::endl;
+        return;
+    }
+    record(command::BindComputeTexture{index, texture.get()});
+    retain(std::move(texture));
+}
+
+void ComputeCommandBuffer::bindSamplerState(size_t index, std::shared_ptr<ISamplerState> samplerState)
+{
+    if (index >= MAX_TEXTURE_SAMPLERS)
+    {
+        std::cerr << "Sampler index out of range" << std::endl;
+        return;
+    }
+    record(command::BindComputeSamplerState{index, samplerState.get()});
+    retain(std::move(samplerState));
+}
+
+void ComputeCommandBuffer::pushConstants(uint32_t offset, const void* data, uint32_t size)
+{
+    if (static_cast<uint64_t>(offset) + size > MAX_PUSH_CONSTANTS_SIZE)
+    {
+        throw std::runtime_error("Push constants out of range");
+    }
+    const auto* bytes = static_cast<const std::byte*>(data);
+    record(command::ComputePushConstants{offset, {bytes, bytes + size}});
+}
+
+void ComputeCommandBuffer::memoryBarrier(uint32_t barriers)
+{
+    record(command::ComputeBarrier{barriers});
+}
+
+}// namespace null
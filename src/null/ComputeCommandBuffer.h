@@ -0,0 +1,56 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/ComputeCommandBuffer.h"
+#include "graphicsAPI/null/CommandLog.h"
+
+#include <memory>
+#include <vector>
+
+namespace null {
+
+class ComputeCommandBuffer : public IComputeCommandBuffer
+{
+public:
+    explicit ComputeCommandBuffer(bool commandLogEnabled);
+
+    void begin() override;
+    void end() override;
+
+    void bindComputePipeline(const std::shared_ptr<IComputePipeline>& pipeline) override;
+
+    void dispatch(const ThreadGroupDimensions& dimensions) override;
+
+    void bindBuffer(size_t index, std::shared_ptr<IBuffer> buffer, size_t offset) override;
+    void bindImage(size_t index, std::shared_ptr<ITexture> texture, uint8_t accessFlags, uint32_t mipLevel, uint32_t layer) override;
+    void bindTexture(size_t index, std::shared_ptr<ITexture> texture) override;
+    void bindSamplerState(size_t index, std::shared_ptr<ISamplerState> samplerState) override;
+    void pushConstants(uint32_t offset, const void* data, uint32_t size) override;
+    void memoryBarrier(uint32_t barriers) override;
+
+    // clears the recorded commands and releases every resource bound while recording
+    void reset();
+
+    [[nodiscard]] std::vector<Command>& getCommands()
+    {
+        return commands;
+    }
+
+private:
+    void record(Command&& command);
+    void retain(std::shared_ptr<void> resource);
+
+private:
+    bool commandLogEnabled;
+    bool isRecording = false;
+    bool hasPipeline = false;
+
+    std::vector<Command> commands;
+    // keeps bound resources alive until the command buffer is submitted
+    std::vector<std::shared_ptr<void>> retainedResources;
+};
+
+}// namespace null
@@ -0,0 +1,159 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "graphicsAPI/null/Device.h"
+
+#include "Buffer.h"
+#include "CommandPool.h"
+#include "Framebuffer.h"
+#include "PipelineStates.h"
+#include "Texture.h"
+
+#include <algorithm>
+
+namespace null {
+
+Device::Device(bool commandLogEnabled)
+    : commandLogEnabled(commandLogEnabled)
+{
+}
+
+std::shared_ptr<ICommandPool> Device::createCommandPool(const CommandPoolDesc& /*desc*/)
+{
+    // pools keep their own free lists, so every recording thread can own one
+    return std::make_shared<CommandPool>(*this);
+}
+
+std::unique_ptr<IBuffer> Device::createBuffer(const BufferDesc& desc)
+{
+    return std::make_unique<Buffer>(desc);
+}
+
+std::shared_ptr<IShaderModule> Device::createShaderModule(const ShaderModuleDesc& desc)
+{
+    return std::make_shared<ShaderModule>(desc);
+}
+
+std::shared_ptr<IPipelineShaderStages> Device::createPipelineShaderStages(const PipelineShaderStagesDesc& desc)
+{
+    return std::make_shared<PipelineShaderStages>(desc);
+}
+
+std::shared_ptr<IGraphicsPipeline> Device::createGraphicsPipeline(const GraphicsPipelineDesc& desc)
+{
+    return std::make_shared<GraphicsPipeline>(desc);
+}
+
+std::shared_ptr<IComputePipeline> Device::createComputePipeline(const ComputePipelineDesc& desc)
+{
+    return std::make_shared<ComputePipeline>(desc);
+}
+
+std::shared_ptr<IFramebuffer> Device::createFramebuffer(const FramebufferDesc& desc)
+{
+    return std::make_shared<Framebuffer>(desc);
+}
+
+std::shared_ptr<ITexture> Device::createTexture(const TextureDesc& desc)
+{
+    TextureDesc sanitized = desc;
+    sanitized.width = std::max(sanitized.width, static_cast<size_t>(1));
+    sanitized.height = std::max(sanitized.height, static_cast<size_t>(1));
+    sanitized.depth = std::max(sanitized.depth, static_cast<size_t>(1));
+    sanitized.numLayers = std::max(sanitized.numLayers, static_cast<size_t>(1));
+    sanitized.numSamples = std::max(sanitized.numSamples, static_cast<size_t>(1));
+    sanitized.numMipLevels = std::max(sanitized.numMipLevels, static_cast<size_t>(1));
+    return std::make_shared<Texture>(sanitized);
+}
+
+std::shared_ptr<IVertexInputState> Device::createVertexInputState(const VertexInputStateDesc& desc)
+{
+    return std::make_shared<VertexInputState>(desc);
+}
+
+std::shared_ptr<IDepthStencilState> Device::createDepthStencilState(const DepthStencilStateDesc& desc)
+{
+    return std::make_shared<DepthStencilState>(desc);
+}
+
+std::shared_ptr<ISamplerState> Device::createSamplerState(const SamplerStateDesc& desc)
+{
+    return std::make_shared<SamplerState>(desc);
+}
+
+std::shared_ptr<ITexture> Device::acquireRenderTarget(const TextureDesc& desc)
+{
+    return createTexture(desc);
+}
+
+std::shared_ptr<IFramebuffer> Device::acquireFramebuffer(const FramebufferDesc& desc)
+{
+    return createFramebuffer(desc);
+}
+
+uint64_t Device::getBindlessTextureHandle(const std::shared_ptr<ITexture>& /*texture*/, const std::shared_ptr<ISamplerState>& /*samplerState*/)
+{
+    return 0;
+}
+
+void Device::beginFrame()
+{
+}
+
+void Device::endFrame()
+{
+}
+
+bool Device::hasFeature(DeviceFeatures feature) const
+{
+    switch (feature)
+    {
+        case DeviceFeatures::BufferRing:
+        case DeviceFeatures::Compute:
+        case DeviceFeatures::DrawIndexedIndirect:
+        case DeviceFeatures::MapBufferRange:
+        case DeviceFeatures::MultipleRenderTargets:
+        case DeviceFeatures::PushConstants:
+        case DeviceFeatures::StorageBuffers:
+        case DeviceFeatures::Texture2DArray:
+        case DeviceFeatures::Texture3D:
+        case DeviceFeatures::TextureNotPot:
+        case DeviceFeatures::UniformBlocks:
+            return true;
+        default:
+            return false;
+    }
+}
+
+ICapabilities::TextureFormatCapabilities Device::getTextureFormatCapabilities(TextureFormat format) const
+{
+    if (!TextureFormatProperties::fromTextureFormat(format).isValid())
+    {
+        return TextureFormatCapabilityBits::Unsupported;
+    }
+    return TextureFormatCapabilityBits::All;
+}
+
+void Device::clearCommandLog()
+{
+    std::lock_guard lock(commandLogMutex);
+    commandLog.clear();
+    submissionCount = 0;
+}
+
+void Device::appendToCommandLog(std::vector<Command>& commands)
+{
+    std::lock_guard lock(commandLogMutex);
+    if (commandLogEnabled)
+    {
+        commandLog.reserve(commandLog.size() + commands.size());
+        for (auto& command : commands)
+        {
+            commandLog.push_back({submissionCount, std::move(command)});
+        }
+    }
+    ++submissionCount;
+}
+
+}// namespace null
@@ -0,0 +1,59 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "Framebuffer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace null {
+
+Framebuffer::Framebuffer(FramebufferDesc desc)
+    : desc(std::move(desc))
+{
+}
+
+void Framebuffer::updateDrawable(std::shared_ptr<ITexture> drawable)
+{
+    if (drawable == nullptr)
+    {
+        desc.colorAttachments.erase(0);
+        return;
+    }
+    desc.colorAttachments[0].texture = std::move(drawable);
+}
+
+std::vector<size_t> Framebuffer::getColorAttachmentIndices() const
+{
+    std::vector<size_t> indices;
+    indices.reserve(desc.colorAttachments.size());
+    for (const auto& [index, attachment] : desc.colorAttachments)
+    {
+        indices.push_back(index);
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+std::shared_ptr<ITexture> Framebuffer::getColorAttachment(size_t index) const
+{
+    auto it = desc.colorAttachments.find(index);
+    if (it == desc.colorAttachments.end())
+    {
+        return nullptr;
+    }
+    return it->second.texture;
+}
+
+std::shared_ptr<ITexture> Framebuffer::getDepthAttachment() const
+{
+    return desc.depthAttachment.texture;
+}
+
+std::shared_ptr<ITexture> Framebuffer::getStencilAttachment() const
+{
+    return desc.stencilAttachment.texture;
+}
+
+}// namespace null
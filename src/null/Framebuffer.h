@@ -0,0 +1,27 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/Framebuffer.h"
+
+namespace null {
+
+class Framebuffer : public IFramebuffer
+{
+public:
+    explicit Framebuffer(FramebufferDesc desc);
+
+    void updateDrawable(std::shared_ptr<ITexture> drawable) override;
+
+    [[nodiscard]] std::vector<size_t> getColorAttachmentIndices() const override;
+    [[nodiscard]] std::shared_ptr<ITexture> getColorAttachment(size_t index) const override;
+    [[nodiscard]] std::shared_ptr<ITexture> getDepthAttachment() const override;
+    [[nodiscard]] std::shared_ptr<ITexture> getStencilAttachment() const override;
+
+private:
+    FramebufferDesc desc;
+};
+
+}// namespace null
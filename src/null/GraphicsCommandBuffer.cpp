@@ -0,0 +1,184 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "GraphicsCommandBuffer.h"
+
+#include "graphicsAPI/common/Common.h"
+#include "graphicsAPI/common/Util.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace null {
+
+GraphicsCommandBuffer::GraphicsCommandBuffer(bool commandLogEnabled)
+    : commandLogEnabled(commandLogEnabled)
+{
+}
+
+void GraphicsCommandBuffer::begin(const CommandBufferDesc& /*desc*/)
+{
+    reset();
+}
+
+void GraphicsCommandBuffer::reset()
+{
+    commands.clear();
+    retainedResources.clear();
+    isInRenderPass = false;
+}
+
+void GraphicsCommandBuffer::record(Command&& command)
+{
+    if (commandLogEnabled)
+    {
+        commands.push_back(std::move(command));
+    }
+}
+
+void GraphicsCommandBuffer::retain(std::shared_ptr<void> resource)
+{
+    if (commandLogEnabled && resource)
+    {
+        retainedResources.push_back(std::move(resource));
+    }
+}
+
+void GraphicsCommandBuffer::beginRenderPass(const RenderPassBeginDesc& renderPass)
+{
+    if (isInRenderPass)
+    {
+        throw std::runtime_error("Render pass already started");
+    }
+    if (renderPass.renderPass.colorAttachments.size() > MAX_COLOR_ATTACHMENTS)
+    {
+        throw std::runtime_error("Too many color attachments in render pass");
+    }
+    isInRenderPass = true;
+    retain(renderPass.framebuffer);
+    record(command::BeginRenderPass{renderPass.renderPass, renderPass.framebuffer.get(), renderPass.drawReorderMode, renderPass.renderArea});
+}
+
+void GraphicsCommandBuffer::endRenderPass()
+{
+    if (!isInRenderPass)
+    {
+        throw std::runtime_error("No render pass started");
+    }
+    isInRenderPass = false;
+    record(command::EndRenderPass{});
+}
+
+void GraphicsCommandBuffer::bindGraphicsPipeline(std::shared_ptr<IGraphicsPipeline> pipeline)
+{
+    record(command::BindGraphicsPipeline{pipeline.get()});
+    retain(std::move(pipeline));
+}
+
+void GraphicsCommandBuffer::bindBuffer(uint32_t index, std::shared_ptr<IBuffer> buffer, uint32_t offset)
+{
+    record(command::BindBuffer{index, buffer.get(), offset});
+    retain(std::move(buffer));
+}
+
+void GraphicsCommandBuffer::draw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount)
+{
+    record(command::Draw{primitiveType, vertexStart, vertexCount});
+}
+
+void GraphicsCommandBuffer::drawIndexed(PrimitiveType primitiveType, size_t indexCount, IndexFormat indexFormat, IBuffer& indexBuffer, size_t indexBufferOffset, int32_t baseVertex)
+{
+    record(command::DrawIndexed{primitiveType, indexCount, indexFormat, &indexBuffer, indexBufferOffset, baseVertex});
+}
+
+void GraphicsCommandBuffer::drawInstanced(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount, size_t instanceCount, size_t baseInstance)
+{
+    record(command::Draw{primitiveType, vertexStart, vertexCount, instanceCount, baseInstance});
+}
+
+void GraphicsCommandBuffer::drawIndexedInstanced(PrimitiveType primitiveType,
+                                                 size_t indexCount,
+                                                 IndexFormat indexFormat,
+                                                 IBuffer& indexBuffer,
+                                                 size_t indexBufferOffset,
+                                                 int32_t baseVertex,
+                                                 size_t instanceCount,
+                                                 size_t baseInstance)
+{
+    record(command::DrawIndexed{primitiveType, indexCount, indexFormat, &indexBuffer, indexBufferOffset, baseVertex, instanceCount, baseInstance});
+}
+
+void GraphicsCommandBuffer::drawIndirect(PrimitiveType primitiveType, IBuffer& indirectBuffer, size_t indirectBufferOffset, uint32_t drawCount, uint32_t stride)
+{
+    record(command::DrawIndirect{primitiveType, &indirectBuffer, indirectBufferOffset, drawCount, stride});
+}
+
+void GraphicsCommandBuffer::drawIndexedIndirect(PrimitiveType primitiveType,
+                                                IndexFormat indexFormat,
+                                                IBuffer& indexBuffer,
+                                                IBuffer& indirectBuffer,
+                                                size_t indirectBufferOffset,
+                                                uint32_t drawCount,
+                                                uint32_t stride)
+{
+    record(command::DrawIndexedIndirect{primitiveType, indexFormat, &indexBuffer, &indirectBuffer, indirectBufferOffset, drawCount, stride});
+}
+
+void GraphicsCommandBuffer::bindViewport(const Viewport& viewport)
+{
+    record(command::BindViewport{viewport});
+}
+
+void GraphicsCommandBuffer::bindScissor(const ScissorRect& scissor)
+{
+    record(command::BindScissor{scissor});
+}
+
+void GraphicsCommandBuffer::bindDepthStencilState(const std::shared_ptr<IDepthStencilState>& depthStencilState)
+{
+    record(command::BindDepthStencilState{depthStencilState.get()});
+    retain(depthStencilState);
+}
+
+void GraphicsCommandBuffer::bindTexture(uint32_t index, uint8_t target, std::shared_ptr<ITexture> texture)
+{
+    if (index >= MAX_TEXTURE_UNITS)
+    {
+        throw std::runtime_error("No free texture units available");
+    }
+    record(command::BindTexture{index, target, texture.get()});
+    retain(std::move(texture));
+}
+
+void GraphicsCommandBuffer::bindSamplerState(uint32_t index, uint8_t target, std::shared_ptr<ISamplerState> samplerState)
+{
+    record(command::BindSamplerState{index, target, samplerState.get()});
+    retain(std::move(samplerState));
+}
+
+void GraphicsCommandBuffer::pushConstants(uint8_t target, uint32_t offset, const void* data, uint32_t size)
+{
+    if (static_cast<uint64_t>(offset) + size > MAX_PUSH_CONSTANTS_SIZE)
+    {
+        throw std::runtime_error("Push constants out of range");
+    }
+    const auto* bytes = static_cast<const std::byte*>(data);
+    record(command::PushConstants{target, offset, {bytes, bytes + size}});
+}
+
+void GraphicsCommandBuffer::memoryBarrier(uint32_t barriers)
+{
+    if (isInRenderPass)
+    {
+        throw std::runtime_error("Memory barriers must be recorded outside of render passes");
+    }
+    record(command::Barrier{barriers});
+}
+
+void GraphicsCommandBuffer::setDrawSortHint(const DrawSortHint& hint)
+{
+    record(command::SetDrawSortHint{hint});
+}
+
+}// namespace null
@@ -0,0 +1,87 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/GraphicsCommandBuffer.h"
+#include "graphicsAPI/null/CommandLog.h"
+
+#include <memory>
+#include <vector>
+
+namespace null {
+
+class GraphicsCommandBuffer : public IGraphicsCommandBuffer
+{
+public:
+    explicit GraphicsCommandBuffer(bool commandLogEnabled);
+
+    void beginRenderPass(const RenderPassBeginDesc& renderPass) override;
+    void endRenderPass() override;
+    void bindGraphicsPipeline(std::shared_ptr<IGraphicsPipeline> pipeline) override;
+    void bindBuffer(uint32_t index, std::shared_ptr<IBuffer> buffer, uint32_t offset) override;
+    void draw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount) override;
+    void drawIndexed(PrimitiveType primitiveType,
+                     size_t indexCount,
+                     IndexFormat indexFormat,
+                     IBuffer& indexBuffer,
+                     size_t indexBufferOffset,
+                     int32_t baseVertex) override;
+    void drawInstanced(PrimitiveType primitiveType,
+                       size_t vertexStart,
+                       size_t vertexCount,
+                       size_t instanceCount,
+                       size_t baseInstance) override;
+    void drawIndexedInstanced(PrimitiveType primitiveType,
+                              size_t indexCount,
+                              IndexFormat indexFormat,
+                              IBuffer& indexBuffer,
+                              size_t indexBufferOffset,
+                              int32_t baseVertex,
+                              size_t instanceCount,
+                              size_t baseInstance) override;
+    void drawIndirect(PrimitiveType primitiveType,
+                      IBuffer& indirectBuffer,
+                      size_t indirectBufferOffset,
+                      uint32_t drawCount,
+                      uint32_t stride) override;
+    void drawIndexedIndirect(PrimitiveType primitiveType,
+                             IndexFormat indexFormat,
+                             IBuffer& indexBuffer,
+                             IBuffer& indirectBuffer,
+                             size_t indirectBufferOffset,
+                             uint32_t drawCount,
+                             uint32_t stride) override;
+    void bindViewport(const Viewport& viewport) override;
+    void bindScissor(const ScissorRect& scissor) override;
+    void bindDepthStencilState(const std::shared_ptr<IDepthStencilState>& depthStencilState) override;
+    void bindTexture(uint32_t index, uint8_t target, std::shared_ptr<ITexture> texture) override;
+    void bindSamplerState(uint32_t index, uint8_t target, std::shared_ptr<ISamplerState> samplerState) override;
+    void pushConstants(uint8_t target, uint32_t offset, const void* data, uint32_t size) override;
+    void memoryBarrier(uint32_t barriers) override;
+    void setDrawSortHint(const DrawSortHint& hint) override;
+
+    void begin(const CommandBufferDesc& desc);
+    // clears the recorded commands and releases every resource bound while recording
+    void reset();
+
+    [[nodiscard]] std::vector<Command>& getCommands()
+    {
+        return commands;
+    }
+
+private:
+    void record(Command&& command);
+    void retain(std::shared_ptr<void> resource);
+
+private:
+    bool commandLogEnabled;
+    bool isInRenderPass = false;
+
+    std::vector<Command> commands;
+    // keeps bound resources alive until the command buffer is submitted
+    std::vector<std::shared_ptr<void>> retainedResources;
+};
+
+}// namespace null
@@ -0,0 +1,148 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/ComputePipeline.h"
+#include "graphicsAPI/common/DepthStencilState.h"
+#include "graphicsAPI/common/GraphicsPipeline.h"
+#include "graphicsAPI/common/SamplerState.h"
+#include "graphicsAPI/common/ShaderModule.h"
+#include "graphicsAPI/common/ShaderStage.h"
+#include "graphicsAPI/common/VertexInputState.h"
+
+#include <memory>
+#include <utility>
+
+namespace null {
+
+// The null backend never compiles or links anything, its pipeline objects only keep their description around.
+
+class ShaderModule : public IShaderModule
+{
+public:
+    explicit ShaderModule(const ShaderModuleDesc& desc)
+        : IShaderModule(desc)
+    {}
+
+    [[nodiscard]] const ShaderModuleDesc& getDesc() const
+    {
+        return desc;
+    }
+};
+
+class PipelineShaderStages : public IPipelineShaderStages
+{
+public:
+    explicit PipelineShaderStages(PipelineShaderStagesDesc desc)
+        : desc(std::move(desc))
+    {}
+
+    [[nodiscard]] const std::shared_ptr<IShaderModule>& getVertexShader() const override
+    {
+        return desc.vertexModule;
+    }
+    [[nodiscard]] const std::shared_ptr<IShaderModule>& getFragmentShader() const override
+    {
+        return desc.fragmentModule;
+    }
+    [[nodiscard]] const std::shared_ptr<IShaderModule>& getGeometryShader() const override
+    {
+        return desc.geometryModule;
+    }
+    [[nodiscard]] const std::shared_ptr<IShaderModule>& getComputeShader() const override
+    {
+        return desc.computeModule;
+    }
+
+    [[nodiscard]] ShaderStagesType getType() const override
+    {
+        return desc.type;
+    }
+
+private:
+    PipelineShaderStagesDesc desc;
+};
+
+class GraphicsPipeline : public IGraphicsPipeline
+{
+public:
+    explicit GraphicsPipeline(GraphicsPipelineDesc desc)
+        : desc(std::move(desc))
+    {}
+
+    [[nodiscard]] const GraphicsPipelineDesc& getDesc() const override
+    {
+        return desc;
+    }
+
+private:
+    GraphicsPipelineDesc desc;
+};
+
+class ComputePipeline : public IComputePipeline
+{
+public:
+    explicit ComputePipeline(ComputePipelineDesc desc)
+        : desc(std::move(desc))
+    {}
+
+    [[nodiscard]] const ComputePipelineDesc& getDesc() const
+    {
+        return desc;
+    }
+
+private:
+    ComputePipelineDesc desc;
+};
+
+class VertexInputState : public IVertexInputState
+{
+public:
+    explicit VertexInputState(VertexInputStateDesc desc)
+        : desc(std::move(desc))
+    {}
+
+    [[nodiscard]] const VertexInputStateDesc& getDesc() const
+    {
+        return desc;
+    }
+
+private:
+    VertexInputStateDesc desc;
+};
+
+class DepthStencilState : public IDepthStencilState
+{
+public:
+    explicit DepthStencilState(const DepthStencilStateDesc& desc)
+        : desc(desc)
+    {}
+
+    [[nodiscard]] const DepthStencilStateDesc& getDesc() const
+    {
+        return desc;
+    }
+
+private:
+    DepthStencilStateDesc desc;
+};
+
+class SamplerState : public ISamplerState
+{
+public:
+    explicit SamplerState(const SamplerStateDesc& desc)
+        : desc(desc)
+    {}
+
+    [[nodiscard]] const SamplerStateDesc& getDesc() const
+    {
+        return desc;
+    }
+
+private:
+    SamplerStateDesc desc;
+};
+
+}// namespace null
@@ -0,0 +1,217 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "Texture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace null {
+
+Texture::Texture(const TextureDesc& desc_)
+    : desc(desc_)
+    , formatProperties(TextureFormatProperties::fromTextureFormat(desc_.format))
+{
+    static constexpr size_t one = 1;
+    for (size_t mipLevel = 0; mipLevel < desc.numMipLevels; ++mipLevel)
+    {
+        mipLevelOffsets.push_back(layerSize);
+        layerSize += formatProperties.getBytesPerLayer(std::max(desc.width >> mipLevel, one),
+                                                       std::max(desc.height >> mipLevel, one),
+                                                       std::max(desc.depth >> mipLevel, one));
+    }
+    const size_t faces = desc.type == TextureType::TextureCube ? 6 : 1;
+    storage.resize(layerSize * desc.numLayers * faces);
+}
+
+void Texture::upload(const void* data, const TextureRangeDesc& range, size_t bytesPerRow) const
+{
+    uploadToLayers(data, range, bytesPerRow, range.layer);
+}
+
+void Texture::uploadCube(const void* data, TextureCubeFace face, const TextureRangeDesc& range, size_t bytesPerRow) const
+{
+    if (desc.type != TextureType::TextureCube)
+    {
+        throw std::runtime_error("uploadCube called on a texture that is not a cube map");
+    }
+    uploadToLayers(data, range, bytesPerRow, range.layer * 6 + static_cast<size_t>(face));
+}
+
+std::future<void> Texture::uploadAsync(const void* data, const TextureRangeDesc& range, size_t bytesPerRow, std::function<void()> onComplete) const
+{
+    // there is no GPU to wait for, the upload completes right away
+    upload(data, range, bytesPerRow);
+    if (onComplete)
+    {
+        onComplete();
+    }
+    std::promise<void> promise;
+    promise.set_value();
+    return promise.get_future();
+}
+
+void Texture::uploadToLayers(const void* data, const TextureRangeDesc& range, size_t bytesPerRow, size_t firstLayer) const
+{
+    if (!data)
+    {
+        return;
+    }
+    if (!validateRange(range).first)
+    {
+        throw std::runtime_error("Invalid texture upload range");
+    }
+
+    const auto* source = static_cast<const std::byte*>(data);
+    for (size_t mip = range.mipLevel; mip < range.mipLevel + range.numMipLevels; ++mip)
+    {
+        const auto levelRange = range.atMipLevel(mip);
+        const auto levelWidth = std::max(desc.width >> mip, static_cast<size_t>(1));
+        const auto levelHeight = std::max(desc.height >> mip, static_cast<size_t>(1));
+
+        for (size_t layer = 0; layer < range.numLayers; ++layer)
+        {
+            std::byte* level = storage.data() + (firstLayer + layer) * layerSize + mipLevelOffsets[mip];
+
+            if (formatProperties.isCompressed())
+            {
+                // compressed data is uploaded one whole block-aligned range at a time
+                const size_t size = formatProperties.getBytesPerLayer(levelRange.width, levelRange.height, levelRange.depth);
+                std::memcpy(level, source, size);
+                source += size;
+                continue;
+            }
+
+            const size_t pixelSize = formatProperties.bytesPerBlock;
+            const size_t destinationPitch = levelWidth * pixelSize;
+            const size_t rowSize = levelRange.width * pixelSize;
+            const size_t sourcePitch = (bytesPerRow != 0 && mip == range.mipLevel) ? bytesPerRow : rowSize;
+            for (size_t z = 0; z < levelRange.depth; ++z)
+            {
+                for (size_t y = 0; y < levelRange.height; ++y)
+                {
+                    const size_t row = (levelRange.z + z) * levelHeight + levelRange.y + y;
+                    std::memcpy(level + row * destinationPitch + levelRange.x * pixelSize, source, rowSize);
+                    source += sourcePitch;
+                }
+            }
+        }
+    }
+}
+
+float Texture::getAspectRatio() const
+{
+    return static_cast<float>(getWidth()) / static_cast<float>(getHeight());
+}
+
+size_t Texture::getWidth() const
+{
+    return desc.width;
+}
+
+size_t Texture::getHeight() const
+{
+    return desc.height;
+}
+
+size_t Texture::getDepth() const
+{
+    return desc.depth;
+}
+
+size_t Texture::getNumLayers() const
+{
+    return desc.numLayers;
+}
+
+size_t Texture::getSamples() const
+{
+    return desc.numSamples;
+}
+
+size_t Texture::getNumMipLevels() const
+{
+    return desc.numMipLevels;
+}
+
+bool Texture::isRequiredGenerateMipmap() const
+{
+    return false;
+}
+
+void Texture::generateMipmap() const
+{
+}
+
+TextureFormatProperties Texture::getProperties() const
+{
+    return formatProperties;
+}
+
+size_t Texture::getUsage() const
+{
+    return desc.usage;
+}
+
+TextureType Texture::getType() const
+{
+    return desc.type;
+}
+
+TextureFormat Texture::getFormat() const
+{
+    return desc.format;
+}
+
+TextureRangeDesc Texture::getFullRange(size_t mipLevel, size_t numMipLevels) const
+{
+    static constexpr size_t one = 1;
+    auto range = TextureRangeDesc::new3D(0, 0, 0,
+                                         std::max(getWidth() >> mipLevel, one),
+                                         std::max(getHeight() >> mipLevel, one),
+                                         std::max(getDepth() >> mipLevel, one),
+                                         mipLevel);
+    range.numLayers = getNumLayers();
+    range.numMipLevels = numMipLevels;
+    return range;
+}
+
+std::pair<bool, bool> Texture::validateRange(const TextureRangeDesc& range) const
+{
+    static constexpr size_t one = 1;
+    const auto texWidth = std::max(getWidth() >> range.mipLevel, one);
+    const auto texHeight = std::max(getHeight() >> range.mipLevel, one);
+    const auto texDepth = std::max(getDepth() >> range.mipLevel, one);
+    const auto texLayers = getNumLayers();
+
+    if (range.width == 0 || range.height == 0 || range.depth == 0)
+    {
+        return {false, false};
+    }
+    if (range.x + range.width > texWidth || range.y + range.height > texHeight || range.z + range.depth > texDepth)
+    {
+        return {false, false};
+    }
+    if (range.numLayers == 0 || range.layer + range.numLayers > texLayers)
+    {
+        return {false, false};
+    }
+    if (range.numMipLevels == 0 || range.mipLevel + range.numMipLevels > getNumMipLevels())
+    {
+        return {false, false};
+    }
+
+    const bool fullRange = (range.x == 0 && range.y == 0 && range.z == 0 && range.layer == 0 &&
+                            range.width == texWidth && range.height == texHeight &&
+                            range.depth == texDepth && range.numLayers == texLayers);
+    return {true, fullRange};
+}
+
+const std::byte* Texture::getData(size_t mipLevel, size_t layer) const
+{
+    return storage.data() + layer * layerSize + mipLevelOffsets[mipLevel];
+}
+
+}// namespace null
@@ -0,0 +1,63 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/Texture.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace null {
+
+/**
+ * @brief Texture kept in CPU memory, every layer (or cube face) stores its whole mip chain tightly packed.
+ */
+class Texture : public ITexture
+{
+public:
+    explicit Texture(const TextureDesc& desc);
+
+    void upload(const void* data, const TextureRangeDesc& range, size_t bytesPerRow = 0) const override;
+    void uploadCube(const void* data, TextureCubeFace face, const TextureRangeDesc& range, size_t bytesPerRow) const override;
+    std::future<void> uploadAsync(const void* data, const TextureRangeDesc& range, size_t bytesPerRow, std::function<void()> onComplete) const override;
+
+    [[nodiscard]] float getAspectRatio() const override;
+    [[nodiscard]] size_t getWidth() const override;
+    [[nodiscard]] size_t getHeight() const override;
+    [[nodiscard]] size_t getDepth() const override;
+
+    [[nodiscard]] size_t getNumLayers() const override;
+    [[nodiscard]] size_t getSamples() const override;
+    [[nodiscard]] size_t getNumMipLevels() const override;
+    [[nodiscard]] bool isRequiredGenerateMipmap() const override;
+    void generateMipmap() const override;
+
+    [[nodiscard]] TextureFormatProperties getProperties() const override;
+    [[nodiscard]] size_t getUsage() const override;
+
+    [[nodiscard]] TextureType getType() const override;
+    [[nodiscard]] TextureFormat getFormat() const override;
+
+    [[nodiscard]] TextureRangeDesc getFullRange(size_t mipLevel, size_t numMipLevels) const override;
+    [[nodiscard]] std::pair<bool, bool> validateRange(const TextureRangeDesc& range) const override;
+
+    /**
+     * @brief Returns the texels of a mip level of a layer (or cube face), tightly packed.
+     */
+    [[nodiscard]] const std::byte* getData(size_t mipLevel, size_t layer = 0) const;
+
+private:
+    void uploadToLayers(const void* data, const TextureRangeDesc& range, size_t bytesPerRow, size_t firstLayer) const;
+
+private:
+    TextureDesc desc;
+    TextureFormatProperties formatProperties;
+
+    std::vector<size_t> mipLevelOffsets;
+    size_t layerSize = 0;
+    mutable std::vector<std::byte> storage;
+};
+
+}// namespace null
@@ -4,8 +4,32 @@
 
 #include "graphicsAPI/opengl/Buffer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
 namespace opengl {
 
+struct ArrayBuffer::Ring
+{
+    // bytes handed out during one frame, recycled once the fence inserted after the frame is signaled
+    struct Region
+    {
+        uint32_t size;
+        GLsync fence;
+    };
+
+    std::byte* memory = nullptr;
+    uint32_t alignment = 16;
+
+    // allocated bytes are the cyclic range [head - usedBytes, head)
+    uint32_t head = 0;
+    uint32_t usedBytes = 0;
+    uint32_t frameBytes = 0;
+    uint64_t frameIndex = 0;
+    std::deque<Region> regions;
+};
+
 ArrayBuffer::ArrayBuffer(Context& context)
     : Buffer(context), id_(0), isDynamic_(false), size_(0)
 {
@@ -13,6 +37,14 @@ ArrayBuffer::ArrayBuffer(Context& context)
 
 ArrayBuffer::~ArrayBuffer()
 {
+    if (ring_)
+    {
+        for (auto& region : ring_->regions)
+        {
+            getContext().deleteSync(region.fence);
+        }
+        ring_.reset();
+    }
     if (id_ != 0)
     {
         getContext().deleteBuffers(1, &id_);
@@ -40,6 +72,9 @@ void ArrayBuffer::initialize(const BufferDesc& desc)
             usage = GL_STATIC_DRAW;
             isDynamic_ = false;
             break;
+        case ResourceStorage::Ring:
+            isDynamic_ = true;
+            break;
         default:
             break;
     }
@@ -73,6 +108,11 @@ void ArrayBuffer::initialize(const BufferDesc& desc)
         target_ = GL_ELEMENT_ARRAY_BUFFER;
         type_ = Type::Index;
     }
+    else if (desc.type & BufferDesc::BufferTypeBits::Indirect)
+    {
+        target_ = GL_DRAW_INDIRECT_BUFFER;
+        type_ = Type::Indirect;
+    }
     else
     {
         throw std::runtime_error("Unknown buffer type");
@@ -81,6 +121,12 @@ void ArrayBuffer::initialize(const BufferDesc& desc)
     }
 
     size_ = desc.size;
+    if (desc.storage == ResourceStorage::Ring)
+    {
+        initializeRing(desc);
+        return;
+    }
+
     savePreviousBuffer();
     getContext().bindBuffer(getTarget(), id_);
     getContext().bufferData(getTarget(), size_, desc.data, usage);
@@ -88,6 +134,115 @@ void ArrayBuffer::initialize(const BufferDesc& desc)
     restorePreviousBuffer();
 }
 
+void ArrayBuffer::initializeRing(const BufferDesc& desc)
+{
+    if (size_ == 0)
+    {
+        throw std::runtime_error("Ring buffers must have a size at allocation time");
+    }
+
+    ring_ = std::make_unique<Ring>();
+    ring_->frameIndex = getContext().getFrameIndex();
+
+    GLint alignment = 0;
+    if (target_ == GL_UNIFORM_BUFFER)
+    {
+        getContext().getIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+    else if (target_ == GL_SHADER_STORAGE_BUFFER)
+    {
+        getContext().getIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+    ring_->alignment = std::max<uint32_t>(ring_->alignment, alignment);
+
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    savePreviousBuffer();
+    getContext().bindBuffer(getTarget(), id_);
+    getContext().bufferStorage(getTarget(), size_, desc.data, flags);
+    ring_->memory = static_cast<std::byte*>(getContext().mapBufferRange(getTarget(), 0, size_, flags));
+    restorePreviousBuffer();
+
+    if (!ring_->memory)
+    {
+        throw std::runtime_error("Failed to map ring buffer");
+    }
+}
+
+BufferAllocation ArrayBuffer::allocate(uint32_t size, uint32_t alignment) const
+{
+    if (auto allocation = tryAllocate(size, alignment))
+    {
+        return *allocation;
+    }
+    throw std::runtime_error("Ring buffer too small for the allocations of a single frame");
+}
+
+std::optional<BufferAllocation> ArrayBuffer::tryAllocate(uint32_t size, uint32_t alignment) const
+{
+    if (!ring_)
+    {
+        throw std::runtime_error("Only ResourceStorage::Ring buffers can be sub-allocated");
+    }
+    if (size == 0 || size > size_)
+    {
+        throw std::runtime_error("Ring buffer allocation size out of range");
+    }
+
+    auto& ring = *ring_;
+
+    // close the region of the previous frame, its memory comes back once the GPU is done with it
+    if (const uint64_t frameIndex = getContext().getFrameIndex(); frameIndex != ring.frameIndex)
+    {
+        if (ring.frameBytes > 0)
+        {
+            ring.regions.push_back({ring.frameBytes, getContext().fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+            ring.frameBytes = 0;
+        }
+        ring.frameIndex = frameIndex;
+    }
+
+    alignment = std::max(alignment, ring.alignment);
+    while (true)
+    {
+        uint32_t start = (ring.head + alignment - 1) / alignment * alignment;
+        if (static_cast<uint64_t>(start) + size > size_)
+        {
+            // does not fit before the end, skip the tail of the buffer
+            start = 0;
+        }
+        const uint32_t padding = start >= ring.head ? start - ring.head : size_ - ring.head;
+        const uint64_t required = static_cast<uint64_t>(padding) + size;
+
+        if (ring.usedBytes + required <= size_)
+        {
+            ring.head = (start + size) % size_;
+            ring.usedBytes += required;
+            ring.frameBytes += required;
+            return BufferAllocation{ring.memory + start, start, size};
+        }
+
+        if (ring.regions.empty())
+        {
+            return std::nullopt;
+        }
+
+        // wait for the oldest frame to complete and recycle its memory
+        auto& region = ring.regions.front();
+        GLenum result = GL_TIMEOUT_EXPIRED;
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = getContext().clientWaitSync(region.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+        if (result == GL_WAIT_FAILED)
+        {
+            std::cerr << "Failed to wait for ring buffer fence" << std::endl;
+        }
+        getContext().deleteSync(region.fence);
+        ring.usedBytes -= region.size;
+        ring.regions.pop_front();
+    }
+}
+
 void ArrayBuffer::data(const void* data, uint32_t size, uint32_t offset) const
 {
     if (!isDynamic_)
@@ -96,6 +251,13 @@ void ArrayBuffer::data(const void* data, uint32_t size, uint32_t offset) const
         throw std::runtime_error("Static buffers should not be written to, use ResourceStorage::Shared instead");
     }
 
+    if (ring_)
+    {
+        // persistently mapped, synchronizing with the GPU is up to the caller
+        std::memcpy(ring_->memory + offset, data, size);
+        return;
+    }
+
     savePreviousBuffer();
     getContext().bindBuffer(target_, id_);
     if ((offset == 0 && size == 0) || (size == size_ && offset == 0))
@@ -111,12 +273,20 @@ void ArrayBuffer::data(const void* data, uint32_t size, uint32_t offset) const
 
 void* ArrayBuffer::map(uint32_t size, uint32_t offset) const
 {
+    if (ring_)
+    {
+        return ring_->memory + offset;
+    }
     getContext().bindBuffer(getTarget(), id_);
     return getContext().mapBufferRange(getTarget(), offset, size, GL_MAP_WRITE_BIT);
 }
 
 void ArrayBuffer::unmap() const
 {
+    if (ring_)
+    {
+        return;
+    }
     getContext().bindBuffer(getTarget(), id_);
     getContext().unmapBuffer(getTarget());
     getContext().bindBuffer(getTarget(), 0);
@@ -0,0 +1,370 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "BufferHeap.h"
+
+#include <bit>
+#include <stdexcept>
+
+namespace opengl {
+
+TlsfAllocator::TlsfAllocator(uint32_t size)
+    : size(size)
+{
+    for (auto& lists : freeLists)
+    {
+        lists.fill(INVALID_BLOCK);
+    }
+    if (size > 0)
+    {
+        insertFreeBlock(createBlock(0, size));
+    }
+}
+
+void TlsfAllocator::mapping(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+{
+    if (size < SECOND_LEVEL_COUNT)
+    {
+        firstLevel = 0;
+        secondLevel = size;
+        return;
+    }
+    const uint32_t log2 = std::bit_width(size) - 1;
+    firstLevel = log2 - SECOND_LEVEL_LOG2 + 1;
+    secondLevel = (size >> (log2 - SECOND_LEVEL_LOG2)) ^ SECOND_LEVEL_COUNT;
+}
+
+uint32_t TlsfAllocator::createBlock(uint32_t offset, uint32_t size)
+{
+    uint32_t index;
+    if (!unusedBlocks.empty())
+    {
+        index = unusedBlocks.back();
+        unusedBlocks.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(blocks.size());
+        blocks.emplace_back();
+    }
+    blocks[index] = {.offset = offset, .size = size};
+    return index;
+}
+
+void TlsfAllocator::releaseBlock(uint32_t block)
+{
+    unusedBlocks.push_back(block);
+}
+
+uint32_t TlsfAllocator::findFreeBlock(uint32_t size) const
+{
+    // round up to the next size class so that any block of the class found is large enough
+    if (size >= SECOND_LEVEL_COUNT)
+    {
+        const uint64_t rounded = size + (1ull << (std::bit_width(size) - 1 - SECOND_LEVEL_LOG2)) - 1;
+        if (rounded > UINT32_MAX)
+        {
+            return INVALID_BLOCK;
+        }
+        size = static_cast<uint32_t>(rounded);
+    }
+    uint32_t firstLevel, secondLevel;
+    mapping(size, firstLevel, secondLevel);
+
+    uint32_t secondLevelMap = secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+    if (secondLevelMap == 0)
+    {
+        const uint32_t firstLevelMap = firstLevel + 1 < 32 ? firstLevelBitmap & (~0u << (firstLevel + 1)) : 0;
+        if (firstLevelMap == 0)
+        {
+            return INVALID_BLOCK;
+        }
+        firstLevel = std::countr_zero(firstLevelMap);
+        secondLevelMap = secondLevelBitmaps[firstLevel];
+    }
+    secondLevel = std::countr_zero(secondLevelMap);
+    return freeLists[firstLevel][secondLevel];
+}
+
+void TlsfAllocator::insertFreeBlock(uint32_t block)
+{
+    auto& entry = blocks[block];
+    uint32_t firstLevel, secondLevel;
+    mapping(entry.size, firstLevel, secondLevel);
+
+    auto& head = freeLists[firstLevel][secondLevel];
+    entry.free = true;
+    entry.prevFree = INVALID_BLOCK;
+    entry.nextFree = head;
+    if (head != INVALID_BLOCK)
+    {
+        blocks[head].prevFree = block;
+    }
+    head = block;
+    firstLevelBitmap |= 1u << firstLevel;
+    secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+}
+
+void TlsfAllocator::removeFreeBlock(uint32_t block)
+{
+    auto& entry = blocks[block];
+    uint32_t firstLevel, secondLevel;
+    mapping(entry.size, firstLevel, secondLevel);
+
+    if (entry.prevFree != INVALID_BLOCK)
+    {
+        blocks[entry.prevFree].nextFree = entry.nextFree;
+    }
+    else
+    {
+        freeLists[firstLevel][secondLevel] = entry.nextFree;
+        if (entry.nextFree == INVALID_BLOCK)
+        {
+            secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+            if (secondLevelBitmaps[firstLevel] == 0)
+            {
+                firstLevelBitmap &= ~(1u << firstLevel);
+            }
+        }
+    }
+    if (entry.nextFree != INVALID_BLOCK)
+    {
+        blocks[entry.nextFree].prevFree = entry.prevFree;
+    }
+    entry.free = false;
+    entry.prevFree = INVALID_BLOCK;
+    entry.nextFree = INVALID_BLOCK;
+}
+
+void TlsfAllocator::splitTail(uint32_t block, uint32_t size)
+{
+    const uint32_t remainder = blocks[block].size - size;
+    if (remainder < MIN_BLOCK_SIZE)
+    {
+        return;
+    }
+    const uint32_t tail = createBlock(blocks[block].offset + size, remainder);
+    auto& entry = blocks[block];
+    entry.size = size;
+    blocks[tail].prevPhysical = block;
+    blocks[tail].nextPhysical = entry.nextPhysical;
+    if (entry.nextPhysical != INVALID_BLOCK)
+    {
+        blocks[entry.nextPhysical].prevPhysical = tail;
+    }
+    entry.nextPhysical = tail;
+    // the physical successor of an allocated block is never free, so the tail has nothing to merge with
+    insertFreeBlock(tail);
+}
+
+std::optional<TlsfAllocator::Allocation> TlsfAllocator::allocate(uint32_t size, uint32_t alignment)
+{
+    if (size == 0)
+    {
+        return std::nullopt;
+    }
+    alignment = std::max(alignment, 1u);
+    const uint64_t searchSize = static_cast<uint64_t>(size) + alignment - 1;
+    if (searchSize > this->size)
+    {
+        return std::nullopt;
+    }
+
+    const uint32_t block = findFreeBlock(static_cast<uint32_t>(searchSize));
+    if (block == INVALID_BLOCK)
+    {
+        return std::nullopt;
+    }
+    removeFreeBlock(block);
+
+    // give the bytes in front of the aligned offset back to the free lists
+    const uint32_t offset = blocks[block].offset;
+    const uint32_t padding = (alignment - offset % alignment) % alignment;
+    if (padding > 0)
+    {
+        const uint32_t front = createBlock(offset, padding);
+        auto& entry = blocks[block];
+        blocks[front].prevPhysical = entry.prevPhysical;
+        blocks[front].nextPhysical = block;
+        if (entry.prevPhysical != INVALID_BLOCK)
+        {
+            blocks[entry.prevPhysical].nextPhysical = front;
+        }
+        entry.prevPhysical = front;
+        entry.offset += padding;
+        entry.size -= padding;
+        insertFreeBlock(front);
+    }
+    splitTail(block, size);
+
+    usedBytes += blocks[block].size;
+    return Allocation{blocks[block].offset, size, block};
+}
+
+void TlsfAllocator::free(const Allocation& allocation)
+{
+    uint32_t block = allocation.block;
+    if (block >= blocks.size() || blocks[block].free)
+    {
+        throw std::runtime_error("Invalid or already released heap allocation");
+    }
+    usedBytes -= blocks[block].size;
+
+    // merge with the free physical neighbours
+    if (const uint32_t prev = blocks[block].prevPhysical; prev != INVALID_BLOCK && blocks[prev].free)
+    {
+        removeFreeBlock(prev);
+        blocks[prev].size += blocks[block].size;
+        blocks[prev].nextPhysical = blocks[block].nextPhysical;
+        if (blocks[block].nextPhysical != INVALID_BLOCK)
+        {
+            blocks[blocks[block].nextPhysical].prevPhysical = prev;
+        }
+        releaseBlock(block);
+        block = prev;
+    }
+    if (const uint32_t next = blocks[block].nextPhysical; next != INVALID_BLOCK && blocks[next].free)
+    {
+        removeFreeBlock(next);
+        blocks[block].size += blocks[next].size;
+        blocks[block].nextPhysical = blocks[next].nextPhysical;
+        if (blocks[next].nextPhysical != INVALID_BLOCK)
+        {
+            blocks[blocks[next].nextPhysical].prevPhysical = block;
+        }
+        releaseBlock(next);
+    }
+    insertFreeBlock(block);
+}
+
+BufferHeap::BufferHeap(Context& context, BufferDesc::BufferType type, uint32_t pageSize)
+    : context(context), type(type), pageSize(pageSize)
+{
+}
+
+BufferHeap::Allocation BufferHeap::allocate(uint32_t size, uint32_t alignment)
+{
+    for (uint32_t i = 0; i < pages.size(); ++i)
+    {
+        if (!pages[i])
+        {
+            continue;
+        }
+        if (auto range = pages[i]->allocator.allocate(size, alignment))
+        {
+            return {pages[i]->buffer, i, *range};
+        }
+    }
+
+    // allocations larger than a page get a page of their own
+    const uint64_t requiredSize = static_cast<uint64_t>(size) + alignment;
+    if (requiredSize > UINT32_MAX)
+    {
+        throw std::runtime_error("Buffer heap allocation too large");
+    }
+    const uint32_t newPageSize = std::max(pageSize, static_cast<uint32_t>(requiredSize));
+
+    auto buffer = std::make_shared<ArrayBuffer>(context);
+    buffer->initialize(BufferDesc{
+            .type = type,
+            .data = nullptr,
+            .size = newPageSize,
+            .storage = ResourceStorage::Shared});
+    auto page = std::make_unique<Page>(Page{std::move(buffer), TlsfAllocator(newPageSize)});
+
+    uint32_t index = 0;
+    while (index < pages.size() && pages[index])
+    {
+        ++index;
+    }
+    if (index == pages.size())
+    {
+        pages.emplace_back();
+    }
+    pages[index] = std::move(page);
+
+    auto range = pages[index]->allocator.allocate(size, alignment);
+    if (!range)
+    {
+        throw std::runtime_error("Failed to allocate from a new buffer heap page");
+    }
+    return {pages[index]->buffer, index, *range};
+}
+
+void BufferHeap::free(const Allocation& allocation)
+{
+    auto& page = pages.at(allocation.page);
+    page->allocator.free(allocation.range);
+    // keep the first page around, later pages are only needed for peaks
+    if (allocation.page > 0 && page->allocator.getUsedBytes() == 0)
+    {
+        page.reset();
+    }
+}
+
+BufferView::BufferView(Context& context, std::shared_ptr<BufferHeap> heap, BufferHeap::Allocation allocation)
+    : Buffer(context), heap(std::move(heap)), allocation(std::move(allocation))
+{
+}
+
+BufferView::~BufferView()
+{
+    heap->free(allocation);
+}
+
+void BufferView::initialize(const BufferDesc& desc)
+{
+    isDynamic = desc.storage == ResourceStorage::Shared;
+    if (!isDynamic && desc.data == nullptr)
+    {
+        throw std::runtime_error("Static buffers must have data at allocation time, use ResourceStorage::Shared instead");
+    }
+    if (desc.data != nullptr)
+    {
+        allocation.buffer->data(desc.data, desc.size, allocation.range.offset);
+    }
+}
+
+void BufferView::data(const void* data, uint32_t size, uint32_t offset) const
+{
+    if (!isDynamic)
+    {
+        throw std::runtime_error("Static buffers should not be written to, use ResourceStorage::Shared instead");
+    }
+    if (size == 0 && offset == 0)
+    {
+        size = allocation.range.size;
+    }
+    if (static_cast<uint64_t>(offset) + size > allocation.range.size)
+    {
+        throw std::runtime_error("Buffer write out of range");
+    }
+    allocation.buffer->data(data, size, allocation.range.offset + offset);
+}
+
+void* BufferView::map(uint32_t size, uint32_t offset) const
+{
+    if (static_cast<uint64_t>(offset) + size > allocation.range.size)
+    {
+        throw std::runtime_error("Buffer map out of range");
+    }
+    return allocation.buffer->map(size, allocation.range.offset + offset);
+}
+
+void BufferView::unmap() const
+{
+    allocation.buffer->unmap();
+}
+
+BufferAllocation BufferView::allocate(uint32_t /*size*/, uint32_t /*alignment*/) const
+{
+    throw std::runtime_error("Only ResourceStorage::Ring buffers can be sub-allocated");
+}
+
+std::optional<BufferAllocation> BufferView::tryAllocate(uint32_t /*size*/, uint32_t /*alignment*/) const
+{
+    throw std::runtime_error("Only ResourceStorage::Ring buffers can be sub-allocated");
+}
+
+}// namespace opengl
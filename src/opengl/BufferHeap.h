@@ -0,0 +1,150 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/opengl/Buffer.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace opengl {
+
+/**
+ * @brief Two-level segregated fit allocator handing out byte ranges of a fixed size arena.
+ *
+ * Free ranges are kept in size classes (power of two first level, 8 linear second level subdivisions), allocation
+ * and release are O(1). Released ranges are merged with their free neighbours.
+ */
+class TlsfAllocator
+{
+public:
+    static constexpr uint32_t INVALID_BLOCK = ~0u;
+
+    struct Allocation
+    {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        uint32_t block = INVALID_BLOCK;
+    };
+
+    explicit TlsfAllocator(uint32_t size);
+
+    /**
+     * @brief Allocates size bytes at an offset that is a multiple of alignment (not necessarily a power of two).
+     */
+    [[nodiscard]] std::optional<Allocation> allocate(uint32_t size, uint32_t alignment);
+    void free(const Allocation& allocation);
+
+    [[nodiscard]] uint32_t getSize() const { return size; }
+    [[nodiscard]] uint32_t getUsedBytes() const { return usedBytes; }
+
+private:
+    static constexpr uint32_t SECOND_LEVEL_LOG2 = 3;
+    static constexpr uint32_t SECOND_LEVEL_COUNT = 1u << SECOND_LEVEL_LOG2;
+    static constexpr uint32_t FIRST_LEVEL_COUNT = 32 - SECOND_LEVEL_LOG2 + 1;
+    // remainders smaller than this stay attached to the allocated block
+    static constexpr uint32_t MIN_BLOCK_SIZE = 16;
+
+    struct Block
+    {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        uint32_t prevPhysical = INVALID_BLOCK;
+        uint32_t nextPhysical = INVALID_BLOCK;
+        uint32_t prevFree = INVALID_BLOCK;
+        uint32_t nextFree = INVALID_BLOCK;
+        bool free = false;
+    };
+
+    static void mapping(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+    uint32_t createBlock(uint32_t offset, uint32_t size);
+    void releaseBlock(uint32_t block);
+    uint32_t findFreeBlock(uint32_t size) const;
+    void insertFreeBlock(uint32_t block);
+    void removeFreeBlock(uint32_t block);
+    // splits the tail of block after size bytes into a new free block
+    void splitTail(uint32_t block, uint32_t size);
+
+private:
+    uint32_t size;
+    uint32_t usedBytes = 0;
+
+    std::vector<Block> blocks;
+    std::vector<uint32_t> unusedBlocks;
+
+    uint32_t firstLevelBitmap = 0;
+    std::array<uint32_t, FIRST_LEVEL_COUNT> secondLevelBitmaps = {};
+    std::array<std::array<uint32_t, SECOND_LEVEL_COUNT>, FIRST_LEVEL_COUNT> freeLists;
+};
+
+/**
+ * @brief Carves the ranges of sub-allocated buffers out of a few large GL buffers of one buffer type.
+ */
+class BufferHeap
+{
+public:
+    static constexpr uint32_t DEFAULT_PAGE_SIZE = 32 * 1024 * 1024;
+
+    struct Allocation
+    {
+        std::shared_ptr<ArrayBuffer> buffer;
+        uint32_t page = 0;
+        TlsfAllocator::Allocation range;
+    };
+
+    BufferHeap(Context& context, BufferDesc::BufferType type, uint32_t pageSize = DEFAULT_PAGE_SIZE);
+
+    [[nodiscard]] Allocation allocate(uint32_t size, uint32_t alignment);
+    void free(const Allocation& allocation);
+
+private:
+    struct Page
+    {
+        std::shared_ptr<ArrayBuffer> buffer;
+        TlsfAllocator allocator;
+    };
+
+    Context& context;
+    BufferDesc::BufferType type;
+    uint32_t pageSize;
+    // released pages leave a hole so that the page index of live allocations stays valid
+    std::vector<std::unique_ptr<Page>> pages;
+};
+
+/**
+ * @brief A buffer living in a range of a BufferHeap page, created by Device::createBuffer for BufferDesc::subAllocate.
+ */
+class BufferView : public Buffer
+{
+public:
+    BufferView(Context& context, std::shared_ptr<BufferHeap> heap, BufferHeap::Allocation allocation);
+    ~BufferView() override;
+
+    void initialize(const BufferDesc& desc) override;
+
+    void data(const void* data, uint32_t size, uint32_t offset) const override;
+    void* map(uint32_t size, uint32_t offset) const override;
+    void unmap() const override;
+    [[nodiscard]] BufferAllocation allocate(uint32_t size, uint32_t alignment = 0) const override;
+    [[nodiscard]] std::optional<BufferAllocation> tryAllocate(uint32_t size, uint32_t alignment = 0) const override;
+
+    [[nodiscard]] size_t getSize() const override { return allocation.range.size; }
+    [[nodiscard]] Type getType() const noexcept override { return allocation.buffer->getType(); }
+
+    [[nodiscard]] const ArrayBuffer& getStorageBuffer() const noexcept override { return *allocation.buffer; }
+    [[nodiscard]] uint32_t getStorageOffset() const noexcept override { return allocation.range.offset; }
+    [[nodiscard]] bool isSubAllocated() const noexcept override { return true; }
+
+private:
+    std::shared_ptr<BufferHeap> heap;
+    BufferHeap::Allocation allocation;
+    bool isDynamic = false;
+};
+
+}// namespace opengl
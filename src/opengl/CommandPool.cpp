@@ -14,8 +14,58 @@ opengl::CommandPool::CommandPool(const std::shared_ptr<Context>& context, const
     this->context = context;
 }
 
+opengl::CommandPool::CommandPool(const std::shared_ptr<Context>& context, const std::shared_ptr<CommandQueue>& commandQueue, const CommandPoolDesc& desc)
+{
+    this->context = context;
+    this->commandQueue = commandQueue;
+    recycleList = std::make_shared<CommandBufferList>();
+}
+
+opengl::CommandPool::~CommandPool()
+{
+    if (!commandQueue)
+    {
+        return;
+    }
+    // command buffers own GL objects, let the GL thread destroy them
+    for (auto& commandBuffer : freeGraphicsCommandBuffers)
+    {
+        commandQueue->retire(std::move(commandBuffer));
+    }
+    // closed so that the GL thread cannot recycle into the list once it has been emptied here
+    for (auto& commandBuffer : recycleList->close())
+    {
+        commandQueue->retire(std::move(commandBuffer));
+    }
+}
+
 std::unique_ptr<IGraphicsCommandBuffer> opengl::CommandPool::acquireGraphicsCommandBuffer(const CommandBufferDesc& desc)
 {
+    if (commandQueue)
+    {
+        for (auto& commandBuffer : recycleList->takeAll())
+        {
+            freeGraphicsCommandBuffers.push_back(std::move(commandBuffer));
+        }
+
+        std::unique_ptr<GraphicsCommandBuffer> commandBuffer;
+        if (freeGraphicsCommandBuffers.empty())
+        {
+            commandBuffer = std::make_unique<GraphicsCommandBuffer>(context);
+            commandBuffer->recycleList = recycleList;
+        }
+        else
+        {
+            commandBuffer = std::move(freeGraphicsCommandBuffers.back());
+            freeGraphicsCommandBuffers.pop_back();
+        }
+        CommandBufferDesc deferredDesc = desc;
+        deferredDesc.recordingMode = RecordingMode::Deferred;
+        commandBuffer->begin(deferredDesc);
+        ++activeCommandBufferCount;
+        return commandBuffer;
+    }
+
     auto& pool = context->getGraphicsCommandBufferPool();
 
     std::unique_ptr<IGraphicsCommandBuffer> commandBuffer;
@@ -28,6 +78,7 @@ std::unique_ptr<IGraphicsCommandBuffer> opengl::CommandPool::acquireGraphicsComm
         commandBuffer = std::move(pool[pool.size() - 1]);
         pool.pop_back();
     }
+    static_cast<GraphicsCommandBuffer&>(*commandBuffer).begin(desc);
     ++activeCommandBufferCount;
     return commandBuffer;
 
@@ -38,12 +89,28 @@ std::unique_ptr<IGraphicsCommandBuffer> opengl::CommandPool::acquireGraphicsComm
 
 void opengl::CommandPool::submitCommandBuffer(std::unique_ptr<IGraphicsCommandBuffer> commandBuffer)
 {
-    context->getGraphicsCommandBufferPool().push_back(std::move(commandBuffer));
     --activeCommandBufferCount;
+    if (commandQueue)
+    {
+        commandQueue->submit(std::unique_ptr<GraphicsCommandBuffer>(static_cast<GraphicsCommandBuffer*>(commandBuffer.release())));
+        return;
+    }
+
+    auto& glCommandBuffer = static_cast<GraphicsCommandBuffer&>(*commandBuffer);
+    if (glCommandBuffer.isDeferred())
+    {
+        glCommandBuffer.execute();
+    }
+    context->getGraphicsCommandBufferPool().push_back(std::move(commandBuffer));
 }
 
 std::unique_ptr<IComputeCommandBuffer> opengl::CommandPool::acquireComputeCommandBuffer(const CommandBufferDesc& desc)
 {
+    if (commandQueue)
+    {
+        throw std::runtime_error("Compute command buffers can only be acquired from an immediate command pool");
+    }
+
     auto& pool = context->getComputeCommandBufferPool();
 
     std::unique_ptr<IComputeCommandBuffer> commandBuffer;
@@ -56,6 +123,7 @@ std::unique_ptr<IComputeCommandBuffer> opengl::CommandPool::acquireComputeComman
         commandBuffer = std::move(pool[pool.size() - 1]);
         pool.pop_back();
     }
+    static_cast<ComputeCommandBuffer&>(*commandBuffer).setDesc(desc);
     ++activeCommandBufferCount;
     return commandBuffer;
 }
@@ -4,11 +4,15 @@
 
 #pragma once
 
+#include "CommandQueue.h"
 #include "graphicsAPI/common/CommandPool.h"
 #include "graphicsAPI/opengl/Context.h"
 
 #include "graphicsAPI/common/Common.h"
 
+#include <memory>
+#include <vector>
+
 
 namespace opengl {
 
@@ -16,6 +20,9 @@ class CommandPool : public ICommandPool
 {
 public:
     explicit CommandPool(const std::shared_ptr<Context>& context, const CommandPoolDesc& desc);
+    // a deferred pool, owned by one recording thread, that submits to the given queue
+    CommandPool(const std::shared_ptr<Context>& context, const std::shared_ptr<CommandQueue>& commandQueue, const CommandPoolDesc& desc);
+    ~CommandPool() override;
 
     std::unique_ptr<IGraphicsCommandBuffer> acquireGraphicsCommandBuffer(const CommandBufferDesc& desc) override;
     void submitCommandBuffer(std::unique_ptr<IGraphicsCommandBuffer> commandBuffer) override;
@@ -23,9 +30,19 @@ public:
     std::unique_ptr<IComputeCommandBuffer> acquireComputeCommandBuffer(const CommandBufferDesc& desc) override;
     void submitCommandBuffer(std::unique_ptr<IComputeCommandBuffer> commandBuffer) override;
 
+    [[nodiscard]] bool hasComputeCommandBuffers() const override
+    {
+        return commandQueue == nullptr;
+    }
+
 private:
     std::shared_ptr<Context> context;
 
+    // only used by deferred pools, command buffers come back through recycleList once executed
+    std::shared_ptr<CommandQueue> commandQueue;
+    std::shared_ptr<CommandBufferList> recycleList;
+    std::vector<std::unique_ptr<GraphicsCommandBuffer>> freeGraphicsCommandBuffers;
+
     uint32_t activeCommandBufferCount = 0;
 };
 
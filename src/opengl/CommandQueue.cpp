@@ -0,0 +1,96 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "CommandQueue.h"
+
+#include "GraphicsCommandBuffer.h"
+
+#include <algorithm>
+
+namespace opengl {
+
+CommandBufferList::~CommandBufferList()
+{
+    takeAll();
+}
+
+std::unique_ptr<GraphicsCommandBuffer> CommandBufferList::push(std::unique_ptr<GraphicsCommandBuffer> commandBuffer)
+{
+    GraphicsCommandBuffer* node = commandBuffer.get();
+    node->nextInList = head.load(std::memory_order_relaxed);
+    do
+    {
+        if (node->nextInList == closedMarker())
+        {
+            node->nextInList = nullptr;
+            return commandBuffer;
+        }
+    } while (!head.compare_exchange_weak(node->nextInList, node, std::memory_order_release, std::memory_order_relaxed));
+    commandBuffer.release();
+    return nullptr;
+}
+
+std::vector<std::unique_ptr<GraphicsCommandBuffer>> CommandBufferList::takeAll()
+{
+    return take(nullptr);
+}
+
+std::vector<std::unique_ptr<GraphicsCommandBuffer>> CommandBufferList::close()
+{
+    return take(closedMarker());
+}
+
+std::vector<std::unique_ptr<GraphicsCommandBuffer>> CommandBufferList::take(GraphicsCommandBuffer* replacement)
+{
+    std::vector<std::unique_ptr<GraphicsCommandBuffer>> commandBuffers;
+    GraphicsCommandBuffer* node = head.load(std::memory_order_relaxed);
+    do
+    {
+        if (node == closedMarker())
+        {
+            // nothing can be pushed after close()
+            return commandBuffers;
+        }
+    } while (!head.compare_exchange_weak(node, replacement, std::memory_order_acquire, std::memory_order_relaxed));
+    while (node)
+    {
+        GraphicsCommandBuffer* next = node->nextInList;
+        node->nextInList = nullptr;
+        commandBuffers.emplace_back(node);
+        node = next;
+    }
+    return commandBuffers;
+}
+
+void CommandQueue::submit(std::unique_ptr<GraphicsCommandBuffer> commandBuffer)
+{
+    const uint64_t sequence = submissionSequence.fetch_add(1, std::memory_order_relaxed);
+    commandBuffer->submissionKey = (static_cast<uint64_t>(commandBuffer->submissionOrder) << 32) | sequence;
+    submitted.push(std::move(commandBuffer));
+}
+
+void CommandQueue::retire(std::unique_ptr<GraphicsCommandBuffer> commandBuffer)
+{
+    retired.push(std::move(commandBuffer));
+}
+
+void CommandQueue::execute()
+{
+    retired.takeAll();
+
+    auto commandBuffers = submitted.takeAll();
+    std::ranges::sort(commandBuffers, {}, [](const auto& commandBuffer) { return commandBuffer->submissionKey; });
+
+    for (auto& commandBuffer : commandBuffers)
+    {
+        commandBuffer->execute();
+        if (auto recycleList = commandBuffer->recycleList.lock())
+        {
+            commandBuffer = recycleList->push(std::move(commandBuffer));
+        }
+        // if the pool is gone or being destroyed, the command buffer is destroyed here, on the GL thread
+    }
+}
+
+}// namespace opengl
@@ -0,0 +1,87 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace opengl {
+
+class GraphicsCommandBuffer;
+
+/**
+ * @brief Lock-free, intrusive list of owned command buffers.
+ *
+ * Any number of threads can push, taking the list is a single atomic exchange. The list owns the command buffers
+ * it holds and destroys whatever is left in it. A closed list rejects every push, so that nothing can be left in it
+ * for whichever thread happens to drop the last reference to it.
+ */
+class CommandBufferList
+{
+public:
+    CommandBufferList() = default;
+    ~CommandBufferList();
+    CommandBufferList(const CommandBufferList&) = delete;
+    CommandBufferList& operator=(const CommandBufferList&) = delete;
+
+    /**
+     * @brief Returns nullptr once the command buffer is in the list, or the command buffer itself if the list is closed.
+     */
+    std::unique_ptr<GraphicsCommandBuffer> push(std::unique_ptr<GraphicsCommandBuffer> commandBuffer);
+
+    /**
+     * @brief Takes every command buffer of the list, most recently pushed first.
+     */
+    std::vector<std::unique_ptr<GraphicsCommandBuffer>> takeAll();
+
+    /**
+     * @brief Takes every command buffer of the list and rejects the later pushes.
+     */
+    std::vector<std::unique_ptr<GraphicsCommandBuffer>> close();
+
+private:
+    std::vector<std::unique_ptr<GraphicsCommandBuffer>> take(GraphicsCommandBuffer* replacement);
+
+    // head of a closed list, never dereferenced
+    static GraphicsCommandBuffer* closedMarker()
+    {
+        return reinterpret_cast<GraphicsCommandBuffer*>(alignof(std::max_align_t));
+    }
+
+    std::atomic<GraphicsCommandBuffer*> head = nullptr;
+};
+
+/**
+ * @brief Hands deferred command buffers recorded on worker threads over to the GL thread.
+ *
+ * Submission is a lock-free push, execute() runs on the GL thread and replays everything submitted so far ordered
+ * by CommandBufferDesc::submissionOrder, then by submission sequence. Executed command buffers go back to the
+ * CommandPool that created them.
+ */
+class CommandQueue
+{
+public:
+    CommandQueue() = default;
+    ~CommandQueue() = default;
+
+    void submit(std::unique_ptr<GraphicsCommandBuffer> commandBuffer);
+
+    /**
+     * @brief Destroys a command buffer on the GL thread during the next execute().
+     */
+    void retire(std::unique_ptr<GraphicsCommandBuffer> commandBuffer);
+
+    void execute();
+
+private:
+    CommandBufferList submitted;
+    CommandBufferList retired;
+    std::atomic<uint32_t> submissionSequence = 0;
+};
+
+}// namespace opengl
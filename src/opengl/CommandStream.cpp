@@ -0,0 +1,58 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "CommandStream.h"
+
+#include <algorithm>
+
+namespace opengl {
+
+std::byte* CommandStream::allocate(size_t size)
+{
+    while (currentBlock < blocks.size())
+    {
+        auto& block = blocks[currentBlock];
+        if (block.used + size <= block.capacity)
+        {
+            std::byte* memory = block.data.get() + block.used;
+            block.used += size;
+            return memory;
+        }
+        if (block.used == 0)
+        {
+            // an empty block that is too small for this packet, replace it
+            break;
+        }
+        ++currentBlock;
+    }
+
+    Block block;
+    block.capacity = std::max(BLOCK_SIZE, size);
+    block.data = std::make_unique_for_overwrite<std::byte[]>(block.capacity);
+    block.used = size;
+    std::byte* memory = block.data.get();
+
+    if (currentBlock < blocks.size())
+    {
+        blocks[currentBlock] = std::move(block);
+    }
+    else
+    {
+        blocks.push_back(std::move(block));
+        currentBlock = blocks.size() - 1;
+    }
+    return memory;
+}
+
+void CommandStream::reset()
+{
+    for (auto& block : blocks)
+    {
+        block.used = 0;
+    }
+    currentBlock = 0;
+    packetCount = 0;
+}
+
+}// namespace opengl
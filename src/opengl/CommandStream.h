@@ -0,0 +1,118 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace opengl {
+
+/**
+ * @brief Linear, arena backed stream of POD command packets.
+ *
+ * Packets are copied into fixed size blocks that are kept around between resets, so once the stream has grown to
+ * the size of a typical frame recording does not allocate anymore. The stream never touches GL and can be written
+ * from any thread, as long as a single thread writes to it at a time.
+ */
+class CommandStream
+{
+public:
+    static constexpr size_t PACKET_ALIGNMENT = alignof(std::max_align_t);
+
+    struct PacketHeader
+    {
+        uint16_t type;
+        uint16_t payloadOffset;
+        uint32_t size; // size of the whole packet, header and padding included
+    };
+
+    CommandStream() = default;
+    CommandStream(const CommandStream&) = delete;
+    CommandStream& operator=(const CommandStream&) = delete;
+
+    template<typename T>
+    void write(const T& packet)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Command packets must be trivially copyable");
+        static_assert(std::is_trivially_destructible_v<T>, "Command packets must be trivially destructible");
+        static_assert(alignof(T) <= PACKET_ALIGNMENT, "Command packet is over aligned");
+
+        constexpr size_t payloadOffset = alignUp(sizeof(PacketHeader), alignof(T));
+        constexpr size_t packetSize = alignUp(payloadOffset + sizeof(T), PACKET_ALIGNMENT);
+
+        std::byte* memory = allocate(packetSize);
+        new (memory) PacketHeader{static_cast<uint16_t>(T::TYPE), static_cast<uint16_t>(payloadOffset), static_cast<uint32_t>(packetSize)};
+        new (memory + payloadOffset) T(packet);
+        ++packetCount;
+    }
+
+    /**
+     * @brief Calls fn(type, payload) for every packet, in recording order.
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        for (const auto& block : blocks)
+        {
+            size_t offset = 0;
+            while (offset < block.used)
+            {
+                const auto* header = std::launder(reinterpret_cast<const PacketHeader*>(block.data.get() + offset));
+                fn(header->type, block.data.get() + offset + header->payloadOffset);
+                offset += header->size;
+            }
+        }
+    }
+
+    template<typename T>
+    static const T& read(const std::byte* payload)
+    {
+        return *std::launder(reinterpret_cast<const T*>(payload));
+    }
+
+    /**
+     * @brief Drops every packet, the memory is kept for the next recording.
+     */
+    void reset();
+
+    [[nodiscard]] bool empty() const
+    {
+        return packetCount == 0;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return packetCount;
+    }
+
+private:
+    static constexpr size_t alignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    std::byte* allocate(size_t size);
+
+private:
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;
+        size_t capacity = 0;
+        size_t used = 0;
+    };
+
+    // blocks past currentBlock are empty and waiting to be reused
+    std::vector<Block> blocks;
+    size_t currentBlock = 0;
+    size_t packetCount = 0;
+};
+
+}// namespace opengl
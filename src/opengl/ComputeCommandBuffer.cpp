@@ -4,9 +4,38 @@
 
 #include "ComputeCommandBuffer.h"
 #include "ComputePipeline.h"
+#include "PushConstantStream.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace opengl {
 
+GLbitfield toGLBarrierBits(uint32_t barriers)
+{
+    static constexpr std::pair<BarrierBits, GLbitfield> bits[] = {
+            {Barrier_VertexBuffer, GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT},
+            {Barrier_IndexBuffer, GL_ELEMENT_ARRAY_BARRIER_BIT},
+            {Barrier_UniformBuffer, GL_UNIFORM_BARRIER_BIT},
+            {Barrier_TextureFetch, GL_TEXTURE_FETCH_BARRIER_BIT},
+            {Barrier_ShaderImage, GL_SHADER_IMAGE_ACCESS_BARRIER_BIT},
+            {Barrier_IndirectBuffer, GL_COMMAND_BARRIER_BIT},
+            {Barrier_BufferUpdate, GL_BUFFER_UPDATE_BARRIER_BIT},
+            {Barrier_Framebuffer, GL_FRAMEBUFFER_BARRIER_BIT},
+            {Barrier_ShaderStorage, GL_SHADER_STORAGE_BARRIER_BIT},
+            {Barrier_TextureUpdate, GL_TEXTURE_UPDATE_BARRIER_BIT},
+    };
+    GLbitfield glBarriers = 0;
+    for (const auto& [barrier, glBarrier] : bits)
+    {
+        if ((barriers & barrier) != 0)
+        {
+            glBarriers |= glBarrier;
+        }
+    }
+    return glBarriers;
+}
+
 ComputeCommandBuffer::ComputeCommandBuffer(const std::shared_ptr<Context>& context_)
     : context(context_)
 {
@@ -35,6 +64,8 @@ void ComputeCommandBuffer::end()
     imagesCache = {};
     textureStates = {};
     buffersCache = {};
+    pushConstantData = {};
+    pushConstantSize = 0;
 
     dirtyBufferUnits.reset();
     dirtyImageUnits.reset();
@@ -43,6 +74,7 @@ void ComputeCommandBuffer::end()
     dirtyFlags = DirtyFlag::DirtyBits_None;
 
     uniformBinder.clearDirtyBufferCache();
+    storageBinder.clearDirtyBufferCache();
 
     isRecording = false;
 }
@@ -56,6 +88,14 @@ void ComputeCommandBuffer::bindComputePipeline(const std::shared_ptr<IComputePip
 
     activeComputePipeline = pipeline;
     setDirty(DirtyFlag::DirtyBits_ComputePipeline);
+    // the binding point of each buffer unit belongs to the pipeline
+    for (size_t i = 0; i < MAX_VERTEX_BUFFERS; ++i)
+    {
+        if (buffersCache[i].buffer)
+        {
+            dirtyBufferUnits.set(i);
+        }
+    }
 }
 
 void ComputeCommandBuffer::dispatch(const ThreadGroupDimensions& dimensions)
@@ -74,11 +114,28 @@ void ComputeCommandBuffer::dispatch(const ThreadGroupDimensions& dimensions)
         if (dirtyBufferUnits.test(i))
         {
             auto& bufferState = buffersCache[i];
-            computePipeline->bindBuffer(i, bufferState.buffer.get());
+            const GLint binding = computePipeline->getBufferBinding(i);
+            if (binding >= 0 && bufferState.buffer)
+            {
+                auto& binder = bufferState.buffer->getStorageBuffer().getTarget() == GL_SHADER_STORAGE_BUFFER ? storageBinder : uniformBinder;
+                binder.setBuffer(binding, bufferState.buffer.get(), static_cast<uint32_t>(bufferState.offset));
+            }
+            else
+            {
+                std::cerr << "Warning: No buffer found for unit: " << i << std::endl;
+            }
             dirtyBufferUnits.reset(i);
         }
     }
 
+    if (isDirty(DirtyFlag::DirtyBits_PushConstants))
+    {
+        // streamed once per dispatch that follows a change, dispatches in between share the range
+        const auto range = context->getPushConstantStream().write(pushConstantData.data(), pushConstantSize);
+        uniformBinder.setBuffer(PUSH_CONSTANTS_BINDING, range.buffer.get(), range.offset, range.size);
+        clearDirty(DirtyFlag::DirtyBits_PushConstants);
+    }
+
     if (isDirty(DirtyFlag::DirtyBits_ComputePipeline))
     {
         computePipeline->bind();
@@ -86,6 +143,7 @@ void ComputeCommandBuffer::dispatch(const ThreadGroupDimensions& dimensions)
     }
 
     uniformBinder.bindBuffers(*context);
+    storageBinder.bindBuffers(*context);
 
     for (size_t i = 0; i < MAX_TEXTURE_SAMPLERS; ++i)
     {
@@ -97,38 +155,45 @@ void ComputeCommandBuffer::dispatch(const ThreadGroupDimensions& dimensions)
         }
     }
 
-    for (size_t i = 0; i < MAX_TEXTURE_SAMPLERS; ++i)
+    // the dirty range of texture units is flushed with one call for the textures and one for the samplers
+    if (dirtyTextureUnits.any())
     {
-        if (dirtyTextureUnits.test(i))
+        size_t first = 0;
+        while (!dirtyTextureUnits[first])
+        {
+            ++first;
+        }
+        size_t last = MAX_TEXTURE_SAMPLERS - 1;
+        while (!dirtyTextureUnits[last])
         {
-            auto& texture = textureStates[i];
+            --last;
+        }
 
-            if (texture.texture)
-            {
-                GLint loc = computePipeline->getTextureUnitLocation(i);
-                if (loc >= 0)
-                {
-                    context->uniform1i(loc, static_cast<GLint>(i));
-                    context->activeTexture(GL_TEXTURE0 + i);
-
-                    texture.texture->bind();
-                    if (auto& sampler = texture.samplerState)
-                    {
-                        sampler->bind(texture.texture);
-                    }
-                }
-                else
-                {
-                    std::cerr << "Warning: No texture unit found for texture unit: " << i << std::endl;
-                }
-            }
-            dirtyTextureUnits.reset(i);
+        std::array<GLuint, MAX_TEXTURE_SAMPLERS> textures = {};
+        std::array<GLenum, MAX_TEXTURE_SAMPLERS> targets = {};
+        std::array<GLuint, MAX_TEXTURE_SAMPLERS> samplers = {};
+        for (size_t i = first; i <= last; ++i)
+        {
+            const auto& texture = textureStates[i];
+            const bool sampled = texture.texture && texture.texture->getBufferType() == Texture::BufferType::TextureBuffer;
+            textures[i - first] = sampled ? texture.texture->getHandle() : 0;
+            targets[i - first] = sampled ? texture.texture->getTarget() : GL_TEXTURE_2D;
+            samplers[i - first] = texture.samplerState ? texture.samplerState->getId() : 0;
         }
+        const auto count = static_cast<GLsizei>(last - first + 1);
+        context->bindTextures(static_cast<GLuint>(first), count, textures.data(), targets.data());
+        context->bindSamplers(static_cast<GLuint>(first), count, samplers.data());
+        dirtyTextureUnits.reset();
     }
 
     // dispatch compute
     context->dispatchCompute(dimensions.x, dimensions.y, dimensions.z);
 
+    if (!automaticMemoryBarriers)
+    {
+        return;
+    }
+
     // memory barrier
     context->memoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 
@@ -211,6 +276,30 @@ void ComputeCommandBuffer::bindSamplerState(size_t index, std::shared_ptr<ISampl
     dirtyTextureUnits.set(index);
 }
 
+void ComputeCommandBuffer::pushConstants(uint32_t offset, const void* data, uint32_t size)
+{
+    if (static_cast<uint64_t>(offset) + size > MAX_PUSH_CONSTANTS_SIZE)
+    {
+        throw std::runtime_error("Push constants out of range");
+    }
+    std::memcpy(pushConstantData.data() + offset, data, size);
+    pushConstantSize = std::max(pushConstantSize, (offset + size + 15) / 16 * 16);
+    setDirty(DirtyFlag::DirtyBits_PushConstants);
+}
+
+void ComputeCommandBuffer::memoryBarrier(uint32_t barriers)
+{
+    if (const GLbitfield glBarriers = toGLBarrierBits(barriers); glBarriers != 0)
+    {
+        context->memoryBarrier(glBarriers);
+    }
+}
+
+void ComputeCommandBuffer::setDesc(const CommandBufferDesc& desc)
+{
+    automaticMemoryBarriers = desc.automaticMemoryBarriers;
+}
+
 bool ComputeCommandBuffer::isDirty(DirtyFlag flag) const
 {
     return dirtyFlags & flag;
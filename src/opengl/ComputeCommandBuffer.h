@@ -5,6 +5,7 @@
 #pragma once
 
 #include "graphicsAPI/common/ComputeCommandBuffer.h"
+#include "graphicsAPI/common/GraphicsCommandBuffer.h"
 #include "graphicsAPI/opengl/Context.h"
 
 #include "Texture.h"
@@ -17,12 +18,18 @@
 
 namespace opengl {
 
+/**
+ * @brief Converts BarrierBits to the bits of glMemoryBarrier.
+ */
+[[nodiscard]] GLbitfield toGLBarrierBits(uint32_t barriers);
+
 class ComputeCommandBuffer : public IComputeCommandBuffer
 {
     enum DirtyFlag : uint32_t
     {
         DirtyBits_None = 0,
         DirtyBits_ComputePipeline = 1 << 1,
+        DirtyBits_PushConstants = 1 << 2,
     };
 
     struct TextureState
@@ -64,6 +71,13 @@ public:
     void bindImage(size_t index, std::shared_ptr<ITexture> texture, uint8_t accessFlags, uint32_t mipLevel, uint32_t layer) override;
     void bindTexture(size_t index, std::shared_ptr<ITexture> texture) override;
     void bindSamplerState(size_t index, std::shared_ptr<ISamplerState> samplerState) override;
+    void pushConstants(uint32_t offset, const void* data, uint32_t size) override;
+    void memoryBarrier(uint32_t barriers) override;
+
+    /**
+     * @brief Applies the options of the command buffer description, called by the command pool on acquire.
+     */
+    void setDesc(const CommandBufferDesc& desc);
 
 private:
 
@@ -79,16 +93,21 @@ private:
     ImageStates imagesCache;
     TextureStates textureStates;
     BufferStates buffersCache;
+    std::array<std::byte, MAX_PUSH_CONSTANTS_SIZE> pushConstantData = {};
+    // bytes written since begin(), rounded up to a vec4, only these are streamed
+    uint32_t pushConstantSize = 0;
 
     std::shared_ptr<IComputePipeline> activeComputePipeline;
 
     UniformBinder uniformBinder;
+    UniformBinder storageBinder{GL_SHADER_STORAGE_BUFFER};
 
     uint32_t dirtyFlags = DirtyFlag::DirtyBits_None;
 
     std::shared_ptr<Context> context;
 
     bool isRecording = false;
+    bool automaticMemoryBarriers = true;
 };
 
 }
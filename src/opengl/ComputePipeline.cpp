@@ -6,6 +6,8 @@
 #include "Texture.h"
 #include "graphicsAPI/opengl/Buffer.h"
 
+#include <algorithm>
+
 namespace opengl {
 
 ComputePipeline::ComputePipeline(Context& context, const ComputePipelineDesc& desc)
@@ -29,8 +31,10 @@ void ComputePipeline::initialize(const ComputePipelineDesc& desc)
     }
 
     auto glShaderStages = std::static_pointer_cast<PipelineShaderStages>(desc.shaderStages);
+    // compute pipelines are set up right away, so they wait for stages created with linkAsync
+    glShaderStages->waitUntilLinked();
     shaderStages = glShaderStages;
-    reflection = std::make_shared<ComputePipelineReflection>(getContext(), *glShaderStages);
+    reflection = glShaderStages->getReflection();
 
     for (const auto& [texUnit, texName]: desc.imagesMap)
     {
@@ -54,28 +58,30 @@ void ComputePipeline::initialize(const ComputePipelineDesc& desc)
         }
     }
 
+    samplerUnits.clear();
     for (const auto& [texUnit, texName]: desc.texturesMap)
     {
         GLint loc = reflection->getLocation(texName);
-        if (loc >= 0)
+        if (loc >= 0 && texUnit < MAX_TEXTURE_SAMPLERS)
         {
-            GLint unit = 0;
-            getContext().getUniformiv(shaderStages->getProgram(), loc, &unit);
-            if (unit >= 0)
-            {
-                textureUnitMap[texUnit] = loc;
-            }
-            else
-            {
-                std::cerr << "Texture uniform unit (" << texName << ") not found in shader" << std::endl;
-            }
+            samplerUnits.emplace_back(loc, static_cast<GLint>(texUnit));
         }
         else
         {
             std::cerr << "Texture uniform (" << texName << ") not found in shader" << std::endl;
         }
     }
+    // the map is unordered, sort so that equal mappings hash the same
+    std::ranges::sort(samplerUnits);
+    samplerUnitsHash = 0;
+    for (const auto& [location, unit] : samplerUnits)
+    {
+        hash_combine(samplerUnitsHash, location);
+        hash_combine(samplerUnitsHash, unit);
+    }
+    shaderStages->setSamplerUnits(samplerUnitsHash, samplerUnits);
 
+    bufferUnitMap.fill(-1);
     for (const auto& [bufferUnit, bufferName]: desc.buffersMap)
     {
         GLint loc = reflection->getLocation(bufferName);
@@ -122,6 +128,7 @@ void ComputePipeline::bind()
     if (shaderStages)
     {
         shaderStages->bind();
+        shaderStages->setSamplerUnits(samplerUnitsHash, samplerUnits);
     }
 }
 
@@ -156,37 +163,13 @@ void ComputePipeline::bindImageUnit(size_t unit, Texture* texture, uint8_t acces
     }
 }
 
-GLint ComputePipeline::getTextureUnitLocation(size_t unit)
+GLint ComputePipeline::getBufferBinding(size_t unit) const
 {
-    if (unit >= MAX_TEXTURE_SAMPLERS)
+    if (!shaderStages || unit >= MAX_VERTEX_BUFFERS)
     {
         return -1;
     }
-
-    return textureUnitMap[unit];
-}
-
-void ComputePipeline::bindBuffer(size_t unit, Buffer* buffer)
-{
-    if (!shaderStages)
-    {
-        return;
-    }
-
-    if (unit >= MAX_VERTEX_BUFFERS)
-    {
-        return;
-    }
-
-    GLint bufferLocation = bufferUnitMap[unit];
-    if (bufferLocation >= 0)
-    {
-        static_cast<ArrayBuffer&>(*buffer).bindBase(bufferLocation);
-    }
-    else
-    {
-        std::cerr << "Warning: No buffer found for unit: " << unit << std::endl;
-    }
+    return bufferUnitMap[unit];
 }
 
 }// namespace opengl
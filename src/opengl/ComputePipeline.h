@@ -9,6 +9,8 @@
 #include "graphicsAPI/opengl/Context.h"
 
 #include <array>
+#include <utility>
+#include <vector>
 
 namespace opengl {
 
@@ -27,8 +29,8 @@ public:
     void unbind();
 
     void bindImageUnit(size_t unit, Texture* texture, uint8_t accessFlags, uint32_t mipLevel = 0, uint32_t layer = 0);
-    GLint getTextureUnitLocation(size_t unit);
-    void bindBuffer(size_t unit, Buffer* buffer);
+    // binding point of the buffer bound to unit, -1 if the shader does not use it
+    [[nodiscard]] GLint getBufferBinding(size_t unit) const;
 
     bool isUsingShaderStorageBuffers() const { return usingShaderStorageBuffers; }
 
@@ -40,7 +42,9 @@ private:
 
     std::array<GLint, MAX_VERTEX_BUFFERS> bufferUnitMap;
     std::array<GLint, MAX_TEXTURE_SAMPLERS> imageUnitMap;
-    std::array<GLint, MAX_TEXTURE_SAMPLERS> textureUnitMap;
+    // {location, texture unit} of the sampler uniforms, written to the program once instead of on every dispatch
+    std::vector<std::pair<GLint, GLint>> samplerUnits;
+    size_t samplerUnitsHash = 0;
 
     bool usingShaderStorageBuffers = false;
 };
@@ -3,58 +3,296 @@
 //
 
 #include "graphicsAPI/opengl/Context.h"
+#include "PushConstantStream.h"
+#include "TextureUploadQueue.h"
 
 #include <iostream>
 
-// Macro to print which line has an error
-#ifndef Debug
+// Wraps every GL call, the place to hook error checking when debugging
+#define glLog(x) x
+
+// Per-frame call accounting, compiles to nothing unless GRAPHICSAPI_CONTEXT_STATS is defined
+#ifdef GRAPHICSAPI_CONTEXT_STATS
+#   define glStatsCall(name) (++frameStats.calls[static_cast<size_t>(ContextCall::name)])
+#   define glStatsRedundantCall(name) (++frameStats.redundantCalls[static_cast<size_t>(ContextCall::name)])
+#   define glStatsBufferBytes(bytes) (frameStats.bufferUploadBytes += (bytes))
+#   define glStatsTextureBytes(bytes) (frameStats.textureUploadBytes += (bytes))
+#else
+#   define glStatsCall(name) ((void) 0)
+#   define glStatsRedundantCall(name) ((void) 0)
+#   define glStatsBufferBytes(bytes) ((void) 0)
+#   define glStatsTextureBytes(bytes) ((void) 0)
+#endif
+
+#ifdef GRAPHICSAPI_CONTEXT_STATS
+// Size in bytes of a tightly packed client pixel rectangle, ignores GL_UNPACK_* alignment and row length
+static uint64_t getPixelDataSize(GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth)
+{
+    uint64_t pixelSize = 0;
+    switch (type)
+    {
+    // packed types describe a whole pixel
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+        pixelSize = 2;
+        break;
+    case GL_UNSIGNED_INT_8_8_8_8:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_5_9_9_9_REV:
+    case GL_UNSIGNED_INT_24_8:
+        pixelSize = 4;
+        break;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+        pixelSize = 8;
+        break;
+    default:
+    {
+        uint64_t componentSize = 1;
+        switch (type)
+        {
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+            componentSize = 2;
+            break;
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_FLOAT:
+            componentSize = 4;
+            break;
+        default:
+            break;
+        }
+        uint64_t components = 4;
+        switch (format)
+        {
+        case GL_RED:
+        case GL_RED_INTEGER:
+        case GL_DEPTH_COMPONENT:
+        case GL_STENCIL_INDEX:
+            components = 1;
+            break;
+        case GL_RG:
+        case GL_RG_INTEGER:
+        case GL_DEPTH_STENCIL:
+            components = 2;
+            break;
+        case GL_RGB:
+        case GL_BGR:
+        case GL_RGB_INTEGER:
+            components = 3;
+            break;
+        default:
+            break;
+        }
+        pixelSize = components * componentSize;
+        break;
+    }
+    }
+    return pixelSize * static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * static_cast<uint64_t>(depth);
+}
+#endif
+
+namespace opengl {
 
-// X MACRO to define all of the OpenGL errors
-#define _LIST_OF_OPENGL_ERRORS           \
-        X(GL_NO_ERROR)                       \
-        X(GL_INVALID_VALUE)                  \
-        X(GL_INVALID_OPERATION)              \
-        X(GL_STACK_OVERFLOW)                 \
-        X(GL_STACK_UNDERFLOW)                \
-        X(GL_OUT_OF_MEMORY)                  \
-        X(GL_INVALID_FRAMEBUFFER_OPERATION)  \
-        X(GL_CONTEXT_LOST)                   \
-        X(GL_TABLE_TOO_LARGE)
+int Context::toCapIndex(GLenum cap)
+{
+    switch (cap)
+    {
+    case GL_BLEND:
+        return Cap_Blend;
+    case GL_CULL_FACE:
+        return Cap_CullFace;
+    case GL_DEPTH_TEST:
+        return Cap_DepthTest;
+    case GL_STENCIL_TEST:
+        return Cap_StencilTest;
+    case GL_SCISSOR_TEST:
+        return Cap_ScissorTest;
+    case GL_FRAMEBUFFER_SRGB:
+        return Cap_FramebufferSRGB;
+    case GL_POLYGON_OFFSET_FILL:
+        return Cap_PolygonOffsetFill;
+    case GL_RASTERIZER_DISCARD:
+        return Cap_RasterizerDiscard;
+    case GL_PRIMITIVE_RESTART_FIXED_INDEX:
+        return Cap_PrimitiveRestartFixedIndex;
+    case GL_MULTISAMPLE:
+        return Cap_Multisample;
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+        return Cap_SampleAlphaToCoverage;
+    case GL_DITHER:
+        return Cap_Dither;
+    case GL_PROGRAM_POINT_SIZE:
+        return Cap_ProgramPointSize;
+    case GL_TEXTURE_CUBE_MAP_SEAMLESS:
+        return Cap_TextureCubeMapSeamless;
+    default:
+        return -1;
+    }
+}
 
-// Returns a string of the X Macro Error
-static const char* _glStringError(const GLenum err)
+int Context::toBufferTargetIndex(GLenum target)
 {
-    switch (err)
+    switch (target)
     {
-#           define X(name) case name: return #name;
-        _LIST_OF_OPENGL_ERRORS
-#           undef X
+    case GL_ARRAY_BUFFER:
+        return BufferTarget_Array;
+    case GL_ELEMENT_ARRAY_BUFFER:
+        return BufferTarget_ElementArray;
+    case GL_UNIFORM_BUFFER:
+        return BufferTarget_Uniform;
+    case GL_SHADER_STORAGE_BUFFER:
+        return BufferTarget_ShaderStorage;
+    case GL_DRAW_INDIRECT_BUFFER:
+        return BufferTarget_DrawIndirect;
+    case GL_DISPATCH_INDIRECT_BUFFER:
+        return BufferTarget_DispatchIndirect;
+    case GL_PIXEL_PACK_BUFFER:
+        return BufferTarget_PixelPack;
+    case GL_PIXEL_UNPACK_BUFFER:
+        return BufferTarget_PixelUnpack;
+    case GL_COPY_READ_BUFFER:
+        return BufferTarget_CopyRead;
+    case GL_COPY_WRITE_BUFFER:
+        return BufferTarget_CopyWrite;
+    case GL_TEXTURE_BUFFER:
+        return BufferTarget_Texture;
+    default:
+        return -1;
     }
-    return "UNDEFINED";
 }
 
-// Fetching all of the errors and printing them
-static void _glPrintErrors(const char* func, const char* file, const int line)
+int Context::toTextureTargetIndex(GLenum target)
 {
-    GLenum err = glGetError();
-    while(err != GL_NO_ERROR)
+    switch (target)
+    {
+    case GL_TEXTURE_2D:
+        return TextureTarget_2D;
+    case GL_TEXTURE_2D_ARRAY:
+        return TextureTarget_2DArray;
+    case GL_TEXTURE_3D:
+        return TextureTarget_3D;
+    case GL_TEXTURE_CUBE_MAP:
+        return TextureTarget_Cube;
+    case GL_TEXTURE_2D_MULTISAMPLE:
+        return TextureTarget_2DMultisample;
+    case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+        return TextureTarget_2DMultisampleArray;
+    case GL_TEXTURE_BUFFER:
+        return TextureTarget_Buffer;
+    default:
+        return -1;
+    }
+}
+
+std::optional<Context::IndexedBufferBinding>* Context::getIndexedBufferBinding(GLenum target, GLuint index)
+{
+    if (index >= MAX_INDEXED_BUFFER_BINDINGS)
+    {
+        return nullptr;
+    }
+    switch (target)
     {
-        std::cerr << "\nOpenGL ERROR:"
-                     "\n  Func - " << func <<
-                "\n  File - " << file <<
-                "\n  Line - " << line <<
-                "\n  Type - " << _glStringError(err)
-                  << std::endl;
-        err = glGetError();
+    case GL_UNIFORM_BUFFER:
+        return &state.uniformBuffers[index];
+    case GL_SHADER_STORAGE_BUFFER:
+        return &state.storageBuffers[index];
+    default:
+        return nullptr;
     }
 }
 
-//#   define glLog(x)  x; _glPrintErrors(#x, __FILE__, __LINE__)//; std::cout << #x << std::endl
-//#else
-#   define glLog(x) x
+void Context::forgetDeletedBuffer(GLuint buffer)
+{
+    // deleting a bound buffer reverts its bindings to 0
+    for (auto& binding : state.buffers)
+    {
+        if (binding == buffer)
+        {
+            binding = 0;
+        }
+    }
+    // vertex arrays that are not bound keep referencing the deleted buffer until they are, forget their binding since
+    // the name can be reused by a new buffer
+    std::erase_if(state.vertexArrayElementBuffers, [&](const auto& entry) {
+        return entry.second == buffer && entry.first != state.vertexArray;
+    });
+    if (state.vertexArray)
+    {
+        if (auto it = state.vertexArrayElementBuffers.find(*state.vertexArray); it != state.vertexArrayElementBuffers.end() && it->second == buffer)
+        {
+            it->second = 0;
+        }
+    }
+    for (auto* indexedBindings : {&state.uniformBuffers, &state.storageBuffers})
+    {
+        for (auto& binding : *indexedBindings)
+        {
+            if (binding && binding->buffer == buffer)
+            {
+                binding = IndexedBufferBinding{};
+            }
+        }
+    }
+}
+
+void Context::forgetDeletedTexture(GLuint texture)
+{
+    // deleting a bound texture reverts its bindings to 0
+    for (auto& unit : state.textures)
+    {
+        for (auto& binding : unit)
+        {
+            if (binding == texture)
+            {
+                binding = 0;
+            }
+        }
+    }
+}
+
+Context::Context()
+    : textureUploadQueue(std::make_unique<TextureUploadQueue>(*this))
+    , pushConstantStream(std::make_unique<PushConstantStream>(*this))
+{
+}
+
+Context::~Context() = default;
+
+void Context::invalidateStateCache()
+{
+    state = {};
+}
+
+void Context::beginFrame()
+{
+#ifdef GRAPHICSAPI_CONTEXT_STATS
+    // the stats of a frame carry the index endFrame() advances, a single counter for stats, rings and pools
+    frameStats = {};
+    frameStats.frameIndex = frameIndex;
 #endif
+}
 
-namespace opengl {
+void Context::endFrame()
+{
+    textureUploadQueue->process();
+    ++frameIndex;
+#ifdef GRAPHICSAPI_CONTEXT_STATS
+    lastFrameStats = frameStats;
+#endif
+}
+
+bool Context::isStatsEnabled()
+{
+#ifdef GRAPHICSAPI_CONTEXT_STATS
+    return true;
+#else
+    return false;
+#endif
+}
 
 void Context::init()
 {
@@ -63,584 +301,1450 @@ void Context::init()
         return;
     }
 
-    if (this->isInit = glewInit(); this->isInit != GLEW_OK)
+    GLenum result = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // contexts created through EGL have no GLX display, the GL entry points are loaded nonetheless
+    if (result == GLEW_ERROR_NO_GLX_DISPLAY)
+    {
+        result = GLEW_OK;
+    }
+#endif
+    if (result != GLEW_OK)
     {
         std::cerr << "Failed to initialize GLEW" << std::endl;
     }
+    this->isInit = true;
+
+    parallelShaderCompile = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+    if (parallelShaderCompile)
+    {
+        // let the driver pick the number of compiler threads
+        maxShaderCompilerThreads(0xFFFFFFFF);
+    }
+    vertexAttribBinding_ = GLEW_VERSION_4_3 || GLEW_ARB_vertex_attrib_binding;
+    multiBind_ = GLEW_VERSION_4_4 || GLEW_ARB_multi_bind;
+    bindlessTexture_ = GLEW_ARB_bindless_texture;
 }
 
 void Context::clipControl(GLenum origin, GLenum depth)
 {
+    const std::array<GLenum, 2> value = {origin, depth};
+    if (state.clipControl == value)
+    {
+        glStatsRedundantCall(clipControl);
+        return;
+    }
+    state.clipControl = value;
+    glStatsCall(clipControl);
     glLog(glClipControl(origin, depth));
 }
 
 void Context::enable(GLenum cap)
 {
+    if (int index = toCapIndex(cap); index >= 0)
+    {
+        if (state.caps[index] == true)
+        {
+            glStatsRedundantCall(enable);
+            return;
+        }
+        state.caps[index] = true;
+    }
+    glStatsCall(enable);
     glLog(glEnable(cap));
 }
 
 void Context::disable(GLenum cap)
 {
+    if (int index = toCapIndex(cap); index >= 0)
+    {
+        if (state.caps[index] == false)
+        {
+            glStatsRedundantCall(disable);
+            return;
+        }
+        state.caps[index] = false;
+    }
+    glStatsCall(disable);
     glLog(glDisable(cap));
 }
 
 void Context::clearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
 {
+    const std::array<GLfloat, 4> value = {red, green, blue, alpha};
+    if (state.clearColor == value)
+    {
+        glStatsRedundantCall(clearColor);
+        return;
+    }
+    state.clearColor = value;
+    glStatsCall(clearColor);
     glLog(glClearColor(red, green, blue, alpha));
 }
 
 void Context::clear(GLbitfield mask)
 {
+    glStatsCall(clear);
     glLog(glClear(mask));
 }
 
+void Context::clearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat* value)
+{
+    glStatsCall(clearBufferfv);
+    glLog(glClearBufferfv(buffer, drawbuffer, value));
+}
+
+void Context::clearBufferiv(GLenum buffer, GLint drawbuffer, const GLint* value)
+{
+    glStatsCall(clearBufferiv);
+    glLog(glClearBufferiv(buffer, drawbuffer, value));
+}
+
+void Context::clearBufferuiv(GLenum buffer, GLint drawbuffer, const GLuint* value)
+{
+    glStatsCall(clearBufferuiv);
+    glLog(glClearBufferuiv(buffer, drawbuffer, value));
+}
+
+void Context::clearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil)
+{
+    glStatsCall(clearBufferfi);
+    glLog(glClearBufferfi(buffer, drawbuffer, depth, stencil));
+}
+
 void Context::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
 {
+    const std::array<GLint, 4> value = {x, y, width, height};
+    if (state.viewport == value)
+    {
+        glStatsRedundantCall(viewport);
+        return;
+    }
+    state.viewport = value;
+    glStatsCall(viewport);
     glLog(glViewport(x, y, width, height));
 }
 
 void Context::blendFunc(GLenum sfactor, GLenum dfactor)
 {
+    const std::array<GLenum, 4> value = {sfactor, dfactor, sfactor, dfactor};
+    if (state.blendFunc == value)
+    {
+        glStatsRedundantCall(blendFunc);
+        return;
+    }
+    state.blendFunc = value;
+    glStatsCall(blendFunc);
     glLog(glBlendFunc(sfactor, dfactor));
 }
 
 void Context::frontFace(GLenum mode)
 {
+    if (state.frontFace == mode)
+    {
+        glStatsRedundantCall(frontFace);
+        return;
+    }
+    state.frontFace = mode;
+    glStatsCall(frontFace);
     glLog(glFrontFace(mode));
 }
 
 void Context::cullFace(GLenum mode)
 {
+    if (state.cullFace == mode)
+    {
+        glStatsRedundantCall(cullFace);
+        return;
+    }
+    state.cullFace = mode;
+    glStatsCall(cullFace);
     glLog(glCullFace(mode));
 }
 
 void Context::depthFunc(GLenum func)
 {
+    if (state.depthFunc == func)
+    {
+        glStatsRedundantCall(depthFunc);
+        return;
+    }
+    state.depthFunc = func;
+    glStatsCall(depthFunc);
     glLog(glDepthFunc(func));
 }
 
 void Context::depthMask(GLboolean flag)
 {
+    if (state.depthMask == flag)
+    {
+        glStatsRedundantCall(depthMask);
+        return;
+    }
+    state.depthMask = flag;
+    glStatsCall(depthMask);
     glLog(glDepthMask(flag));
 }
 
 void Context::drawArrays(GLenum mode, GLint first, GLsizei count)
 {
+    glStatsCall(drawArrays);
     glLog(glDrawArrays(mode, first, count));
 }
 
 void Context::drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
 {
+    glStatsCall(drawElements);
     glLog(glDrawElements(mode, count, type, indices));
 }
 
+void Context::drawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+    glStatsCall(drawElementsBaseVertex);
+    glLog(glDrawElementsBaseVertex(mode, count, type, indices, basevertex));
+}
+
+void Context::drawArraysInstancedBaseInstance(GLenum mode, GLint first, GLsizei count, GLsizei instancecount, GLuint baseinstance)
+{
+    glStatsCall(drawArraysInstancedBaseInstance);
+    glLog(glDrawArraysInstancedBaseInstance(mode, first, count, instancecount, baseinstance));
+}
+
+void Context::drawElementsInstancedBaseVertexBaseInstance(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance)
+{
+    glStatsCall(drawElementsInstancedBaseVertexBaseInstance);
+    glLog(glDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instancecount, basevertex, baseinstance));
+}
+
+void Context::multiDrawArraysIndirect(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+    glStatsCall(multiDrawArraysIndirect);
+    glLog(glMultiDrawArraysIndirect(mode, indirect, drawcount, stride));
+}
+
+void Context::multiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+    glStatsCall(multiDrawElementsIndirect);
+    glLog(glMultiDrawElementsIndirect(mode, type, indirect, drawcount, stride));
+}
+
 void Context::useProgram(GLuint program)
 {
+    if (state.program == program)
+    {
+        glStatsRedundantCall(useProgram);
+        return;
+    }
+    state.program = program;
+    glStatsCall(useProgram);
     glLog(glUseProgram(program));
 }
 
 void Context::bindVertexArray(GLuint array)
 {
+    if (state.vertexArray == array)
+    {
+        glStatsRedundantCall(bindVertexArray);
+        return;
+    }
+    state.vertexArray = array;
+    // the element array buffer binding is part of the vertex array state
+    if (auto it = state.vertexArrayElementBuffers.find(array); it != state.vertexArrayElementBuffers.end())
+    {
+        state.buffers[BufferTarget_ElementArray] = it->second;
+    }
+    else
+    {
+        state.buffers[BufferTarget_ElementArray].reset();
+    }
+    glStatsCall(bindVertexArray);
     glLog(glBindVertexArray(array));
 }
 
 void Context::bindBuffer(GLenum target, GLuint buffer)
 {
+    if (int index = toBufferTargetIndex(target); index >= 0)
+    {
+        if (state.buffers[index] == buffer)
+        {
+            glStatsRedundantCall(bindBuffer);
+            return;
+        }
+        state.buffers[index] = buffer;
+        if (index == BufferTarget_ElementArray && state.vertexArray)
+        {
+            state.vertexArrayElementBuffers[*state.vertexArray] = buffer;
+        }
+    }
+    glStatsCall(bindBuffer);
     glLog(glBindBuffer(target, buffer));
-    buffers[target] = buffer;
 }
 
 void Context::bindTexture(GLenum target, GLuint texture)
 {
+    const int index = toTextureTargetIndex(target);
+    const size_t unit = state.activeTexture ? *state.activeTexture - GL_TEXTURE0 : MAX_TEXTURE_UNITS;
+    if (index >= 0 && unit < MAX_TEXTURE_UNITS)
+    {
+        auto& binding = state.textures[unit][index];
+        if (binding == texture)
+        {
+            glStatsRedundantCall(bindTexture);
+            return;
+        }
+        binding = texture;
+    }
+    glStatsCall(bindTexture);
     glLog(glBindTexture(target, texture));
 }
 
+void Context::bindSampler(GLuint unit, GLuint sampler)
+{
+    if (unit < MAX_TEXTURE_UNITS)
+    {
+        if (state.samplers[unit] == sampler)
+        {
+            glStatsRedundantCall(bindSampler);
+            return;
+        }
+        state.samplers[unit] = sampler;
+    }
+    glStatsCall(bindSampler);
+    glLog(glBindSampler(unit, sampler));
+}
+
+void Context::bindTextures(GLuint first, GLsizei count, const GLuint* textures, const GLenum* targets)
+{
+    if (!multiBind_)
+    {
+        // redundant units are filtered by bindTexture
+        for (GLsizei i = 0; i < count; ++i)
+        {
+            activeTexture(GL_TEXTURE0 + first + i);
+            bindTexture(targets[i], textures[i]);
+        }
+        return;
+    }
+
+    bool redundant = true;
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        const size_t unit = first + i;
+        const int index = toTextureTargetIndex(targets[i]);
+        if (unit >= MAX_TEXTURE_UNITS || index < 0 || state.textures[unit][index] != textures[i])
+        {
+            redundant = false;
+            break;
+        }
+    }
+    if (redundant)
+    {
+        glStatsRedundantCall(bindTextures);
+        return;
+    }
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        const size_t unit = first + i;
+        if (unit >= MAX_TEXTURE_UNITS)
+        {
+            continue;
+        }
+        if (textures[i] == 0)
+        {
+            // binding 0 unbinds every target of the unit
+            state.textures[unit].fill(0);
+        }
+        else if (const int index = toTextureTargetIndex(targets[i]); index >= 0)
+        {
+            state.textures[unit][index] = textures[i];
+        }
+    }
+    glStatsCall(bindTextures);
+    glLog(glBindTextures(first, count, textures));
+}
+
+void Context::bindSamplers(GLuint first, GLsizei count, const GLuint* samplers)
+{
+    if (!multiBind_)
+    {
+        for (GLsizei i = 0; i < count; ++i)
+        {
+            bindSampler(first + i, samplers[i]);
+        }
+        return;
+    }
+
+    bool redundant = true;
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        const size_t unit = first + i;
+        if (unit >= MAX_TEXTURE_UNITS || state.samplers[unit] != samplers[i])
+        {
+            redundant = false;
+            break;
+        }
+    }
+    if (redundant)
+    {
+        glStatsRedundantCall(bindSamplers);
+        return;
+    }
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (const size_t unit = first + i; unit < MAX_TEXTURE_UNITS)
+        {
+            state.samplers[unit] = samplers[i];
+        }
+    }
+    glStatsCall(bindSamplers);
+    glLog(glBindSamplers(first, count, samplers));
+}
+
 void Context::activeTexture(GLenum texture)
 {
+    if (state.activeTexture == texture)
+    {
+        glStatsRedundantCall(activeTexture);
+        return;
+    }
+    state.activeTexture = texture;
+    glStatsCall(activeTexture);
     glLog(glActiveTexture(texture));
 }
 
 void Context::uniform1i(GLint location, GLint v0)
 {
+    glStatsCall(uniform1i);
     glLog(glUniform1i(location, v0));
 }
 
 void Context::uniform1f(GLint location, GLfloat v0)
 {
+    glStatsCall(uniform1f);
     glLog(glUniform1f(location, v0));
 }
 
 void Context::uniform2f(GLint location, GLfloat v0, GLfloat v1)
 {
+    glStatsCall(uniform2f);
     glLog(glUniform2f(location, v0, v1));
 }
 
 void Context::uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
 {
+    glStatsCall(uniform3f);
     glLog(glUniform3f(location, v0, v1, v2));
 }
 
 void Context::uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
 {
+    glStatsCall(uniform4f);
     glLog(glUniform4f(location, v0, v1, v2, v3));
 }
 
 void Context::uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
 {
+    glStatsCall(uniformMatrix4fv);
     glLog(glUniformMatrix4fv(location, count, transpose, value));
 }
 
 void Context::bindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format)
 {
+    glStatsCall(bindImageTexture);
     glLog(glBindImageTexture(unit, texture, level, layered, layer, access, format));
 }
 
 void Context::deleteShader(GLuint shader)
 {
+    glStatsCall(deleteShader);
     glLog(glDeleteShader(shader));
 }
 
 void Context::deleteProgram(GLuint program)
 {
+    glStatsCall(deleteProgram);
     glLog(glDeleteProgram(program));
 }
 
 void Context::linkProgram(GLuint program)
 {
+    glStatsCall(linkProgram);
     glLog(glLinkProgram(program));
 }
 
 void Context::shaderSource(GLuint shader, GLsizei count, const GLchar** string, const GLint* length)
 {
+    glStatsCall(shaderSource);
     glLog(glShaderSource(shader, count, string, length));
 }
 
 void Context::compileShader(GLuint shader)
 {
+    glStatsCall(compileShader);
     glLog(glCompileShader(shader));
 }
 
+void Context::maxShaderCompilerThreads(GLuint count)
+{
+    glStatsCall(maxShaderCompilerThreads);
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+        glLog(glMaxShaderCompilerThreadsKHR(count));
+    }
+    else
+    {
+        glLog(glMaxShaderCompilerThreadsARB(count));
+    }
+}
+
 void Context::getShaderiv(GLuint shader, GLenum pname, GLint* params)
 {
+    glStatsCall(getShaderiv);
     glLog(glGetShaderiv(shader, pname, params));
 }
 
 void Context::getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
 {
+    glStatsCall(getShaderInfoLog);
     glLog(glGetShaderInfoLog(shader, bufSize, length, infoLog));
 }
 
 void Context::getProgramiv(GLuint program, GLenum pname, GLint* params)
 {
+    glStatsCall(getProgramiv);
     glLog(glGetProgramiv(program, pname, params));
 }
 
 void Context::getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
 {
+    glStatsCall(getProgramInfoLog);
     glLog(glGetProgramInfoLog(program, bufSize, length, infoLog));
 }
 
+void Context::programParameteri(GLuint program, GLenum pname, GLint value)
+{
+    glStatsCall(programParameteri);
+    glLog(glProgramParameteri(program, pname, value));
+}
+
+void Context::getProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary)
+{
+    glStatsCall(getProgramBinary);
+    glLog(glGetProgramBinary(program, bufSize, length, binaryFormat, binary));
+}
+
+void Context::programBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)
+{
+    glStatsCall(programBinary);
+    glLog(glProgramBinary(program, binaryFormat, binary, length));
+}
+
+const GLubyte* Context::getString(GLenum name)
+{
+    glStatsCall(getString);
+    return glLog(glGetString(name));
+}
+
 void Context::attachShader(GLuint program, GLuint shader)
 {
+    glStatsCall(attachShader);
     glLog(glAttachShader(program, shader));
 }
 
 void Context::detachShader(GLuint program, GLuint shader)
 {
+    glStatsCall(detachShader);
     glLog(glDetachShader(program, shader));
 }
 
 GLuint Context::createShader(GLenum type)
 {
+    glStatsCall(createShader);
     return glLog(glCreateShader(type));
 }
 
 GLuint Context::createProgram()
 {
+    glStatsCall(createProgram);
     return glLog(glCreateProgram());
 }
 
 GLboolean Context::isBuffer(GLuint buffer)
 {
+    glStatsCall(isBuffer);
     return glLog(glIsBuffer(buffer));
 }
 
 GLboolean Context::isEnabled(GLenum cap)
 {
-    return glLog(glIsEnabled(cap));
+    const int index = toCapIndex(cap);
+    if (index >= 0 && state.caps[index])
+    {
+        glStatsRedundantCall(isEnabled);
+        return *state.caps[index] ? GL_TRUE : GL_FALSE;
+    }
+    glStatsCall(isEnabled);
+    GLboolean enabled = glLog(glIsEnabled(cap));
+    if (index >= 0)
+    {
+        state.caps[index] = enabled == GL_TRUE;
+    }
+    return enabled;
 }
 
 GLboolean Context::isFramebuffer(GLuint framebuffer)
 {
+    glStatsCall(isFramebuffer);
     return glLog(glIsFramebuffer(framebuffer));
 }
 
 GLboolean Context::isProgram(GLuint program)
 {
+    glStatsCall(isProgram);
     return glLog(glIsProgram(program));
 }
 
 GLboolean Context::isRenderbuffer(GLuint renderbuffer)
 {
+    glStatsCall(isRenderbuffer);
     return glLog(glIsRenderbuffer(renderbuffer));
 }
 
 GLboolean Context::isShader(GLuint shader)
 {
+    glStatsCall(isShader);
     return glLog(glIsShader(shader));
 }
 
 GLboolean Context::isTexture(GLuint texture)
 {
+    glStatsCall(isTexture);
     return glLog(glIsTexture(texture));
 }
 
 void Context::enableVertexAttribArray(GLuint index)
 {
+    glStatsCall(enableVertexAttribArray);
     glLog(glEnableVertexAttribArray(index));
 }
 
 void Context::disableVertexAttribArray(GLuint index)
 {
+    glStatsCall(disableVertexAttribArray);
     glLog(glDisableVertexAttribArray(index));
 }
 
 void Context::vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
 {
+    glStatsCall(vertexAttribPointer);
     glLog(glVertexAttribPointer(index, size, type, normalized, stride, pointer));
 }
 
 void Context::vertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)
 {
+    glStatsCall(vertexAttribIPointer);
     glLog(glVertexAttribIPointer(index, size, type, stride, pointer));
 }
 
 void Context::vertexAttribDivisor(GLuint index, GLuint divisor)
 {
+    glStatsCall(vertexAttribDivisor);
     glLog(glVertexAttribDivisor(index, divisor));
 }
 
 void Context::vertexAttribFormat(GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset)
 {
+    glStatsCall(vertexAttribFormat);
     glLog(glVertexAttribFormat(attribindex, size, type, normalized, relativeoffset));
 }
 
 void Context::vertexAttribBinding(GLuint attribindex, GLuint bindingindex)
 {
+    glStatsCall(vertexAttribBinding);
     glLog(glVertexAttribBinding(attribindex, bindingindex));
 }
 
+void Context::vertexBindingDivisor(GLuint bindingindex, GLuint divisor)
+{
+    glStatsCall(vertexBindingDivisor);
+    glLog(glVertexBindingDivisor(bindingindex, divisor));
+}
+
+void Context::bindVertexBuffer(GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride)
+{
+    glStatsCall(bindVertexBuffer);
+    glLog(glBindVertexBuffer(bindingindex, buffer, offset, stride));
+}
+
 void Context::genVertexArrays(GLsizei n, GLuint* arrays)
 {
+    glStatsCall(genVertexArrays);
     glLog(glGenVertexArrays(n, arrays));
 }
 
 void Context::genBuffers(GLsizei n, GLuint* buffers)
 {
+    glStatsCall(genBuffers);
     glLog(glGenBuffers(n, buffers));
 }
 
 void Context::genTextures(GLsizei n, GLuint* textures)
 {
+    glStatsCall(genTextures);
     glLog(glGenTextures(n, textures));
 }
 
+void Context::genSamplers(GLsizei n, GLuint* samplers)
+{
+    glStatsCall(genSamplers);
+    glLog(glGenSamplers(n, samplers));
+}
+
+void Context::samplerParameteri(GLuint sampler, GLenum pname, GLint param)
+{
+    glStatsCall(samplerParameteri);
+    glLog(glSamplerParameteri(sampler, pname, param));
+}
+
+void Context::samplerParameterf(GLuint sampler, GLenum pname, GLfloat param)
+{
+    glStatsCall(samplerParameterf);
+    glLog(glSamplerParameterf(sampler, pname, param));
+}
+
+GLuint64 Context::getTextureHandle(GLuint texture)
+{
+    glStatsCall(getTextureHandle);
+    return glLog(glGetTextureHandleARB(texture));
+}
+
+GLuint64 Context::getTextureSamplerHandle(GLuint texture, GLuint sampler)
+{
+    glStatsCall(getTextureSamplerHandle);
+    return glLog(glGetTextureSamplerHandleARB(texture, sampler));
+}
+
+void Context::makeTextureHandleResident(GLuint64 handle)
+{
+    glStatsCall(makeTextureHandleResident);
+    glLog(glMakeTextureHandleResidentARB(handle));
+}
+
+void Context::makeTextureHandleNonResident(GLuint64 handle)
+{
+    glStatsCall(makeTextureHandleNonResident);
+    glLog(glMakeTextureHandleNonResidentARB(handle));
+}
+
 void Context::genFramebuffers(GLsizei n, GLuint* framebuffers)
 {
+    glStatsCall(genFramebuffers);
     glLog(glGenFramebuffers(n, framebuffers));
 }
 
 void Context::genRenderbuffers(GLsizei n, GLuint* renderbuffers)
 {
+    glStatsCall(genRenderbuffers);
     glLog(glGenRenderbuffers(n, renderbuffers));
 }
 
 void Context::deleteVertexArrays(GLsizei n, const GLuint* arrays)
 {
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (arrays[i] != 0 && state.vertexArray == arrays[i])
+        {
+            state.vertexArray = 0;
+            state.buffers[BufferTarget_ElementArray].reset();
+        }
+        state.vertexArrayElementBuffers.erase(arrays[i]);
+    }
+    glStatsCall(deleteVertexArrays);
     glLog(glDeleteVertexArrays(n, arrays));
 }
 
 void Context::deleteBuffers(GLsizei n, const GLuint* buffers)
 {
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (buffers[i] != 0)
+        {
+            forgetDeletedBuffer(buffers[i]);
+        }
+    }
+    glStatsCall(deleteBuffers);
     glLog(glDeleteBuffers(n, buffers));
 }
 
 void Context::deleteTextures(GLsizei n, const GLuint* textures)
 {
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (textures[i] != 0)
+        {
+            forgetDeletedTexture(textures[i]);
+        }
+    }
+    glStatsCall(deleteTextures);
     glLog(glDeleteTextures(n, textures));
 }
 
+void Context::deleteSamplers(GLsizei n, const GLuint* samplers)
+{
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        // deleting a bound sampler reverts its units to 0
+        for (auto& binding : state.samplers)
+        {
+            if (samplers[i] != 0 && binding == samplers[i])
+            {
+                binding = 0;
+            }
+        }
+    }
+    glStatsCall(deleteSamplers);
+    glLog(glDeleteSamplers(n, samplers));
+}
+
 void Context::deleteFramebuffers(GLsizei n, const GLuint* framebuffers)
 {
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (framebuffers[i] == 0)
+        {
+            continue;
+        }
+        if (state.drawFramebuffer == framebuffers[i])
+        {
+            state.drawFramebuffer = 0;
+        }
+        if (state.readFramebuffer == framebuffers[i])
+        {
+            state.readFramebuffer = 0;
+        }
+    }
+    glStatsCall(deleteFramebuffers);
     glLog(glDeleteFramebuffers(n, framebuffers));
 }
 
 void Context::deleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
 {
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (renderbuffers[i] != 0 && state.renderbuffer == renderbuffers[i])
+        {
+            state.renderbuffer = 0;
+        }
+    }
+    glStatsCall(deleteRenderbuffers);
     glLog(glDeleteRenderbuffers(n, renderbuffers));
 }
 
 void Context::bindFramebuffer(GLenum target, GLuint framebuffer)
 {
+    const bool bindDraw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    const bool bindRead = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+    if ((!bindDraw || state.drawFramebuffer == framebuffer) && (!bindRead || state.readFramebuffer == framebuffer))
+    {
+        glStatsRedundantCall(bindFramebuffer);
+        return;
+    }
+    if (bindDraw)
+    {
+        state.drawFramebuffer = framebuffer;
+    }
+    if (bindRead)
+    {
+        state.readFramebuffer = framebuffer;
+    }
+    glStatsCall(bindFramebuffer);
     glLog(glBindFramebuffer(target, framebuffer));
 }
 
 void Context::deleteBuffer(GLuint id)
 {
-    glLog(glDeleteBuffers(1, &id));
+    deleteBuffers(1, &id);
 }
 
 void Context::unbindBuffer(GLenum target)
 {
-    glLog(glBindBuffer(target, 0));
-    buffers[target] = 0;
+    bindBuffer(target, 0);
+}
+
+GLuint Context::getBoundBuffer(GLenum target)
+{
+    const int index = toBufferTargetIndex(target);
+    if (index >= 0 && state.buffers[index])
+    {
+        return *state.buffers[index];
+    }
+
+    GLenum query = GL_NONE;
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:
+        query = GL_ARRAY_BUFFER_BINDING;
+        break;
+    case GL_ELEMENT_ARRAY_BUFFER:
+        query = GL_ELEMENT_ARRAY_BUFFER_BINDING;
+        break;
+    case GL_UNIFORM_BUFFER:
+        query = GL_UNIFORM_BUFFER_BINDING;
+        break;
+    case GL_SHADER_STORAGE_BUFFER:
+        query = GL_SHADER_STORAGE_BUFFER_BINDING;
+        break;
+    case GL_DRAW_INDIRECT_BUFFER:
+        query = GL_DRAW_INDIRECT_BUFFER_BINDING;
+        break;
+    case GL_DISPATCH_INDIRECT_BUFFER:
+        query = GL_DISPATCH_INDIRECT_BUFFER_BINDING;
+        break;
+    case GL_PIXEL_PACK_BUFFER:
+        query = GL_PIXEL_PACK_BUFFER_BINDING;
+        break;
+    case GL_PIXEL_UNPACK_BUFFER:
+        query = GL_PIXEL_UNPACK_BUFFER_BINDING;
+        break;
+    case GL_COPY_READ_BUFFER:
+        query = GL_COPY_READ_BUFFER_BINDING;
+        break;
+    case GL_COPY_WRITE_BUFFER:
+        query = GL_COPY_WRITE_BUFFER_BINDING;
+        break;
+    default:
+        return 0;
+    }
+
+    GLint buffer = 0;
+    getIntegerv(query, &buffer);
+    if (index >= 0)
+    {
+        state.buffers[index] = static_cast<GLuint>(buffer);
+    }
+    return static_cast<GLuint>(buffer);
 }
 
 void Context::bufferData(GLenum target, uint32_t size, const void* data, GLenum usage)
 {
+    glStatsCall(bufferData);
+    if (data)
+    {
+        glStatsBufferBytes(size);
+    }
     glLog(glBufferData(target, size, data, usage));
 }
 
 void Context::bufferSubData(GLenum get_target, uint32_t uint32, uint32_t size, const void* data)
 {
+    glStatsCall(bufferSubData);
+    glStatsBufferBytes(size);
     glLog(glBufferSubData(get_target, uint32, size, data));
 }
 
 void* Context::mapBufferRange(GLenum get_target, uint32_t uint32, uint32_t size, int i)
 {
+    glStatsCall(mapBufferRange);
     return glLog(glMapBufferRange(get_target, uint32, size, i));
 }
 
 void Context::unmapBuffer(GLenum target)
 {
+    glStatsCall(unmapBuffer);
     glLog(glUnmapBuffer(target));
 }
 
+void Context::bufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
+{
+    glStatsCall(bufferStorage);
+    glStatsBufferBytes(data ? size : 0);
+    glLog(glBufferStorage(target, size, data, flags));
+}
+
+GLsync Context::fenceSync(GLenum condition, GLbitfield flags)
+{
+    glStatsCall(fenceSync);
+    return glLog(glFenceSync(condition, flags));
+}
+
+GLenum Context::clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    glStatsCall(clientWaitSync);
+    return glLog(glClientWaitSync(sync, flags, timeout));
+}
+
+void Context::deleteSync(GLsync sync)
+{
+    glStatsCall(deleteSync);
+    glLog(glDeleteSync(sync));
+}
+
 void Context::bindBufferBase(GLenum target, GLuint index, GLuint id)
 {
+    // glBindBufferBase also binds the buffer to the generic binding point of the target
+    const int targetIndex = toBufferTargetIndex(target);
+    auto* binding = getIndexedBufferBinding(target, index);
+    const IndexedBufferBinding value = {id, 0, 0};
+    if (binding && *binding == value && targetIndex >= 0 && state.buffers[targetIndex] == id)
+    {
+        glStatsRedundantCall(bindBufferBase);
+        return;
+    }
+    if (binding)
+    {
+        *binding = value;
+    }
+    if (targetIndex >= 0)
+    {
+        state.buffers[targetIndex] = id;
+    }
+    glStatsCall(bindBufferBase);
     glLog(glBindBufferBase(target, index, id));
 }
 
 void Context::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
 {
+    // glBindBufferRange also binds the buffer to the generic binding point of the target
+    const int targetIndex = toBufferTargetIndex(target);
+    auto* binding = getIndexedBufferBinding(target, index);
+    const IndexedBufferBinding value = {buffer, offset, size};
+    if (binding && *binding == value && targetIndex >= 0 && state.buffers[targetIndex] == buffer)
+    {
+        glStatsRedundantCall(bindBufferRange);
+        return;
+    }
+    if (binding)
+    {
+        *binding = value;
+    }
+    if (targetIndex >= 0)
+    {
+        state.buffers[targetIndex] = buffer;
+    }
+    glStatsCall(bindBufferRange);
     glLog(glBindBufferRange(target, index, buffer, offset, size));
-    buffers[target] = buffer;
+}
+
+void Context::bindBuffersRange(GLenum target, GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizeiptr* sizes)
+{
+    if (!multiBind_)
+    {
+        // redundant bindings are filtered by bindBufferRange and bindBufferBase
+        for (GLsizei i = 0; i < count; ++i)
+        {
+            if (buffers[i] == 0)
+            {
+                bindBufferBase(target, first + i, 0);
+            }
+            else
+            {
+                bindBufferRange(target, first + i, buffers[i], offsets[i], sizes[i]);
+            }
+        }
+        return;
+    }
+
+    bool redundant = true;
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        auto* binding = getIndexedBufferBinding(target, first + i);
+        // offsets and sizes are ignored for buffer 0
+        const IndexedBufferBinding value = buffers[i] == 0 ? IndexedBufferBinding{} : IndexedBufferBinding{buffers[i], offsets[i], sizes[i]};
+        if (!binding || *binding != value)
+        {
+            redundant = false;
+        }
+        if (binding)
+        {
+            *binding = value;
+        }
+    }
+    if (redundant)
+    {
+        glStatsRedundantCall(bindBuffersRange);
+        return;
+    }
+    glStatsCall(bindBuffersRange);
+    glLog(glBindBuffersRange(target, first, count, buffers, offsets, sizes));
 }
 
 void Context::framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
 {
+    glStatsCall(framebufferTexture2D);
     glLog(glFramebufferTexture2D(target, attachment, textarget, texture, level));
 }
 
 void Context::framebufferTexture2DMultisample(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples)
 {
+    glStatsCall(framebufferTexture2DMultisample);
     glLog(glFramebufferTexture2DMultisampleEXT(target, attachment, textarget, texture, level, samples));
 }
 
 void Context::framebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
+    glStatsCall(framebufferRenderbuffer);
     glLog(glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer));
 }
 
 void Context::renderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    glStatsCall(renderbufferStorage);
     glLog(glRenderbufferStorage(target, internalformat, width, height));
 }
 
 void Context::renderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    glStatsCall(renderbufferStorageMultisample);
     glLog(glRenderbufferStorageMultisample(target, samples, internalformat, width, height));
 }
 
 void Context::drawBuffers(GLsizei n, const GLenum* bufs)
 {
+    glStatsCall(drawBuffers);
     glLog(glDrawBuffers(n, bufs));
 }
 
 void Context::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
 {
+    const std::array<GLboolean, 4> value = {red, green, blue, alpha};
+    if (state.colorMask == value)
+    {
+        glStatsRedundantCall(colorMask);
+        return;
+    }
+    state.colorMask = value;
+    glStatsCall(colorMask);
     glLog(glColorMask(red, green, blue, alpha));
 }
 
 void Context::clearDepth(GLfloat depth)
 {
+    if (state.clearDepth == depth)
+    {
+        glStatsRedundantCall(clearDepth);
+        return;
+    }
+    state.clearDepth = depth;
+    glStatsCall(clearDepth);
     glLog(glClearDepth(depth));
 }
 
 void Context::clearStencil(GLint s)
 {
+    if (state.clearStencil == s)
+    {
+        glStatsRedundantCall(clearStencil);
+        return;
+    }
+    state.clearStencil = s;
+    glStatsCall(clearStencil);
     glLog(glClearStencil(s));
 }
 
 void Context::stencilMask(GLuint mask)
 {
-    glLog(glStencilMask(mask));
+    stencilMaskSeparate(GL_FRONT_AND_BACK, mask);
 }
 
 void Context::stencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
 {
+    const std::array<GLuint, 3> value = {func, static_cast<GLuint>(ref), mask};
+    const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+    const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+    if ((!front || state.stencilFront.func == value) && (!back || state.stencilBack.func == value))
+    {
+        glStatsRedundantCall(stencilFuncSeparate);
+        return;
+    }
+    if (front)
+    {
+        state.stencilFront.func = value;
+    }
+    if (back)
+    {
+        state.stencilBack.func = value;
+    }
+    glStatsCall(stencilFuncSeparate);
     glLog(glStencilFuncSeparate(face, func, ref, mask));
 }
 
 void Context::stencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
 {
+    const std::array<GLenum, 3> value = {sfail, dpfail, dppass};
+    const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+    const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+    if ((!front || state.stencilFront.op == value) && (!back || state.stencilBack.op == value))
+    {
+        glStatsRedundantCall(stencilOpSeparate);
+        return;
+    }
+    if (front)
+    {
+        state.stencilFront.op = value;
+    }
+    if (back)
+    {
+        state.stencilBack.op = value;
+    }
+    glStatsCall(stencilOpSeparate);
     glLog(glStencilOpSeparate(face, sfail, dpfail, dppass));
 }
 
 void Context::stencilMaskSeparate(GLenum face, GLuint mask)
 {
+    const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+    const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+    if ((!front || state.stencilFront.writeMask == mask) && (!back || state.stencilBack.writeMask == mask))
+    {
+        glStatsRedundantCall(stencilMaskSeparate);
+        return;
+    }
+    if (front)
+    {
+        state.stencilFront.writeMask = mask;
+    }
+    if (back)
+    {
+        state.stencilBack.writeMask = mask;
+    }
+    glStatsCall(stencilMaskSeparate);
     glLog(glStencilMaskSeparate(face, mask));
 }
 
 void Context::scissor(GLint x, GLint y, GLsizei width, GLsizei height)
 {
+    const std::array<GLint, 4> value = {x, y, width, height};
+    if (state.scissor == value)
+    {
+        glStatsRedundantCall(scissor);
+        return;
+    }
+    state.scissor = value;
+    glStatsCall(scissor);
     glLog(glScissor(x, y, width, height));
 }
 
 void Context::texParameteri(GLenum target, GLenum pname, GLint param)
 {
+    glStatsCall(texParameteri);
     glLog(glTexParameteri(target, pname, param));
 }
 
 void Context::texImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
 {
+    glStatsCall(texImage2D);
+    if (pixels || state.buffers[BufferTarget_PixelUnpack].value_or(0) != 0)
+    {
+        glStatsTextureBytes(getPixelDataSize(format, type, width, height, 1));
+    }
     glLog(glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels));
 }
 
 void Context::texImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels)
 {
+    glStatsCall(texImage3D);
+    if (pixels || state.buffers[BufferTarget_PixelUnpack].value_or(0) != 0)
+    {
+        glStatsTextureBytes(getPixelDataSize(format, type, width, height, depth));
+    }
     glLog(glTexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels));
 }
 
 void Context::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
 {
+    glStatsCall(texSubImage2D);
+    glStatsTextureBytes(getPixelDataSize(format, type, width, height, 1));
     glLog(glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels));
 }
 
 void Context::texStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    glStatsCall(texStorage2D);
     glLog(glTexStorage2D(target, levels, internalformat, width, height));
 }
 
 void Context::texStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    glStatsCall(texStorage3D);
     glLog(glTexStorage3D(target, levels, internalformat, width, height, depth));
 }
 
 void Context::pixelStorei(GLenum pname, GLint param)
 {
+    glStatsCall(pixelStorei);
     glLog(glPixelStorei(pname, param));
 }
 
 void Context::compressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
 {
+    glStatsCall(compressedTexImage2D);
+    glStatsTextureBytes(imageSize);
     glLog(glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data));
 }
 
 void Context::compressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data)
 {
+    glStatsCall(compressedTexSubImage2D);
+    glStatsTextureBytes(imageSize);
     glLog(glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data));
 }
 
 void Context::compressedTexImage3D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void* data)
 {
+    glStatsCall(compressedTexImage3D);
+    glStatsTextureBytes(imageSize);
     glLog(glCompressedTexImage3D(target, level, internalformat, width, height, depth, border, imageSize, data));
 }
 
 void Context::compressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void* data)
 {
+    glStatsCall(compressedTexSubImage3D);
+    glStatsTextureBytes(imageSize);
     glLog(glCompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data));
 }
 
 void Context::texSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
 {
+    glStatsCall(texSubImage3D);
+    glStatsTextureBytes(getPixelDataSize(format, type, width, height, depth));
     glLog(glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels));
 }
 
 void Context::generateMipmap(GLenum target)
 {
+    glStatsCall(generateMipmap);
     glLog(glGenerateMipmap(target));
 }
 
 void Context::bindRenderbuffer(GLenum target, GLuint renderbuffer)
 {
+    if (state.renderbuffer == renderbuffer)
+    {
+        glStatsRedundantCall(bindRenderbuffer);
+        return;
+    }
+    state.renderbuffer = renderbuffer;
+    glStatsCall(bindRenderbuffer);
     glLog(glBindRenderbuffer(target, renderbuffer));
 }
 
 void Context::invalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments)
 {
+    glStatsCall(invalidateFramebuffer);
     glLog(glInvalidateFramebuffer(target, numAttachments, attachments));
 }
 
+void Context::invalidateSubFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    glStatsCall(invalidateSubFramebuffer);
+    glLog(glInvalidateSubFramebuffer(target, numAttachments, attachments, x, y, width, height));
+}
+
 GLenum Context::checkFramebufferStatus(GLenum target)
 {
+    glStatsCall(checkFramebufferStatus);
     GLenum status = glLog(glCheckFramebufferStatus(target));
     return status;
 }
 
 void Context::getProgramResourceiv(GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum* props, GLsizei bufSize, GLsizei* length, GLint* params)
 {
+    glStatsCall(getProgramResourceiv);
     glLog(glGetProgramResourceiv(program, programInterface, index, propCount, props, bufSize, length, params));
 }
 
 void Context::getProgramResourceName(GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name)
 {
+    glStatsCall(getProgramResourceName);
     glLog(glGetProgramResourceName(program, programInterface, index, bufSize, length, name));
 }
 
 void Context::getActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
 {
+    glStatsCall(getActiveUniform);
     glLog(glGetActiveUniform(program, index, bufSize, length, size, type, name));
 }
 
 GLint Context::getUniformLocation(GLuint program, const GLchar* name)
 {
+    glStatsCall(getUniformLocation);
     GLint loc = glLog(glGetUniformLocation(program, name));
     return loc;
 }
 
 void Context::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
 {
+    const std::array<GLenum, 2> value = {modeRGB, modeAlpha};
+    if (state.blendEquation == value)
+    {
+        glStatsRedundantCall(blendEquationSeparate);
+        return;
+    }
+    state.blendEquation = value;
+    glStatsCall(blendEquationSeparate);
     glLog(glBlendEquationSeparate(modeRGB, modeAlpha));
 }
 
 void Context::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
 {
+    const std::array<GLenum, 4> value = {srcRGB, dstRGB, srcAlpha, dstAlpha};
+    if (state.blendFunc == value)
+    {
+        glStatsRedundantCall(blendFuncSeparate);
+        return;
+    }
+    state.blendFunc = value;
+    glStatsCall(blendFuncSeparate);
     glLog(glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha));
 }
 
 void Context::polygonFillMode(GLenum mode)
 {
+    if (state.polygonMode == mode)
+    {
+        glStatsRedundantCall(polygonFillMode);
+        return;
+    }
+    state.polygonMode = mode;
+    glStatsCall(polygonFillMode);
     glLog(glPolygonMode(GL_FRONT_AND_BACK, mode));
 }
 
 void Context::getIntegerv(GLenum pname, GLint* data)
 {
+    glStatsCall(getIntegerv);
     glLog(glGetIntegerv(pname, data));
 }
 
 void Context::getUniformiv(GLuint program, GLint location, GLint* params)
 {
+    glStatsCall(getUniformiv);
     glLog(glGetUniformiv(program, location, params));
 }
 
 void Context::getProgramInterfaceiv(GLuint program, GLenum programInterface, GLenum pname, GLint* params)
 {
+    glStatsCall(getProgramInterfaceiv);
     glLog(glGetProgramInterfaceiv(program, programInterface, pname, params));
 }
 
 GLuint Context::getProgramResourceIndex(GLuint program, GLenum programInterface, const GLchar* name)
 {
+    glStatsCall(getProgramResourceIndex);
     return glLog(glGetProgramResourceIndex(program, programInterface, name));
 }
 
 void Context::dispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
 {
+    glStatsCall(dispatchCompute);
     glLog(glDispatchCompute(num_groups_x, num_groups_y, num_groups_z));
 }
 
 void Context::memoryBarrier(GLbitfield barriers)
 {
+    glStatsCall(memoryBarrier);
     glLog(glMemoryBarrier(barriers));
 }
 
@@ -3,33 +3,58 @@
 //
 
 #include "graphicsAPI/opengl/Device.h"
+#include "BufferHeap.h"
 #include "CommandPool.h"
 #include "ComputePipeline.h"
 #include "DepthStencilState.h"
 #include "Framebuffer.h"
 #include "GraphicsPipeline.h"
+#include "PipelineCache.h"
+#include "RenderTargetPool.h"
 #include "Renderbuffer.h"
 #include "SamplerState.h"
+#include "ShaderCache.h"
 #include "ShaderModule.h"
 #include "ShaderStage.h"
 #include "TextureBuffer.h"
+#include "TextureResidency.h"
 #include "VertexInputState.h"
 #include "graphicsAPI/opengl/Buffer.h"
 //#include "shaderc/shaderc.hpp"
 //#include <spirv_glsl.hpp>
 
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
 
 namespace opengl {
 
+namespace {
+constexpr size_t DEFAULT_PIPELINE_CACHE_CAPACITY = 1024;
+}
+
 Device::Device(std::unique_ptr<Context> context_)
     : context(std::move(context_))
+    , commandQueue(std::make_shared<CommandQueue>())
+    , shaderCache(std::make_shared<ShaderCache>(*context))
+    , graphicsPipelineCache(std::make_shared<PipelineCache<GraphicsPipelineDesc, GraphicsPipelineDescHash, IGraphicsPipeline>>(DEFAULT_PIPELINE_CACHE_CAPACITY))
+    , computePipelineCache(std::make_shared<PipelineCache<ComputePipelineDesc, ComputePipelineDescHash, IComputePipeline>>(DEFAULT_PIPELINE_CACHE_CAPACITY))
 {
     context->init();
+    if (context->hasBindlessTexture())
+    {
+        textureResidency = std::make_shared<TextureResidency>(*context);
+    }
+    renderTargetPool = std::make_shared<RenderTargetPool>(*this);
 }
 
 std::shared_ptr<ICommandPool> Device::createCommandPool(const CommandPoolDesc& desc)
 {
+    // deferred pools are owned by a single recording thread, hand out a new one every time
+    if (desc.recordingMode == RecordingMode::Deferred)
+    {
+        return std::make_shared<CommandPool>(context, commandQueue, desc);
+    }
     if (!commandPool) {
         commandPool = std::make_shared<CommandPool>(context, desc);
     }
@@ -41,10 +66,35 @@ std::unique_ptr<IBuffer> Device::createBuffer(const BufferDesc& desc)
     std::unique_ptr<Buffer> resource;
     auto bufferType = desc.type;
 
+    if (desc.storage == ResourceStorage::Ring && !hasFeature(DeviceFeatures::BufferRing))
+    {
+        throw std::runtime_error("Ring buffers require GL 4.4 or ARB_buffer_storage");
+    }
+
+    if (desc.subAllocate)
+    {
+        if ((bufferType != BufferDesc::BufferTypeBits::Vertex && bufferType != BufferDesc::BufferTypeBits::Index) ||
+            desc.storage == ResourceStorage::Ring || desc.size == 0)
+        {
+            throw std::runtime_error("Only Vertex or Index buffers with a size and without ResourceStorage::Ring can be sub-allocated");
+        }
+        auto& heap = bufferType == BufferDesc::BufferTypeBits::Vertex ? vertexBufferHeap : indexBufferHeap;
+        if (!heap)
+        {
+            heap = std::make_shared<BufferHeap>(getContext(), bufferType);
+        }
+        // attribute offsets have to be 4 byte aligned, vertex buffers also start on a whole vertex
+        const uint32_t alignment = bufferType == BufferDesc::BufferTypeBits::Vertex && desc.vertexStride > 0 ? std::lcm(desc.vertexStride, 4u) : 4u;
+        resource = std::make_unique<BufferView>(getContext(), heap, heap->allocate(desc.size, alignment));
+        resource->initialize(desc);
+        return resource;
+    }
+
     if ((bufferType & BufferDesc::BufferTypeBits::Index) ||
         (bufferType & BufferDesc::BufferTypeBits::Vertex) ||
         (bufferType & BufferDesc::BufferTypeBits::Storage) ||
-        (bufferType & BufferDesc::BufferTypeBits::Uniform))
+        (bufferType & BufferDesc::BufferTypeBits::Uniform) ||
+        (bufferType & BufferDesc::BufferTypeBits::Indirect))
     {
         resource = std::make_unique<ArrayBuffer>(getContext());
     }
@@ -57,6 +107,16 @@ std::unique_ptr<IBuffer> Device::createBuffer(const BufferDesc& desc)
 
 std::shared_ptr<IShaderModule> Device::createShaderModule(const ShaderModuleDesc& desc)
 {
+    const uint64_t contentHash = ShaderModule::hashDesc(desc);
+    if (auto cachedModule = shaderCache->findModule(desc, contentHash))
+    {
+        // the module may come from an asynchronous request, a synchronous one still gets the compile errors thrown
+        if (!desc.compileAsync)
+        {
+            cachedModule->waitUntilCompiled();
+        }
+        return cachedModule;
+    }
     auto shaderModule = std::make_shared<ShaderModule>(getContext(), desc);
 
 //    shaderc::Compiler glslcompiler;
@@ -74,7 +134,12 @@ std::shared_ptr<IShaderModule> Device::createShaderModule(const ShaderModuleDesc
 //    spirv_cross::CompilerGLSL compiler(vertexSPRV);
 
 //    std::string compiledCode = shaderModule->compileAndParseGLSL(compiler);
-    shaderModule->create(desc.code);
+    // with program binaries a program may never link from source, its modules are compiled by the first link needing them
+    if (!shaderCache->isProgramBinaryEnabled())
+    {
+        shaderModule->create(desc.code);
+    }
+    shaderCache->addModule(shaderModule);
 
     return shaderModule;
 }
@@ -82,13 +147,15 @@ std::shared_ptr<IShaderModule> Device::createShaderModule(const ShaderModuleDesc
 std::shared_ptr<IPipelineShaderStages> Device::createPipelineShaderStages(const PipelineShaderStagesDesc& desc)
 {
     auto shaderStages = std::make_shared<PipelineShaderStages>(getContext(), desc);
-    shaderStages->createProgram();
+    shaderStages->createProgram(shaderCache);
     return shaderStages;
 }
 
 std::shared_ptr<IGraphicsPipeline> Device::createGraphicsPipeline(const GraphicsPipelineDesc& desc)
 {
-    return std::make_shared<GraphicsPipeline>(getContext(), desc);
+    return graphicsPipelineCache->getOrCreate(desc, [this](const GraphicsPipelineDesc& pipelineDesc) {
+        return std::make_shared<GraphicsPipeline>(getContext(), pipelineDesc);
+    });
 }
 
 std::shared_ptr<IFramebuffer> Device::createFramebuffer(const FramebufferDesc& desc)
@@ -103,6 +170,13 @@ std::shared_ptr<ITexture> Device::createTexture(const TextureDesc& desc)
     const auto sanitizedDesc = sanitizeTextureDesc(desc);
     std::unique_ptr<Texture> texture;
 
+    // GL has no lazily allocated memory, memoryless attachments are renderbuffers invalidated after every render pass
+    if (sanitizedDesc.storage == ResourceStorage::Memoryless &&
+        (sanitizedDesc.usage != TextureDesc::TextureUsageBits::Attachment || sanitizedDesc.type != TextureType::Texture2D))
+    {
+        throw std::runtime_error("Memoryless textures can only be 2D attachments");
+    }
+
     if ((sanitizedDesc.usage & TextureDesc::TextureUsageBits::Sampled) != 0 ||
         (sanitizedDesc.usage & TextureDesc::TextureUsageBits::Storage) != 0) {
         texture = std::make_unique<TextureBuffer>(getContext(), desc.format);
@@ -123,10 +197,34 @@ std::shared_ptr<ITexture> Device::createTexture(const TextureDesc& desc)
     return texture;
 }
 
+std::shared_ptr<ITexture> Device::acquireRenderTarget(const TextureDesc& desc)
+{
+    return renderTargetPool->acquireTexture(desc);
+}
+
+std::shared_ptr<IFramebuffer> Device::acquireFramebuffer(const FramebufferDesc& desc)
+{
+    return renderTargetPool->acquireFramebuffer(desc);
+}
+
 bool Device::hasFeature(DeviceFeatures feature) const
 {
-    // unimplemented
-    return false;
+    switch (feature)
+    {
+        case DeviceFeatures::BufferRing:
+            return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+        case DeviceFeatures::DrawIndexedIndirect:
+            return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+        case DeviceFeatures::TextureBindless:
+            // not exposed by e.g. llvmpipe, textures are bound to units there
+            return context->hasBindlessTexture();
+        case DeviceFeatures::PushConstants:
+            // emulated with a uniform block, see PushConstantStream
+            return true;
+        default:
+            // unimplemented
+            return false;
+    }
 }
 
 ICapabilities::TextureFormatCapabilities Device::getTextureFormatCapabilities(TextureFormat format) const
@@ -137,7 +235,7 @@ ICapabilities::TextureFormatCapabilities Device::getTextureFormatCapabilities(Te
 
 std::shared_ptr<IVertexInputState> Device::createVertexInputState(const VertexInputStateDesc& desc)
 {
-    auto vertexInputState = std::make_shared<VertexInputState>(desc);
+    auto vertexInputState = std::make_shared<VertexInputState>(getContext(), desc);
     return vertexInputState;
 }
 
@@ -148,13 +246,100 @@ std::shared_ptr<IDepthStencilState> Device::createDepthStencilState(const DepthS
 
 std::shared_ptr<ISamplerState> Device::createSamplerState(const SamplerStateDesc& desc)
 {
-    return std::make_shared<SamplerState>(getContext(), desc);
+    auto& cached = samplerStates[desc];
+    if (auto samplerState = cached.lock())
+    {
+        return samplerState;
+    }
+    auto samplerState = std::make_shared<SamplerState>(getContext(), desc);
+    cached = samplerState;
+
+    // drop the entries of destroyed sampler states once in a while, so that the map does not grow forever
+    if (samplerStates.size() % 64 == 0)
+    {
+        std::erase_if(samplerStates, [](const auto& entry) { return entry.second.expired(); });
+    }
+    return samplerState;
+}
+
+uint64_t Device::getBindlessTextureHandle(const std::shared_ptr<ITexture>& texture, const std::shared_ptr<ISamplerState>& samplerState)
+{
+    if (!textureResidency)
+    {
+        return 0;
+    }
+    return textureResidency->getHandle(std::static_pointer_cast<Texture>(texture), std::static_pointer_cast<SamplerState>(samplerState));
+}
+
+void Device::beginFrame()
+{
+    context->beginFrame();
+}
+
+void Device::endFrame()
+{
+    context->endFrame();
 }
 
 Context& Device::getContext() const
 {
     return *context;
 }
+
+void Device::executeSubmittedCommandBuffers()
+{
+    commandQueue->execute();
+}
+
+void Device::setShaderCacheDirectory(const std::filesystem::path& directory)
+{
+    shaderCache->setProgramBinaryDirectory(directory);
+}
+
+const ShaderCacheStats& Device::getShaderCacheStats() const
+{
+    return shaderCache->getStats();
+}
+
+void Device::setBindlessResidencyBudget(size_t budget)
+{
+    if (textureResidency)
+    {
+        textureResidency->setBudget(budget);
+    }
+}
+
+size_t Device::getResidentTextureHandleCount() const
+{
+    return textureResidency ? textureResidency->getResidentCount() : 0;
+}
+
+void Device::setRenderTargetPoolMaxIdleFrames(uint64_t frames)
+{
+    renderTargetPool->setMaxIdleFrames(frames);
+}
+
+const RenderTargetPoolStats& Device::getRenderTargetPoolStats() const
+{
+    return renderTargetPool->getStats();
+}
+
+void Device::setPipelineCacheCapacity(size_t capacity)
+{
+    graphicsPipelineCache->setCapacity(capacity);
+    computePipelineCache->setCapacity(capacity);
+}
+
+const PipelineCacheStats& Device::getGraphicsPipelineCacheStats() const
+{
+    return graphicsPipelineCache->getStats();
+}
+
+const PipelineCacheStats& Device::getComputePipelineCacheStats() const
+{
+    return computePipelineCache->getStats();
+}
+
 TextureDesc Device::sanitizeTextureDesc(const TextureDesc& desc) const
 {
     TextureDesc sanitized = desc;
@@ -173,8 +358,9 @@ TextureDesc Device::sanitizeTextureDesc(const TextureDesc& desc) const
 
 std::shared_ptr<IComputePipeline> Device::createComputePipeline(const ComputePipelineDesc& desc)
 {
-    auto computePipeline = std::make_shared<ComputePipeline>(getContext(), desc);
-    return computePipeline;
+    return computePipelineCache->getOrCreate(desc, [this](const ComputePipelineDesc& pipelineDesc) {
+        return std::make_shared<ComputePipeline>(getContext(), pipelineDesc);
+    });
 }
 
 }// namespace opengl
@@ -0,0 +1,198 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "DrawSorter.h"
+
+#include <algorithm>
+
+namespace opengl {
+
+static uint64_t quantizeDepth(float depth, uint32_t bits)
+{
+    const float clamped = std::clamp(depth, 0.0f, 1.0f);
+    const uint64_t maxValue = (uint64_t(1) << bits) - 1;
+    return static_cast<uint64_t>(clamped * static_cast<float>(maxValue));
+}
+
+static uint64_t field(uint64_t value, uint32_t bits)
+{
+    return value & ((uint64_t(1) << bits) - 1);
+}
+
+void DrawSorter::begin(DrawReorderMode mode_)
+{
+    reset();
+    mode = mode_;
+}
+
+void DrawSorter::reset()
+{
+    mode = DrawReorderMode::None;
+    currentState = {};
+    stateDirty = true;
+    states.clear();
+    draws.clear();
+}
+
+DrawSorter::DrawRecord& DrawSorter::addDrawRecord(CommandType type, const DrawSortHint& hint)
+{
+    if (stateDirty || states.empty())
+    {
+        states.push_back(currentState);
+        stateDirty = false;
+    }
+
+    auto& record = draws.emplace_back();
+    record.state = static_cast<uint32_t>(states.size() - 1);
+    record.depth = hint.depth;
+    record.reorderable = hint.reorderable && !currentState.blended;
+    record.type = type;
+    return record;
+}
+
+void DrawSorter::addDraw(const DrawCommand& draw, const DrawSortHint& hint)
+{
+    addDrawRecord(CommandType::Draw, hint).draw = draw;
+}
+
+void DrawSorter::addDraw(const DrawIndexedCommand& drawIndexed, const DrawSortHint& hint)
+{
+    addDrawRecord(CommandType::DrawIndexed, hint).drawIndexed = drawIndexed;
+}
+
+void DrawSorter::addDraw(const DrawIndirectCommand& drawIndirect, const DrawSortHint& hint)
+{
+    addDrawRecord(CommandType::DrawIndirect, hint).drawIndirect = drawIndirect;
+}
+
+void DrawSorter::addDraw(const DrawIndexedIndirectCommand& drawIndexedIndirect, const DrawSortHint& hint)
+{
+    addDrawRecord(CommandType::DrawIndexedIndirect, hint).drawIndexedIndirect = drawIndexedIndirect;
+}
+
+uint32_t DrawSorter::getDenseId(std::unordered_map<uint64_t, uint32_t>& ids, uint64_t value)
+{
+    return ids.try_emplace(value, static_cast<uint32_t>(ids.size())).first->second;
+}
+
+uint64_t DrawSorter::makeSortKey(const StateKey& stateKey, float depth) const
+{
+    if (mode == DrawReorderMode::FrontToBack)
+    {
+        // depth:24 | pipeline:12 | depth stencil:4 | textures:12 | vertex buffers:12
+        return (quantizeDepth(depth, 24) << 40) |
+               (field(stateKey.pipeline, 12) << 28) |
+               (field(stateKey.depthStencilState, 4) << 24) |
+               (field(stateKey.textureSet, 12) << 12) |
+               field(stateKey.vertexBufferSet, 12);
+    }
+    // pipeline:16 | depth stencil:8 | textures:16 | vertex buffers:12 | depth:12
+    return (field(stateKey.pipeline, 16) << 48) |
+           (field(stateKey.depthStencilState, 8) << 40) |
+           (field(stateKey.textureSet, 16) << 24) |
+           (field(stateKey.vertexBufferSet, 12) << 12) |
+           quantizeDepth(depth, 12);
+}
+
+void DrawSorter::radixSort(SortItem* items, SortItem* scratch, size_t count)
+{
+    // LSD radix sort on 8-bit digits, stable so that equal keys keep their recording order
+    SortItem* source = items;
+    SortItem* destination = scratch;
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        std::array<size_t, 256> histogram = {};
+        for (size_t i = 0; i < count; ++i)
+        {
+            ++histogram[(source[i].key >> shift) & 0xFF];
+        }
+        // every key has the same digit, nothing to do for this pass
+        if (histogram[(source[0].key >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+        size_t offset = 0;
+        for (auto& bucket : histogram)
+        {
+            const size_t bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+    if (source != items)
+    {
+        std::copy(source, source + count, items);
+    }
+}
+
+const std::vector<uint32_t>& DrawSorter::sort()
+{
+    order.clear();
+
+    stateKeys.clear();
+    pipelineIds.clear();
+    depthStencilStateIds.clear();
+    textureSetIds.clear();
+    vertexBufferSetIds.clear();
+    for (const auto& state : states)
+    {
+        size_t textureSetHash = 0;
+        for (const auto* textures : {&state.vertexTextures, &state.fragmentTextures})
+        {
+            for (const auto& binding : *textures)
+            {
+                hash_combine(textureSetHash, binding.texture);
+                hash_combine(textureSetHash, binding.samplerState);
+            }
+        }
+        size_t vertexBufferSetHash = 0;
+        for (const auto& binding : state.vertexBuffers)
+        {
+            hash_combine(vertexBufferSetHash, binding.buffer);
+            hash_combine(vertexBufferSetHash, binding.offset);
+        }
+        stateKeys.push_back({
+                .pipeline = getDenseId(pipelineIds, state.pipeline),
+                .depthStencilState = getDenseId(depthStencilStateIds, state.depthStencilState),
+                .textureSet = getDenseId(textureSetIds, textureSetHash),
+                .vertexBufferSet = getDenseId(vertexBufferSetIds, vertexBufferSetHash),
+        });
+    }
+
+    auto flushSegment = [this]() {
+        if (sortItems.empty())
+        {
+            return;
+        }
+        sortScratch.resize(sortItems.size());
+        radixSort(sortItems.data(), sortScratch.data(), sortItems.size());
+        for (const auto& item : sortItems)
+        {
+            order.push_back(item.draw);
+        }
+        sortItems.clear();
+    };
+
+    for (uint32_t i = 0; i < draws.size(); ++i)
+    {
+        const auto& draw = draws[i];
+        if (!draw.reorderable)
+        {
+            flushSegment();
+            order.push_back(i);
+            continue;
+        }
+        sortItems.push_back({makeSortKey(stateKeys[draw.state], draw.depth), i});
+    }
+    flushSegment();
+
+    return order;
+}
+
+}// namespace opengl
@@ -0,0 +1,162 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "GraphicsCommands.h"
+#include "UniformBinder.h"
+#include "graphicsAPI/common/Common.h"
+#include "graphicsAPI/common/GraphicsCommandBuffer.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace opengl {
+
+/**
+ * @brief Collects the draws of a render pass together with the state they depend on, and orders them with a 64-bit
+ * sort key before they are written to the command stream.
+ *
+ * Resources are identified by their retained resource slot in the owning command buffer. Draws that are not
+ * reorderable split the render pass into segments, draws are only reordered inside a segment.
+ */
+class DrawSorter
+{
+public:
+    static constexpr uint32_t INVALID_SLOT = ~0u;
+    // every binding of the uniform binder, the sorted draws bind the same indices as the unsorted ones
+    static constexpr size_t MAX_UNIFORM_BUFFERS = UniformBinder::MAX_BUFFER_BINDINGS;
+
+    struct BufferBinding
+    {
+        uint32_t buffer = INVALID_SLOT;
+        uint32_t offset = 0;
+
+        bool operator==(const BufferBinding& other) const = default;
+    };
+
+    struct TextureBinding
+    {
+        uint32_t texture = INVALID_SLOT;
+        uint32_t samplerState = INVALID_SLOT;
+
+        bool operator==(const TextureBinding& other) const = default;
+    };
+
+    struct DrawState
+    {
+        uint32_t pipeline = INVALID_SLOT;
+        uint32_t depthStencilState = INVALID_SLOT;
+        bool blended = false;
+        std::array<BufferBinding, MAX_VERTEX_BUFFERS> vertexBuffers;
+        std::array<BufferBinding, MAX_UNIFORM_BUFFERS> uniformBuffers;
+        std::array<TextureBinding, MAX_TEXTURE_SAMPLERS> vertexTextures;
+        std::array<TextureBinding, MAX_TEXTURE_SAMPLERS> fragmentTextures;
+        bool hasViewport = false;
+        Viewport viewport = {};
+        bool hasScissor = false;
+        ScissorRect scissor = {};
+        uint32_t pushConstants = INVALID_SLOT;
+    };
+
+    struct DrawRecord
+    {
+        uint32_t state;
+        float depth;
+        bool reorderable;
+        CommandType type;
+        union
+        {
+            DrawCommand draw;
+            DrawIndexedCommand drawIndexed;
+            DrawIndirectCommand drawIndirect;
+            DrawIndexedIndirectCommand drawIndexedIndirect;
+        };
+    };
+
+    void begin(DrawReorderMode mode);
+    void reset();
+
+    [[nodiscard]] bool isActive() const
+    {
+        return mode != DrawReorderMode::None;
+    }
+
+    /**
+     * @brief Returns the state that the next draw will use, for modification by the bind commands.
+     */
+    DrawState& editState()
+    {
+        stateDirty = true;
+        return currentState;
+    }
+
+    [[nodiscard]] const DrawState& getState() const
+    {
+        return currentState;
+    }
+
+    void addDraw(const DrawCommand& draw, const DrawSortHint& hint);
+    void addDraw(const DrawIndexedCommand& drawIndexed, const DrawSortHint& hint);
+    void addDraw(const DrawIndirectCommand& drawIndirect, const DrawSortHint& hint);
+    void addDraw(const DrawIndexedIndirectCommand& drawIndexedIndirect, const DrawSortHint& hint);
+
+    /**
+     * @brief Sorts the recorded draws, returns their indices in execution order.
+     */
+    const std::vector<uint32_t>& sort();
+
+    [[nodiscard]] const DrawRecord& getDraw(uint32_t index) const
+    {
+        return draws[index];
+    }
+
+    [[nodiscard]] const DrawState& getDrawState(const DrawRecord& draw) const
+    {
+        return states[draw.state];
+    }
+
+private:
+    struct SortItem
+    {
+        uint64_t key;
+        uint32_t draw;
+    };
+
+    struct StateKey
+    {
+        uint32_t pipeline;
+        uint32_t depthStencilState;
+        uint32_t textureSet;
+        uint32_t vertexBufferSet;
+    };
+
+    DrawRecord& addDrawRecord(CommandType type, const DrawSortHint& hint);
+    uint64_t makeSortKey(const StateKey& stateKey, float depth) const;
+    static uint32_t getDenseId(std::unordered_map<uint64_t, uint32_t>& ids, uint64_t value);
+    static void radixSort(SortItem* items, SortItem* scratch, size_t count);
+
+private:
+    DrawReorderMode mode = DrawReorderMode::None;
+
+    DrawState currentState;
+    bool stateDirty = true;
+
+    std::vector<DrawState> states;
+    std::vector<DrawRecord> draws;
+
+    // scratch memory, kept between render passes
+    std::vector<StateKey> stateKeys;
+    std::vector<SortItem> sortItems;
+    std::vector<SortItem> sortScratch;
+    std::vector<uint32_t> order;
+    std::unordered_map<uint64_t, uint32_t> pipelineIds;
+    std::unordered_map<uint64_t, uint32_t> depthStencilStateIds;
+    std::unordered_map<uint64_t, uint32_t> textureSetIds;
+    std::unordered_map<uint64_t, uint32_t> vertexBufferSetIds;
+};
+
+}// namespace opengl
@@ -5,14 +5,50 @@
 #include "Framebuffer.h"
 #include "Texture.h"
 #include "TextureBuffer.h"
+#include "graphicsAPI/common/Util.h"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <thread>
 
 namespace opengl
 {
 
+namespace {
+
+// glClearBuffer has to match the component type of the attachment, clearing an integer attachment with another is
+// undefined
+enum class ClearValueType
+{
+    Float,
+    Int,
+    UnsignedInt,
+};
+
+ClearValueType getClearValueType(const ITexture& texture)
+{
+    FormatDescGL formatDesc;
+    if (!Texture::toFormatDescGL(texture.getFormat(), TextureDesc::TextureUsageBits::Attachment, formatDesc))
+    {
+        return ClearValueType::Float;
+    }
+    if (formatDesc.format != GL_RED_INTEGER && formatDesc.format != GL_RG_INTEGER && formatDesc.format != GL_RGB_INTEGER &&
+        formatDesc.format != GL_RGBA_INTEGER)
+    {
+        return ClearValueType::Float;
+    }
+    const bool isSigned = formatDesc.type == GL_BYTE || formatDesc.type == GL_SHORT || formatDesc.type == GL_INT;
+    return isSigned ? ClearValueType::Int : ClearValueType::UnsignedInt;
+}
+
+bool isMemoryless(const std::shared_ptr<ITexture>& texture)
+{
+    return static_cast<const Texture&>(*texture).isMemoryless();
+}
+
+}// namespace
+
 Framebuffer::Framebuffer(Context& context)
     : WithContext(context)
 {
@@ -113,9 +149,10 @@ void Framebuffer::create(const FramebufferDesc& desc)
 
 }
 
-void Framebuffer::bindForRenderPass(const RenderPassDesc& renderPass) const
+void Framebuffer::bindForRenderPass(const RenderPassDesc& renderPass, const ScissorRect& renderArea) const
 {
     activeRenderPass = renderPass;
+    activeRenderArea = renderArea;
 
     getContext().bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
 
@@ -142,64 +179,169 @@ void Framebuffer::bindForRenderPass(const RenderPassDesc& renderPass) const
         }
     }
 
-    GLbitfield clearMask = 0;
+    std::array<GLenum, MAX_COLOR_ATTACHMENTS + 2> discarded{};
+    GLsizei numDiscarded = 0;
+
+    // the clears are restricted to the render area with the scissor test, which is disabled when a render pass begins
+    bool isScissored = false;
+    auto beginClear = [&]() {
+        if (!isScissored && !renderArea.isNull())
+        {
+            getContext().enable(GL_SCISSOR_TEST);
+            getContext().scissor(static_cast<GLint>(renderArea.x), static_cast<GLint>(renderArea.y),
+                                 static_cast<GLsizei>(renderArea.width), static_cast<GLsizei>(renderArea.height));
+            isScissored = true;
+        }
+    };
+
+    for (const auto& [index, colorAttachment]: renderTarget.colorAttachments)
+    {
+        auto const& texture = colorAttachment.texture;
+        if (!texture || index >= renderPass.colorAttachments.size())
+        {
+            continue;
+        }
+
+        const auto& attachment = renderPass.colorAttachments[index];
+        if (attachment.loadAction == LoadAction::Clear)
+        {
+            beginClear();
+            getContext().colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            // glClearBuffer addresses the draw buffers, which are the attachments in ascending order
+            const auto drawBuffer = static_cast<GLint>(std::ranges::count_if(renderTarget.colorAttachments, [index](const auto& other) {
+                return other.first < index;
+            }));
+            const auto& clearColor = attachment.clearColor;
+            switch (getClearValueType(*texture))
+            {
+                case ClearValueType::Int:
+                {
+                    const std::array<GLint, 4> value = {static_cast<GLint>(clearColor.r), static_cast<GLint>(clearColor.g),
+                                                        static_cast<GLint>(clearColor.b), static_cast<GLint>(clearColor.a)};
+                    getContext().clearBufferiv(GL_COLOR, drawBuffer, value.data());
+                    break;
+                }
+                case ClearValueType::UnsignedInt:
+                {
+                    const std::array<GLuint, 4> value = {static_cast<GLuint>(clearColor.r), static_cast<GLuint>(clearColor.g),
+                                                         static_cast<GLuint>(clearColor.b), static_cast<GLuint>(clearColor.a)};
+                    getContext().clearBufferuiv(GL_COLOR, drawBuffer, value.data());
+                    break;
+                }
+                case ClearValueType::Float:
+                {
+                    const std::array<GLfloat, 4> value = {clearColor.r, clearColor.g, clearColor.b, clearColor.a};
+                    getContext().clearBufferfv(GL_COLOR, drawBuffer, value.data());
+                    break;
+                }
+            }
+        }
+        else if (attachment.loadAction == LoadAction::DontCare || isMemoryless(texture))
+        {
+            discarded[numDiscarded++] = static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + index);
+        }
+    }
+
+    const auto& depthTexture = renderTarget.depthAttachment.texture;
+    const auto& stencilTexture = renderTarget.stencilAttachment.texture;
+    const bool clearDepth = depthTexture != nullptr && renderPass.depthAttachment.loadAction == LoadAction::Clear;
+    const bool clearStencil = stencilTexture != nullptr && renderPass.stencilAttachment.loadAction == LoadAction::Clear;
+    const GLfloat depth = renderPass.depthAttachment.clearDepth;
+    const auto stencil = static_cast<GLint>(renderPass.stencilAttachment.clearStencil);
 
-    if (auto colorAttachment0 = renderTarget.colorAttachments.find(0);
-        colorAttachment0 != renderTarget.colorAttachments.end() && colorAttachment0->second.texture != nullptr &&
-        renderPass.colorAttachments[0].loadAction == LoadAction::Clear)
+    if (clearDepth || clearStencil)
     {
-        clearMask |= GL_COLOR_BUFFER_BIT;
-        auto& clearColor = renderPass.colorAttachments[0].clearColor;
-        getContext().colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-        getContext().clearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+        beginClear();
     }
-    if (auto depthAttachment = renderTarget.depthAttachment.texture;
-        depthAttachment != nullptr && renderPass.depthAttachment.loadAction == LoadAction::Clear)
+    if (clearDepth)
     {
-        clearMask |= GL_DEPTH_BUFFER_BIT;
         getContext().depthMask(GL_TRUE);
-        getContext().clearDepth(renderPass.depthAttachment.clearDepth);
     }
-    if (auto stencilAttachment = renderTarget.stencilAttachment.texture;
-        stencilAttachment != nullptr && renderPass.stencilAttachment.loadAction == LoadAction::Clear)
+    if (clearStencil)
     {
-        clearMask |= GL_STENCIL_BUFFER_BIT;
         getContext().stencilMask(0xFF);
-        getContext().clearStencil(renderPass.stencilAttachment.clearStencil);
+    }
+    if (clearDepth && clearStencil && depthTexture == stencilTexture)
+    {
+        getContext().clearBufferfi(GL_DEPTH_STENCIL, 0, depth, stencil);
+    }
+    else
+    {
+        if (clearDepth)
+        {
+            getContext().clearBufferfv(GL_DEPTH, 0, &depth);
+        }
+        if (clearStencil)
+        {
+            getContext().clearBufferiv(GL_STENCIL, 0, &stencil);
+        }
     }
 
-    if (clearMask != 0)
+    if (depthTexture != nullptr && !clearDepth &&
+        (renderPass.depthAttachment.loadAction == LoadAction::DontCare || isMemoryless(depthTexture)))
     {
-        getContext().clear(clearMask);
+        discarded[numDiscarded++] = GL_DEPTH_ATTACHMENT;
+    }
+    if (stencilTexture != nullptr && !clearStencil &&
+        (renderPass.stencilAttachment.loadAction == LoadAction::DontCare || isMemoryless(stencilTexture)))
+    {
+        discarded[numDiscarded++] = GL_STENCIL_ATTACHMENT;
+    }
+
+    if (isScissored)
+    {
+        getContext().disable(GL_SCISSOR_TEST);
+    }
+    // lets tiled GPUs skip loading the previous content
+    if (numDiscarded > 0)
+    {
+        invalidateAttachments(getContext(), numDiscarded, discarded.data(), renderArea);
     }
 }
 
 void Framebuffer::unbind() const
 {
-    GLenum attachments[3];
+    std::array<GLenum, MAX_COLOR_ATTACHMENTS + 2> attachments{};
     GLsizei numAttachments = 0;
 
-    auto colorAttachment0 = renderTarget.colorAttachments.find(0);
-
-    if (colorAttachment0 != renderTarget.colorAttachments.end() &&
-        colorAttachment0->second.texture != nullptr &&
-        activeRenderPass.colorAttachments[0].storeAction != StoreAction::Store) {
-        attachments[numAttachments++] = GL_COLOR_ATTACHMENT0;
+    for (const auto& [index, colorAttachment]: renderTarget.colorAttachments)
+    {
+        if (colorAttachment.texture == nullptr || index >= activeRenderPass.colorAttachments.size())
+        {
+            continue;
+        }
+        if (activeRenderPass.colorAttachments[index].storeAction != StoreAction::Store || isMemoryless(colorAttachment.texture))
+        {
+            attachments[numAttachments++] = static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + index);
+        }
     }
     if (renderTarget.depthAttachment.texture != nullptr) {
-        if (activeRenderPass.depthAttachment.storeAction != StoreAction::Store) {
+        if (activeRenderPass.depthAttachment.storeAction != StoreAction::Store || isMemoryless(renderTarget.depthAttachment.texture)) {
             attachments[numAttachments++] = GL_DEPTH_ATTACHMENT;
         }
     }
     if (renderTarget.stencilAttachment.texture != nullptr) {
         getContext().disable(GL_STENCIL_TEST);
-        if (activeRenderPass.stencilAttachment.storeAction != StoreAction::Store) {
+        if (activeRenderPass.stencilAttachment.storeAction != StoreAction::Store || isMemoryless(renderTarget.stencilAttachment.texture)) {
             attachments[numAttachments++] = GL_STENCIL_ATTACHMENT;
         }
     }
 
     if (numAttachments > 0) {
-        getContext().invalidateFramebuffer(GL_FRAMEBUFFER, numAttachments, attachments);
+        invalidateAttachments(getContext(), numAttachments, attachments.data(), activeRenderArea);
+    }
+}
+
+void Framebuffer::invalidateAttachments(Context& context, GLsizei numAttachments, const GLenum* attachments, const ScissorRect& renderArea)
+{
+    if (renderArea.isNull())
+    {
+        context.invalidateFramebuffer(GL_FRAMEBUFFER, numAttachments, attachments);
+    }
+    else
+    {
+        context.invalidateSubFramebuffer(GL_FRAMEBUFFER, numAttachments, attachments, static_cast<GLint>(renderArea.x), static_cast<GLint>(renderArea.y),
+                                         static_cast<GLsizei>(renderArea.width), static_cast<GLsizei>(renderArea.height));
     }
 }
 
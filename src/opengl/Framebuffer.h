@@ -31,9 +31,22 @@ public:
     [[nodiscard]] std::shared_ptr<ITexture> getStencilAttachment() const override;
 
 
-    void bindForRenderPass(const RenderPassDesc& renderPass) const;
+    /**
+     * @brief Binds the framebuffer and applies the load action of every attachment, clears are restricted to
+     * renderArea unless it is null. Attachments that are not loaded are invalidated.
+     */
+    void bindForRenderPass(const RenderPassDesc& renderPass, const ScissorRect& renderArea) const;
+    /**
+     * @brief Applies the store actions of the render pass begun last, invalidating the attachments that are not
+     * stored. Memoryless attachments are always invalidated.
+     */
     void unbind() const;
 
+    /**
+     * @brief Invalidates the attachments of the bound framebuffer, only inside of renderArea unless it is null.
+     */
+    static void invalidateAttachments(Context& context, GLsizei numAttachments, const GLenum* attachments, const ScissorRect& renderArea);
+
     [[nodiscard]] Viewport getViewport() const;
 
     [[nodiscard]] GLuint getHandle() const;
@@ -55,6 +68,7 @@ private:
 
     FramebufferDesc renderTarget; // attachments
     mutable RenderPassDesc activeRenderPass;
+    mutable ScissorRect activeRenderArea;
 };
 
 }
@@ -5,9 +5,17 @@
 #include "GraphicsCommandBuffer.h"
 
 
+#include "ComputeCommandBuffer.h"
 #include "Framebuffer.h"
+#include "GraphicsCommands.h"
+#include "PushConstantStream.h"
+#include "VertexInputState.h"
 #include "graphicsAPI/opengl/Buffer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
 namespace opengl {
 
 static GLenum toOpenGLPrimitiveType(PrimitiveType type)
@@ -44,64 +52,693 @@ static GLenum toOpenGLIndexFormat(IndexFormat format)
 
 GraphicsCommandBuffer::GraphicsCommandBuffer(const std::shared_ptr<Context>& context)
 {
-    activeVAO = std::make_shared<VertexArrayObject>(*context);
-    activeVAO->create();
-
+    // the vertex array object is created on first execution, so that the command buffer can be
+    // constructed and recorded without a current GL context
     uniformBinder = UniformBinder();
 
     this->context = context;
 }
 
+void GraphicsCommandBuffer::begin(const CommandBufferDesc& desc)
+{
+    recordingMode = desc.recordingMode;
+    submissionOrder = desc.submissionOrder;
+    commands.reset();
+    retainedResources.clear();
+    retainedResourceSlots.clear();
+    drawSorter.reset();
+    pushConstantData = {};
+    pushConstantBlocks.clear();
+    pendingPushConstants = nullptr;
+    clearDirty(DirtyFlag::DirtyBits_PushConstants);
+    // the cache does not retain the buffers, a recycled command buffer must not see those of its previous recording
+    vertexBuffersCache.clear();
+    vertexBuffersDirtyCache.clear();
+}
+
+void GraphicsCommandBuffer::execute()
+{
+    commands.forEach([this](uint16_t type, const std::byte* payload) {
+        switch (static_cast<CommandType>(type))
+        {
+        case CommandType::BeginRenderPass:
+        {
+            const auto& command = CommandStream::read<BeginRenderPassCommand>(payload);
+            RenderPassBeginDesc desc;
+            if (command.framebuffer != INVALID_RESOURCE_SLOT)
+            {
+                desc.framebuffer = std::static_pointer_cast<IFramebuffer>(retainedResources[command.framebuffer]);
+            }
+            desc.renderPass.colorAttachments.assign(command.colorAttachments.begin(), command.colorAttachments.begin() + command.colorAttachmentCount);
+            desc.renderPass.depthAttachment = command.depthAttachment;
+            desc.renderPass.stencilAttachment = command.stencilAttachment;
+            desc.renderArea = command.renderArea;
+            executeBeginRenderPass(desc);
+            break;
+        }
+        case CommandType::EndRenderPass:
+            executeEndRenderPass();
+            break;
+        case CommandType::BindGraphicsPipeline:
+        {
+            const auto& command = CommandStream::read<BindGraphicsPipelineCommand>(payload);
+            executeBindGraphicsPipeline(getRetainedResource<GraphicsPipeline>(command.pipeline));
+            break;
+        }
+        case CommandType::BindBuffer:
+        {
+            const auto& command = CommandStream::read<BindBufferCommand>(payload);
+            executeBindBuffer(command.index, getRetainedResource<Buffer>(command.buffer), command.offset);
+            break;
+        }
+        case CommandType::Draw:
+        {
+            const auto& command = CommandStream::read<DrawCommand>(payload);
+            executeDraw(command.primitiveType, command.vertexStart, command.vertexCount, command.instanceCount, command.baseInstance);
+            break;
+        }
+        case CommandType::DrawIndexed:
+        {
+            const auto& command = CommandStream::read<DrawIndexedCommand>(payload);
+            executeDrawIndexed(command.primitiveType, command.indexCount, command.indexFormat, *getRetainedResource<Buffer>(command.indexBuffer), command.indexBufferOffset,
+                               command.baseVertex, command.instanceCount, command.baseInstance);
+            break;
+        }
+        case CommandType::DrawIndirect:
+        {
+            const auto& command = CommandStream::read<DrawIndirectCommand>(payload);
+            executeDrawIndirect(command.primitiveType, *getRetainedResource<Buffer>(command.indirectBuffer), command.indirectBufferOffset, command.drawCount, command.stride);
+            break;
+        }
+        case CommandType::DrawIndexedIndirect:
+        {
+            const auto& command = CommandStream::read<DrawIndexedIndirectCommand>(payload);
+            executeDrawIndexedIndirect(command.primitiveType, command.indexFormat, *getRetainedResource<Buffer>(command.indexBuffer),
+                                       *getRetainedResource<Buffer>(command.indirectBuffer),
+                                       command.indirectBufferOffset, command.drawCount, command.stride);
+            break;
+        }
+        case CommandType::BindViewport:
+            executeBindViewport(CommandStream::read<BindViewportCommand>(payload).viewport);
+            break;
+        case CommandType::BindScissor:
+            executeBindScissor(CommandStream::read<BindScissorCommand>(payload).scissor);
+            break;
+        case CommandType::BindDepthStencilState:
+        {
+            const auto& command = CommandStream::read<BindDepthStencilStateCommand>(payload);
+            executeBindDepthStencilState(getRetainedResource<DepthStencilState>(command.depthStencilState));
+            break;
+        }
+        case CommandType::BindTexture:
+        {
+            const auto& command = CommandStream::read<BindTextureCommand>(payload);
+            executeBindTexture(command.index, command.target, getRetainedResource<Texture>(command.texture));
+            break;
+        }
+        case CommandType::BindSamplerState:
+        {
+            const auto& command = CommandStream::read<BindSamplerStateCommand>(payload);
+            executeBindSamplerState(command.index, command.target, getRetainedResource<SamplerState>(command.samplerState));
+            break;
+        }
+        case CommandType::PushConstants:
+            executePushConstants(pushConstantBlocks[CommandStream::read<PushConstantsCommand>(payload).block]);
+            break;
+        case CommandType::Barrier:
+            context->memoryBarrier(toGLBarrierBits(CommandStream::read<BarrierCommand>(payload).barriers));
+            break;
+        }
+    });
+
+    commands.reset();
+    retainedResources.clear();
+    retainedResourceSlots.clear();
+    pushConstantBlocks.clear();
+    pendingPushConstants = nullptr;
+    clearDirty(DirtyFlag::DirtyBits_PushConstants);
+}
+
 void GraphicsCommandBuffer::beginRenderPass(const RenderPassBeginDesc& desc)
+{
+    if (isDeferred())
+    {
+        if (desc.renderPass.colorAttachments.size() > MAX_COLOR_ATTACHMENTS)
+        {
+            throw std::runtime_error("Too many color attachments in render pass");
+        }
+        BeginRenderPassCommand command = {
+                .framebuffer = retainResource<IFramebuffer>(desc.framebuffer),
+                .colorAttachmentCount = static_cast<uint32_t>(desc.renderPass.colorAttachments.size()),
+                .colorAttachments = {},
+                .depthAttachment = desc.renderPass.depthAttachment,
+                .stencilAttachment = desc.renderPass.stencilAttachment,
+                .renderArea = desc.renderArea};
+        std::copy(desc.renderPass.colorAttachments.begin(), desc.renderPass.colorAttachments.end(), command.colorAttachments.begin());
+        commands.write(command);
+
+        drawSortHint = {};
+        if (desc.drawReorderMode != DrawReorderMode::None)
+        {
+            drawSorter.begin(desc.drawReorderMode);
+        }
+        return;
+    }
+    executeBeginRenderPass(desc);
+}
+
+void GraphicsCommandBuffer::endRenderPass()
+{
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            writeSortedDraws();
+            drawSorter.reset();
+        }
+        commands.write(EndRenderPassCommand{});
+        return;
+    }
+    executeEndRenderPass();
+}
+
+void GraphicsCommandBuffer::bindGraphicsPipeline(std::shared_ptr<IGraphicsPipeline> pipeline)
+{
+    // retained in both recording modes, the bound state and the replay only hold raw pointers
+    const uint32_t slot = retainResource<GraphicsPipeline>(pipeline);
+    auto* glPipeline = getRetainedResource<GraphicsPipeline>(slot);
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            auto& state = drawSorter.editState();
+            state.pipeline = slot;
+            state.blended = glPipeline && std::ranges::any_of(glPipeline->getDesc().colorBlendAttachmentStates, [](const auto& attachment) { return attachment.blendEnabled; });
+            return;
+        }
+        commands.write(BindGraphicsPipelineCommand{slot});
+        return;
+    }
+    executeBindGraphicsPipeline(glPipeline);
+}
+
+void GraphicsCommandBuffer::bindBuffer(uint32_t index, std::shared_ptr<IBuffer> buffer, uint32_t offset)
+{
+    if (!buffer)
+    {
+        throw std::runtime_error("Cannot bind a null buffer");
+    }
+    const auto bufferType = static_cast<const Buffer&>(*buffer).getType();
+    // checked in every recording mode, a sorted render pass has no place for the bindings out of range
+    if ((bufferType == Buffer::Type::Attribute && index >= MAX_VERTEX_BUFFERS) ||
+        (bufferType == Buffer::Type::Uniform && index >= DrawSorter::MAX_UNIFORM_BUFFERS))
+    {
+        throw std::runtime_error("Buffer binding index out of range");
+    }
+
+    // retained in both recording modes, the bound state and the replay only hold raw pointers
+    const uint32_t slot = retainResource<Buffer>(buffer);
+    auto* glBuffer = getRetainedResource<Buffer>(slot);
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            if (bufferType == Buffer::Type::Attribute)
+            {
+                drawSorter.editState().vertexBuffers[index] = {slot, offset};
+            }
+            else if (bufferType == Buffer::Type::Uniform)
+            {
+                drawSorter.editState().uniformBuffers[index] = {slot, offset};
+            }
+            return;
+        }
+        commands.write(BindBufferCommand{index, slot, offset});
+        return;
+    }
+    executeBindBuffer(index, glBuffer, offset);
+}
+
+void GraphicsCommandBuffer::draw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount)
+{
+    drawInstanced(primitiveType, vertexStart, vertexCount, 1, 0);
+}
+
+void GraphicsCommandBuffer::drawIndexed(PrimitiveType primitiveType, size_t indexCount, IndexFormat indexFormat, IBuffer& indexBuffer, size_t indexBufferOffset, int32_t baseVertex)
+{
+    drawIndexedInstanced(primitiveType, indexCount, indexFormat, indexBuffer, indexBufferOffset, baseVertex, 1, 0);
+}
+
+void GraphicsCommandBuffer::drawInstanced(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount, size_t instanceCount, size_t baseInstance)
+{
+    if (isDeferred())
+    {
+        const DrawCommand command = {primitiveType, vertexStart, vertexCount,
+                                     static_cast<uint32_t>(instanceCount), static_cast<uint32_t>(baseInstance)};
+        if (drawSorter.isActive())
+        {
+            drawSorter.addDraw(command, drawSortHint);
+            return;
+        }
+        commands.write(command);
+        return;
+    }
+    executeDraw(primitiveType, vertexStart, vertexCount, static_cast<uint32_t>(instanceCount), static_cast<uint32_t>(baseInstance));
+}
+
+void GraphicsCommandBuffer::drawIndexedInstanced(PrimitiveType primitiveType,
+                                                 size_t indexCount,
+                                                 IndexFormat indexFormat,
+                                                 IBuffer& indexBuffer,
+                                                 size_t indexBufferOffset,
+                                                 int32_t baseVertex,
+                                                 size_t instanceCount,
+                                                 size_t baseInstance)
+{
+    if (isDeferred())
+    {
+        const DrawIndexedCommand command = {primitiveType, indexFormat, indexCount, retainBuffer(indexBuffer), indexBufferOffset, baseVertex,
+                                            static_cast<uint32_t>(instanceCount), static_cast<uint32_t>(baseInstance)};
+        if (drawSorter.isActive())
+        {
+            drawSorter.addDraw(command, drawSortHint);
+            return;
+        }
+        commands.write(command);
+        return;
+    }
+    executeDrawIndexed(primitiveType, indexCount, indexFormat, indexBuffer, indexBufferOffset, baseVertex,
+                       static_cast<uint32_t>(instanceCount), static_cast<uint32_t>(baseInstance));
+}
+
+void GraphicsCommandBuffer::drawIndirect(PrimitiveType primitiveType, IBuffer& indirectBuffer, size_t indirectBufferOffset, uint32_t drawCount, uint32_t stride)
+{
+    if (isDeferred())
+    {
+        const DrawIndirectCommand command = {primitiveType, retainBuffer(indirectBuffer), indirectBufferOffset, drawCount, stride};
+        if (drawSorter.isActive())
+        {
+            drawSorter.addDraw(command, drawSortHint);
+            return;
+        }
+        commands.write(command);
+        return;
+    }
+    executeDrawIndirect(primitiveType, indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
+void GraphicsCommandBuffer::drawIndexedIndirect(PrimitiveType primitiveType,
+                                                IndexFormat indexFormat,
+                                                IBuffer& indexBuffer,
+                                                IBuffer& indirectBuffer,
+                                                size_t indirectBufferOffset,
+                                                uint32_t drawCount,
+                                                uint32_t stride)
+{
+    // firstIndex is read by the GPU, it cannot be offset to the range of a sub-allocated index buffer
+    if (static_cast<Buffer&>(indexBuffer).getStorageOffset() != 0)
+    {
+        throw std::runtime_error("Indexed indirect draws do not support sub-allocated index buffers");
+    }
+    if (isDeferred())
+    {
+        const DrawIndexedIndirectCommand command = {primitiveType, indexFormat, retainBuffer(indexBuffer), retainBuffer(indirectBuffer),
+                                                    indirectBufferOffset, drawCount, stride};
+        if (drawSorter.isActive())
+        {
+            drawSorter.addDraw(command, drawSortHint);
+            return;
+        }
+        commands.write(command);
+        return;
+    }
+    executeDrawIndexedIndirect(primitiveType, indexFormat, indexBuffer, indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
+uint32_t GraphicsCommandBuffer::retainBuffer(IBuffer& buffer)
+{
+    // looked up first, locking the weak reference of every draw would cost an atomic operation each
+    if (const auto it = retainedResourceSlots.find(static_cast<Buffer*>(&buffer)); it != retainedResourceSlots.end())
+    {
+        return it->second;
+    }
+    if (auto owner = buffer.weak_from_this().lock())
+    {
+        return retainResource<Buffer>(owner);
+    }
+    // held by a unique_ptr, the caller keeps it alive until the command buffer is executed
+    return retainResource<Buffer>(std::shared_ptr<IBuffer>(std::shared_ptr<IBuffer>(), &buffer));
+}
+
+void GraphicsCommandBuffer::bindViewport(const Viewport& viewport)
+{
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            auto& state = drawSorter.editState();
+            state.hasViewport = true;
+            state.viewport = viewport;
+            return;
+        }
+        commands.write(BindViewportCommand{viewport});
+        return;
+    }
+    executeBindViewport(viewport);
+}
+
+void GraphicsCommandBuffer::bindScissor(const ScissorRect& scissor)
+{
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            auto& state = drawSorter.editState();
+            state.hasScissor = true;
+            state.scissor = scissor;
+            return;
+        }
+        commands.write(BindScissorCommand{scissor});
+        return;
+    }
+    executeBindScissor(scissor);
+}
+
+void GraphicsCommandBuffer::bindDepthStencilState(const std::shared_ptr<IDepthStencilState>& depthStencilState)
+{
+    // retained in both recording modes, the bound state and the replay only hold raw pointers
+    const uint32_t slot = retainResource<DepthStencilState>(depthStencilState);
+    auto* glDepthStencilState = getRetainedResource<DepthStencilState>(slot);
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            drawSorter.editState().depthStencilState = slot;
+            return;
+        }
+        commands.write(BindDepthStencilStateCommand{slot});
+        return;
+    }
+    executeBindDepthStencilState(glDepthStencilState);
+}
+
+void GraphicsCommandBuffer::bindTexture(uint32_t index, uint8_t target, std::shared_ptr<ITexture> texture)
+{
+    if (index >= MAX_TEXTURE_SAMPLERS)
+    {
+        throw std::runtime_error("Texture binding index out of range");
+    }
+    // retained in both recording modes, the bound state and the replay only hold raw pointers
+    const uint32_t slot = retainResource<Texture>(texture);
+    auto* glTexture = getRetainedResource<Texture>(slot);
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            auto& state = drawSorter.editState();
+            if ((target & BindTarget::BindTarget_Vertex) != 0)
+            {
+                state.vertexTextures[index].texture = slot;
+            }
+            if ((target & BindTarget::BindTarget_Fragment) != 0)
+            {
+                state.fragmentTextures[index].texture = slot;
+            }
+            return;
+        }
+        commands.write(BindTextureCommand{index, target, slot});
+        return;
+    }
+    executeBindTexture(index, target, glTexture);
+}
+
+void GraphicsCommandBuffer::bindSamplerState(uint32_t index, uint8_t target, std::shared_ptr<ISamplerState> samplerState)
+{
+    if (index >= MAX_TEXTURE_SAMPLERS)
+    {
+        throw std::runtime_error("Sampler state binding index out of range");
+    }
+    // retained in both recording modes, the bound state and the replay only hold raw pointers
+    const uint32_t slot = retainResource<SamplerState>(samplerState);
+    auto* glSamplerState = getRetainedResource<SamplerState>(slot);
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            auto& state = drawSorter.editState();
+            if ((target & BindTarget::BindTarget_Vertex) != 0)
+            {
+                state.vertexTextures[index].samplerState = slot;
+            }
+            if ((target & BindTarget::BindTarget_Fragment) != 0)
+            {
+                state.fragmentTextures[index].samplerState = slot;
+            }
+            return;
+        }
+        commands.write(BindSamplerStateCommand{index, target, slot});
+        return;
+    }
+    executeBindSamplerState(index, target, glSamplerState);
+}
+
+void GraphicsCommandBuffer::pushConstants(uint8_t /*target*/, uint32_t offset, const void* data, uint32_t size)
+{
+    if (static_cast<uint64_t>(offset) + size > MAX_PUSH_CONSTANTS_SIZE)
+    {
+        throw std::runtime_error("Push constants out of range");
+    }
+    // a single block is shared by all stages, the target only matters to backends with native push constants
+    std::memcpy(pushConstantData.data.data() + offset, data, size);
+    pushConstantData.size = std::max(pushConstantData.size, (offset + size + 15) / 16 * 16);
+    if (isDeferred())
+    {
+        const auto block = static_cast<uint32_t>(pushConstantBlocks.size());
+        pushConstantBlocks.push_back(pushConstantData);
+        if (drawSorter.isActive())
+        {
+            drawSorter.editState().pushConstants = block;
+            return;
+        }
+        commands.write(PushConstantsCommand{block});
+        return;
+    }
+    executePushConstants(pushConstantData);
+}
+
+void GraphicsCommandBuffer::memoryBarrier(uint32_t barriers)
+{
+    if (barriers == 0)
+    {
+        return;
+    }
+    if (isDeferred())
+    {
+        if (drawSorter.isActive())
+        {
+            throw std::runtime_error("Memory barriers must be recorded outside of render passes");
+        }
+        commands.write(BarrierCommand{barriers});
+        return;
+    }
+    context->memoryBarrier(toGLBarrierBits(barriers));
+}
+
+void GraphicsCommandBuffer::setDrawSortHint(const DrawSortHint& hint)
+{
+    drawSortHint = hint;
+}
+
+void GraphicsCommandBuffer::writeStateChanges(const DrawSorter::DrawState* previous, const DrawSorter::DrawState& state)
+{
+    // vertex attributes and sampler uniforms are set up for the bound pipeline, so a pipeline change
+    // has to bring the vertex buffers and textures along
+    const bool pipelineChanged = !previous || previous->pipeline != state.pipeline;
+    if (pipelineChanged && state.pipeline != DrawSorter::INVALID_SLOT)
+    {
+        commands.write(BindGraphicsPipelineCommand{state.pipeline});
+    }
+    if (state.depthStencilState != DrawSorter::INVALID_SLOT && (!previous || previous->depthStencilState != state.depthStencilState))
+    {
+        commands.write(BindDepthStencilStateCommand{state.depthStencilState});
+    }
+    for (uint32_t i = 0; i < MAX_VERTEX_BUFFERS; ++i)
+    {
+        const auto& binding = state.vertexBuffers[i];
+        if (binding.buffer != DrawSorter::INVALID_SLOT && (pipelineChanged || previous->vertexBuffers[i] != binding))
+        {
+            commands.write(BindBufferCommand{i, binding.buffer, binding.offset});
+        }
+    }
+    for (uint32_t i = 0; i < DrawSorter::MAX_UNIFORM_BUFFERS; ++i)
+    {
+        const auto& binding = state.uniformBuffers[i];
+        if (binding.buffer != DrawSorter::INVALID_SLOT && (!previous || previous->uniformBuffers[i] != binding))
+        {
+            commands.write(BindBufferCommand{i, binding.buffer, binding.offset});
+        }
+    }
+    for (uint32_t i = 0; i < MAX_TEXTURE_SAMPLERS; ++i)
+    {
+        const std::pair<uint8_t, const DrawSorter::TextureBinding*> textureTargets[] = {
+                {BindTarget::BindTarget_Vertex, &state.vertexTextures[i]},
+                {BindTarget::BindTarget_Fragment, &state.fragmentTextures[i]}};
+        for (const auto& [target, binding] : textureTargets)
+        {
+            const auto* previousBinding = !previous ? nullptr : target == BindTarget::BindTarget_Vertex ? &previous->vertexTextures[i] : &previous->fragmentTextures[i];
+            if (*binding == DrawSorter::TextureBinding{} && (!previousBinding || *previousBinding == *binding))
+            {
+                continue;
+            }
+            if (pipelineChanged || previousBinding->texture != binding->texture)
+            {
+                commands.write(BindTextureCommand{i, target, binding->texture});
+            }
+            if (pipelineChanged || previousBinding->samplerState != binding->samplerState)
+            {
+                commands.write(BindSamplerStateCommand{i, target, binding->samplerState});
+            }
+        }
+    }
+    if (state.hasViewport && (!previous || !previous->hasViewport || std::memcmp(&previous->viewport, &state.viewport, sizeof(Viewport)) != 0))
+    {
+        commands.write(BindViewportCommand{state.viewport});
+    }
+    if (state.hasScissor && (!previous || !previous->hasScissor || previous->scissor.x != state.scissor.x || previous->scissor.y != state.scissor.y ||
+                             previous->scissor.width != state.scissor.width || previous->scissor.height != state.scissor.height))
+    {
+        commands.write(BindScissorCommand{state.scissor});
+    }
+    if (state.pushConstants != DrawSorter::INVALID_SLOT && (!previous || previous->pushConstants != state.pushConstants))
+    {
+        commands.write(PushConstantsCommand{state.pushConstants});
+    }
+}
+
+void GraphicsCommandBuffer::writeSortedDraws()
+{
+    const DrawSorter::DrawState* previous = nullptr;
+    for (uint32_t index : drawSorter.sort())
+    {
+        const auto& draw = drawSorter.getDraw(index);
+        const auto& state = drawSorter.getDrawState(draw);
+        if (&state != previous)
+        {
+            writeStateChanges(previous, state);
+            previous = &state;
+        }
+        switch (draw.type)
+        {
+            case CommandType::DrawIndexed:
+                commands.write(draw.drawIndexed);
+                break;
+            case CommandType::DrawIndirect:
+                commands.write(draw.drawIndirect);
+                break;
+            case CommandType::DrawIndexedIndirect:
+                commands.write(draw.drawIndexedIndirect);
+                break;
+            default:
+                commands.write(draw.draw);
+                break;
+        }
+    }
+}
+
+void GraphicsCommandBuffer::executeBeginRenderPass(const RenderPassBeginDesc& desc)
 {
     // save the current state
     scissorEnabled = false;//context->isEnabled(GL_SCISSOR_TEST);
     context->disable(GL_SCISSOR_TEST);
 
-    if (activeVAO)
+    if (!activeVAO)
     {
-        activeVAO->bind();
+        activeVAO = std::make_shared<VertexArrayObject>(*context);
+        activeVAO->create();
     }
+    activeVAO->bind();
+    activeVertexArray = activeVAO.get();
 
     if (desc.framebuffer)
     {
         const auto& glFramebuffer = std::static_pointer_cast<Framebuffer>(desc.framebuffer);
-        glFramebuffer->bindForRenderPass(desc.renderPass);
-        bindViewport(glFramebuffer->getViewport());
+        glFramebuffer->bindForRenderPass(desc.renderPass, desc.renderArea);
+        executeBindViewport(glFramebuffer->getViewport());
     }
     else
     {
         // for the moment we will do this for the default framebuffer
         context->bindFramebuffer(GL_FRAMEBUFFER, 0);
-        GLbitfield clearMask = 0;
 
-        auto& renderPass = desc.renderPass;
+        const auto& renderPass = desc.renderPass;
+        const auto& renderArea = desc.renderArea;
+        std::array<GLenum, 3> discarded{};
+        GLsizei numDiscarded = 0;
 
-        if (renderPass.colorAttachments[0].loadAction == LoadAction::Clear)
+        const bool clearColor = !renderPass.colorAttachments.empty() && renderPass.colorAttachments[0].loadAction == LoadAction::Clear;
+        const bool clearDepth = renderPass.depthAttachment.loadAction == LoadAction::Clear;
+        const bool clearStencil = renderPass.stencilAttachment.loadAction == LoadAction::Clear;
+        const bool isScissored = (clearColor || clearDepth || clearStencil) && !renderArea.isNull();
+        if (isScissored)
         {
-            clearMask |= GL_COLOR_BUFFER_BIT;
-            auto& clearColor = renderPass.colorAttachments[0].clearColor;
+            context->enable(GL_SCISSOR_TEST);
+            context->scissor(static_cast<GLint>(renderArea.x), static_cast<GLint>(renderArea.y), static_cast<GLsizei>(renderArea.width),
+                             static_cast<GLsizei>(renderArea.height));
+        }
+
+        if (clearColor)
+        {
+            const auto& color = renderPass.colorAttachments[0].clearColor;
+            const std::array<GLfloat, 4> value = {color.r, color.g, color.b, color.a};
             context->colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-            context->clearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+            context->clearBufferfv(GL_COLOR, 0, value.data());
+        }
+        else if (!renderPass.colorAttachments.empty() && renderPass.colorAttachments[0].loadAction == LoadAction::DontCare)
+        {
+            discarded[numDiscarded++] = GL_COLOR;
         }
-        if (renderPass.depthAttachment.loadAction == LoadAction::Clear)
+
+        const GLfloat depth = renderPass.depthAttachment.clearDepth;
+        const auto stencil = static_cast<GLint>(renderPass.stencilAttachment.clearStencil);
+        if (clearDepth)
         {
-            clearMask |= GL_DEPTH_BUFFER_BIT;
             context->depthMask(GL_TRUE);
-            context->clearDepth(renderPass.depthAttachment.clearDepth);
         }
-        if (renderPass.stencilAttachment.loadAction == LoadAction::Clear)
+        if (clearStencil)
         {
-            clearMask |= GL_STENCIL_BUFFER_BIT;
             context->stencilMask(0xFF);
-            context->clearStencil(renderPass.stencilAttachment.clearStencil);
+        }
+        if (clearDepth && clearStencil)
+        {
+            context->clearBufferfi(GL_DEPTH_STENCIL, 0, depth, stencil);
+        }
+        else if (clearDepth)
+        {
+            context->clearBufferfv(GL_DEPTH, 0, &depth);
+        }
+        else if (clearStencil)
+        {
+            context->clearBufferiv(GL_STENCIL, 0, &stencil);
+        }
+        if (renderPass.depthAttachment.loadAction == LoadAction::DontCare)
+        {
+            discarded[numDiscarded++] = GL_DEPTH;
+        }
+        if (renderPass.stencilAttachment.loadAction == LoadAction::DontCare)
+        {
+            discarded[numDiscarded++] = GL_STENCIL;
         }
 
-        if (clearMask != 0)
+        if (isScissored)
         {
-            context->clear(clearMask);
+            context->disable(GL_SCISSOR_TEST);
+        }
+        if (numDiscarded > 0)
+        {
+            Framebuffer::invalidateAttachments(*context, numDiscarded, discarded.data(), renderArea);
         }
     }
+    activeRenderPass = desc;
 
     for (size_t i = 0; i < MAX_TEXTURE_UNITS; ++i)
     {
@@ -111,21 +748,49 @@ void GraphicsCommandBuffer::beginRenderPass(const RenderPassBeginDesc& desc)
     isRecordingRenderCommands = true;
 }
 
-void GraphicsCommandBuffer::endRenderPass()
+void GraphicsCommandBuffer::executeEndRenderPass()
 {
+    if (activeRenderPass.framebuffer)
+    {
+        static_cast<const Framebuffer&>(*activeRenderPass.framebuffer).unbind();
+    }
+    else
+    {
+        // the color of the default framebuffer is always kept for presentation
+        std::array<GLenum, 2> discarded{};
+        GLsizei numDiscarded = 0;
+        if (activeRenderPass.renderPass.depthAttachment.storeAction != StoreAction::Store)
+        {
+            discarded[numDiscarded++] = GL_DEPTH;
+        }
+        if (activeRenderPass.renderPass.stencilAttachment.storeAction != StoreAction::Store)
+        {
+            discarded[numDiscarded++] = GL_STENCIL;
+        }
+        if (numDiscarded > 0)
+        {
+            Framebuffer::invalidateAttachments(*context, numDiscarded, discarded.data(), activeRenderPass.renderArea);
+        }
+    }
+    activeRenderPass = {};
+
     // restore the previous state
     if (scissorEnabled)
     {
         context->enable(GL_SCISSOR_TEST);
     }
 
-    if (activeGraphicsPipeline)
+    for (auto* vertexArray : renderPassVertexArrays)
     {
-        activeGraphicsPipeline->unbindVertexAttributes();
+        vertexArray->resetBufferBindings();
     }
+    renderPassVertexArrays.clear();
+    activeVertexArray = nullptr;
+    heapBaseVertex = 0;
     activeGraphicsPipeline = nullptr;
     activeDepthStencilState = nullptr;
 
+    vertexBuffersCache.clear();
     vertexBuffersDirtyCache.clear();
     uniformBinder.clearDirtyBufferCache();
 
@@ -136,63 +801,159 @@ void GraphicsCommandBuffer::endRenderPass()
     vertTexturesDirtyCache.reset();
     fragTexturesDirtyCache.reset();
     dirtyFlags = DirtyFlag::DirtyBits_None;
+    pendingPushConstants = nullptr;
 
     isRecordingRenderCommands = false;
 }
 
-void GraphicsCommandBuffer::bindGraphicsPipeline(std::shared_ptr<IGraphicsPipeline> pipeline)
+void GraphicsCommandBuffer::executeBindGraphicsPipeline(GraphicsPipeline* pipeline)
 {
-    auto glPipeline = std::static_pointer_cast<GraphicsPipeline>(pipeline);
-    activeGraphicsPipeline = glPipeline;
+    activeGraphicsPipeline = pipeline;
     setDirty(DirtyFlag::DirtyBits_GraphicsPipeline);
 }
 
-void GraphicsCommandBuffer::bindBuffer(uint32_t index, std::shared_ptr<IBuffer> buffer, uint32_t offset)
+void GraphicsCommandBuffer::executeBindBuffer(uint32_t index, Buffer* buffer, uint32_t offset)
 {
-    auto glBuffer = std::static_pointer_cast<Buffer>(buffer);
-    auto bufferType = glBuffer->getType();
+    auto bufferType = buffer->getType();
 
     if (bufferType == Buffer::Type::Attribute)
     {
-        vertexBuffersCache.insert_or_assign(index, std::move(std::static_pointer_cast<Buffer>(buffer)));
+        vertexBuffersCache.insert_or_assign(index, std::make_pair(buffer, offset));
         vertexBuffersDirtyCache.insert(index);
     }
     else if (bufferType == Buffer::Type::Uniform)
     {
-        uniformBinder.setBuffer(index, glBuffer, offset);
+        uniformBinder.setBuffer(index, buffer, offset);
     }
 }
 
-void GraphicsCommandBuffer::draw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount)
+void GraphicsCommandBuffer::executeDraw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount, uint32_t instanceCount, uint32_t baseInstance)
 {
-    prepareForDraw();
-    context->drawArrays(toOpenGLPrimitiveType(primitiveType), vertexStart, vertexCount);
+    if (instanceCount == 0 || !prepareForDraw())
+    {
+        return;
+    }
+    if (instanceCount != 1 || baseInstance != 0)
+    {
+        context->drawArraysInstancedBaseInstance(toOpenGLPrimitiveType(primitiveType), heapBaseVertex + static_cast<GLint>(vertexStart),
+                                                 static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount), baseInstance);
+        return;
+    }
+    context->drawArrays(toOpenGLPrimitiveType(primitiveType), heapBaseVertex + static_cast<GLint>(vertexStart), vertexCount);
 }
 
-void GraphicsCommandBuffer::drawIndexed(PrimitiveType primitiveType, size_t indexCount, IndexFormat indexFormat, IBuffer& indexBuffer, size_t indexBufferOffset)
+void GraphicsCommandBuffer::executeDrawIndexed(PrimitiveType primitiveType,
+                                               size_t indexCount,
+                                               IndexFormat indexFormat,
+                                               IBuffer& indexBuffer,
+                                               size_t indexBufferOffset,
+                                               int32_t baseVertex,
+                                               uint32_t instanceCount,
+                                               uint32_t baseInstance)
 {
-    prepareForDraw();
-    auto glBuffer = dynamic_cast<ArrayBuffer*>(&indexBuffer);
-    glBuffer->bind();
-    auto* offsetPtr = reinterpret_cast<GLvoid*>(indexBufferOffset);
+    if (instanceCount == 0 || !prepareForDraw())
+    {
+        return;
+    }
+    const auto& glBuffer = static_cast<Buffer&>(indexBuffer);
+    glBuffer.getStorageBuffer().bind();
+    auto* offsetPtr = reinterpret_cast<GLvoid*>(glBuffer.getStorageOffset() + indexBufferOffset);
+    // the base vertex of the draw is relative to the bound vertex buffers, which may themselves start at a base vertex
+    baseVertex += heapBaseVertex;
+    if (instanceCount != 1 || baseInstance != 0)
+    {
+        context->drawElementsInstancedBaseVertexBaseInstance(toOpenGLPrimitiveType(primitiveType), static_cast<GLsizei>(indexCount),
+                                                             toOpenGLIndexFormat(indexFormat), offsetPtr,
+                                                             static_cast<GLsizei>(instanceCount), baseVertex, baseInstance);
+        return;
+    }
+    if (baseVertex != 0)
+    {
+        context->drawElementsBaseVertex(toOpenGLPrimitiveType(primitiveType), indexCount, toOpenGLIndexFormat(indexFormat), offsetPtr, baseVertex);
+        return;
+    }
     context->drawElements(toOpenGLPrimitiveType(primitiveType), indexCount, toOpenGLIndexFormat(indexFormat), offsetPtr);
 }
 
-void GraphicsCommandBuffer::prepareForDraw()
+void GraphicsCommandBuffer::executeDrawIndirect(PrimitiveType primitiveType, IBuffer& indirectBuffer, size_t indirectBufferOffset, uint32_t drawCount, uint32_t stride)
 {
+    if (drawCount == 0 || !prepareForDraw(false))
+    {
+        return;
+    }
+    const void* indirect = bindIndirectBuffer(indirectBuffer, indirectBufferOffset);
+    context->multiDrawArraysIndirect(toOpenGLPrimitiveType(primitiveType), indirect, static_cast<GLsizei>(drawCount), static_cast<GLsizei>(stride));
+}
+
+void GraphicsCommandBuffer::executeDrawIndexedIndirect(PrimitiveType primitiveType,
+                                                       IndexFormat indexFormat,
+                                                       IBuffer& indexBuffer,
+                                                       IBuffer& indirectBuffer,
+                                                       size_t indirectBufferOffset,
+                                                       uint32_t drawCount,
+                                                       uint32_t stride)
+{
+    if (drawCount == 0 || !prepareForDraw(false))
+    {
+        return;
+    }
+    static_cast<Buffer&>(indexBuffer).getStorageBuffer().bind();
+    const void* indirect = bindIndirectBuffer(indirectBuffer, indirectBufferOffset);
+    context->multiDrawElementsIndirect(toOpenGLPrimitiveType(primitiveType), toOpenGLIndexFormat(indexFormat), indirect,
+                                       static_cast<GLsizei>(drawCount), static_cast<GLsizei>(stride));
+}
+
+const void* GraphicsCommandBuffer::bindIndirectBuffer(IBuffer& indirectBuffer, size_t indirectBufferOffset)
+{
+    // bound to GL_DRAW_INDIRECT_BUFFER whatever its own target is (e.g. a Storage | Indirect buffer written by a
+    // compute shader), redundant binds are filtered by the context state cache
+    const auto& glBuffer = static_cast<Buffer&>(indirectBuffer);
+    context->bindBuffer(GL_DRAW_INDIRECT_BUFFER, glBuffer.getStorageBuffer().getId());
+    return reinterpret_cast<const void*>(static_cast<uintptr_t>(glBuffer.getStorageOffset() + indirectBufferOffset));
+}
+
+bool GraphicsCommandBuffer::prepareForDraw(bool allowBaseVertex)
+{
+    // the shaders of the pipeline are still compiling, its bindings stay dirty until it is ready
+    if (activeGraphicsPipeline && !activeGraphicsPipeline->isReady())
+    {
+        return false;
+    }
+
     // bind vertex buffers and graphics pipeline
     if (activeGraphicsPipeline)
     {
-        for (auto& [index, buffer] : vertexBuffersCache)
+        if (isDirty(DirtyFlag::DirtyBits_GraphicsPipeline))
+        {
+            // pipelines sharing a vertex input state share its vertex array, the attribute formats are already set
+            const auto* vertexInputState = activeGraphicsPipeline->getVertexInputState();
+            auto* vertexArray = vertexInputState ? &vertexInputState->getVertexArray() : activeVAO.get();
+            if (vertexArray != activeVertexArray)
+            {
+                vertexArray->bind();
+                activeVertexArray = vertexArray;
+                if (std::ranges::find(renderPassVertexArrays, vertexArray) == renderPassVertexArrays.end())
+                {
+                    renderPassVertexArrays.push_back(vertexArray);
+                }
+                for (const auto& [index, binding] : vertexBuffersCache)
+                {
+                    vertexBuffersDirtyCache.insert(index);
+                }
+            }
+        }
+        if (!allowBaseVertex && heapBaseVertex != 0)
         {
-            if (vertexBuffersDirtyCache.contains(index))
+            // the attributes are addressed through a base vertex the draw parameters do not include
+            for (const auto& [index, binding] : vertexBuffersCache)
             {
-                auto glBuffer = dynamic_cast<ArrayBuffer*>(buffer.get());
-                glBuffer->bind();
-                activeGraphicsPipeline->bindVertexAttributes(index, 0);
-                vertexBuffersDirtyCache.erase(index);
+                vertexBuffersDirtyCache.insert(index);
             }
         }
+        if (!vertexBuffersDirtyCache.empty())
+        {
+            bindVertexBuffers(allowBaseVertex);
+        }
 
         if (isDirty(DirtyFlag::DirtyBits_GraphicsPipeline))
         {
@@ -209,76 +970,116 @@ void GraphicsCommandBuffer::prepareForDraw()
 
     if (activeGraphicsPipeline)
     {
+        if (isDirty(DirtyFlag::DirtyBits_PushConstants))
+        {
+            // streamed once per draw that follows a change, draws in between share the range
+            const auto range = context->getPushConstantStream().write(pendingPushConstants->data.data(), pendingPushConstants->size);
+            uniformBinder.setBuffer(PUSH_CONSTANTS_BINDING, range.buffer.get(), range.offset, range.size);
+            clearDirty(DirtyFlag::DirtyBits_PushConstants);
+        }
+
         // bind uniform buffers
         uniformBinder.bindBuffers(*context);
 
-        // TODO: bind textures and samplers
-        for (size_t i = 0; i < MAX_TEXTURE_SAMPLERS; ++i)
+        // textures of both stages share the unit of their slot, the fragment binding wins if both are set. The dirty
+        // range is flushed with one call for the textures and one for the samplers.
+        const auto dirtyTextures = vertTexturesDirtyCache | fragTexturesDirtyCache;
+        if (dirtyTextures.any())
         {
-            if (!vertTexturesDirtyCache[i])
+            size_t first = 0;
+            while (!dirtyTextures[first])
             {
-                continue;
+                ++first;
             }
-            auto& textureState = vertTexturesCache[i];
-            if (auto& texture = textureState.texture)
+            size_t last = MAX_TEXTURE_SAMPLERS - 1;
+            while (!dirtyTextures[last])
             {
-//                activeGraphicsPipeline->bindTextureUnit(i, BindTarget::BindTarget_Vertex);
-                int loc = activeGraphicsPipeline->getTextureUnitLocation(i, BindTarget::BindTarget_Vertex);
-                if (loc >= 0)
-                {
-                    context->uniform1i(loc, static_cast<GLint>(i));
-                    context->activeTexture(GL_TEXTURE0 + i);
-
-//                context->uniform1i(static_cast<GLint>(i), static_cast<GLint>(textureState.textureUnit));
-//                context->activeTexture(GL_TEXTURE0 + textureState.textureUnit);
-                    texture->bind();
-                    freeTextureUnits.push(textureState.textureUnit);
-                    textureState.textureUnit = -1;
-
-                    if (auto& sampler = textureState.samplerState)
-                    {
-                        sampler->bind(texture);
-                    }
-                    vertTexturesDirtyCache.reset(i);
-                }
+                --last;
             }
-        }
-        for (size_t i = 0; i < MAX_TEXTURE_SAMPLERS; ++i)
-        {
-            if (!fragTexturesDirtyCache[i])
+
+            std::array<GLuint, MAX_TEXTURE_SAMPLERS> textures = {};
+            std::array<GLenum, MAX_TEXTURE_SAMPLERS> targets = {};
+            std::array<GLuint, MAX_TEXTURE_SAMPLERS> samplers = {};
+            for (size_t i = first; i <= last; ++i)
             {
-                continue;
+                const auto& textureState = fragTexturesCache[i].texture ? fragTexturesCache[i] : vertTexturesCache[i];
+                const auto& texture = textureState.texture;
+                // renderbuffers cannot be sampled
+                const bool sampled = texture && texture->getBufferType() == Texture::BufferType::TextureBuffer;
+                textures[i - first] = sampled ? texture->getHandle() : 0;
+                targets[i - first] = sampled ? texture->getTarget() : GL_TEXTURE_2D;
+                // a unit without sampler state samples with the parameters of the texture
+                samplers[i - first] = textureState.samplerState ? textureState.samplerState->getId() : 0;
             }
-            auto& textureState = fragTexturesCache[i];
-            if (auto& texture = textureState.texture)
+            const auto count = static_cast<GLsizei>(last - first + 1);
+            context->bindTextures(static_cast<GLuint>(first), count, textures.data(), targets.data());
+            context->bindSamplers(static_cast<GLuint>(first), count, samplers.data());
+
+            vertTexturesDirtyCache.reset();
+            fragTexturesDirtyCache.reset();
+        }
+    }
+    return true;
+}
+
+void GraphicsCommandBuffer::bindVertexBuffers(bool allowBaseVertex)
+{
+    // sub-allocated buffers placed on a whole vertex of their heap buffer are addressed through a base vertex, so
+    // switching between meshes of the same heap buffer keeps the attributes as they are. This only works if every
+    // binding starts at the same vertex, otherwise the attributes point at the data directly. The base vertex never
+    // offsets per instance attributes, their bindings always point at the data directly and are left out.
+    const auto* vertexInputState = activeGraphicsPipeline->getVertexInputState();
+    std::array<uint32_t, MAX_VERTEX_BUFFERS> strides = {};
+    std::optional<GLint> commonBaseVertex;
+    bool useBaseVertex = allowBaseVertex;
+    for (const auto& [index, binding] : vertexBuffersCache)
+    {
+        if (index >= MAX_VERTEX_BUFFERS)
+        {
+            continue;
+        }
+        if (vertexInputState && vertexInputState->isInstanceBinding(index))
+        {
+            continue;
+        }
+        const auto& buffer = *binding.first;
+        GLint bindingBaseVertex = 0;
+        if (buffer.isSubAllocated())
+        {
+            strides[index] = vertexInputState ? vertexInputState->getBindingStride(index) : 0;
+            if (strides[index] == 0 || buffer.getStorageOffset() % strides[index] != 0)
             {
-//                activeGraphicsPipeline->bindTextureUnit(i, BindTarget::BindTarget_Fragment);
-                int loc = activeGraphicsPipeline->getTextureUnitLocation(i, BindTarget::BindTarget_Fragment);
-                if (loc >= 0)
-                {
-                    context->uniform1i(loc, static_cast<GLint>(i));
-                    context->activeTexture(GL_TEXTURE0 + i);
-
-//                context->uniform1i(static_cast<GLint>(i), static_cast<GLint>(textureState.textureUnit));
-//                context->activeTexture(GL_TEXTURE0 + textureState.textureUnit);
-                    texture->bind();
-                    freeTextureUnits.push(textureState.textureUnit);
-                    textureState.textureUnit = -1;
-
-                    if (auto& sampler = textureState.samplerState)
-                    {
-                        sampler->bind(texture);
-                    }
-                    fragTexturesDirtyCache.reset(i);
-                }
+                useBaseVertex = false;
+                break;
             }
+            bindingBaseVertex = static_cast<GLint>(buffer.getStorageOffset() / strides[index]);
+        }
+        if (commonBaseVertex && *commonBaseVertex != bindingBaseVertex)
+        {
+            useBaseVertex = false;
+            break;
         }
+        commonBaseVertex = bindingBaseVertex;
     }
+    heapBaseVertex = useBaseVertex && commonBaseVertex ? *commonBaseVertex : 0;
+
+    for (const auto& [index, binding] : vertexBuffersCache)
+    {
+        if (index >= MAX_VERTEX_BUFFERS)
+        {
+            continue;
+        }
+        const auto& storage = binding.first->getStorageBuffer();
+        // the stride of the bindings left out above is 0, they are bound at their offset in the heap buffer
+        const uint32_t offset = binding.second + binding.first->getStorageOffset() - static_cast<uint32_t>(heapBaseVertex) * strides[index];
+        activeVertexArray->bindVertexBuffer(index, storage.getId(), offset);
+    }
+    vertexBuffersDirtyCache.clear();
 }
 
 void GraphicsCommandBuffer::clearPipelineResources(const std::shared_ptr<GraphicsPipeline>& newPipeline)
 {
-    auto currentGlPipeline = dynamic_cast<GraphicsPipeline*>(activeGraphicsPipeline.get());
+    auto currentGlPipeline = activeGraphicsPipeline;
     auto newGlPipeline = dynamic_cast<GraphicsPipeline*>(newPipeline.get());
 
     // later we can check if the pipeline is the same and skip the unbind/bind
@@ -286,22 +1087,21 @@ void GraphicsCommandBuffer::clearPipelineResources(const std::shared_ptr<Graphic
     if (currentGlPipeline)
     {
         currentGlPipeline->unbind();
-        currentGlPipeline->unbindVertexAttributes();
     }
 }
 
-void GraphicsCommandBuffer::bindDepthStencilState(const std::shared_ptr<IDepthStencilState>& depthStencilState)
+void GraphicsCommandBuffer::executeBindDepthStencilState(DepthStencilState* depthStencilState)
 {
-    activeDepthStencilState = std::static_pointer_cast<DepthStencilState>(depthStencilState);
+    activeDepthStencilState = depthStencilState;
     setDirty(DirtyFlag::DirtyBits_DepthStencilState);
 }
 
-void GraphicsCommandBuffer::bindViewport(const Viewport& viewport)
+void GraphicsCommandBuffer::executeBindViewport(const Viewport& viewport)
 {
     context->viewport(static_cast<GLint>(viewport.x), static_cast<GLint>(viewport.y), static_cast<GLint>(viewport.width), static_cast<GLint>(viewport.height));
 }
 
-void GraphicsCommandBuffer::bindScissor(const ScissorRect& scissor)
+void GraphicsCommandBuffer::executeBindScissor(const ScissorRect& scissor)
 {
     if (scissor.isNull())
     {
@@ -312,7 +1112,7 @@ void GraphicsCommandBuffer::bindScissor(const ScissorRect& scissor)
     context->scissor(static_cast<GLint>(scissor.x), static_cast<GLint>(scissor.y), static_cast<GLint>(scissor.width), static_cast<GLint>(scissor.height));
 }
 
-void GraphicsCommandBuffer::bindTexture(uint32_t index, uint8_t target, std::shared_ptr<ITexture> texture)
+void GraphicsCommandBuffer::executeBindTexture(uint32_t index, uint8_t target, Texture* texture)
 {
     if (freeTextureUnits.empty())
     {
@@ -323,7 +1123,7 @@ void GraphicsCommandBuffer::bindTexture(uint32_t index, uint8_t target, std::sha
     if ((target & BindTarget::BindTarget_Vertex) != 0)
     {
         auto& texState = vertTexturesCache[index];
-        texState.texture = std::static_pointer_cast<Texture>(texture);
+        texState.texture = texture;
         texState.textureUnit = index;//unit;
 //        freeTextureUnits.pop();
         vertTexturesDirtyCache.set(index);
@@ -331,27 +1131,34 @@ void GraphicsCommandBuffer::bindTexture(uint32_t index, uint8_t target, std::sha
     if ((target & BindTarget::BindTarget_Fragment) != 0)
     {
         auto& texState = fragTexturesCache[index];
-        texState.texture = std::static_pointer_cast<Texture>(texture);
+        texState.texture = texture;
         texState.textureUnit = index;//unit;
 //        freeTextureUnits.pop();
         fragTexturesDirtyCache.set(index);
     }
 }
 
-void GraphicsCommandBuffer::bindSamplerState(uint32_t index, uint8_t target, std::shared_ptr<ISamplerState> samplerState)
+void GraphicsCommandBuffer::executeBindSamplerState(uint32_t index, uint8_t target, SamplerState* samplerState)
 {
     if ((target & BindTarget::BindTarget_Vertex) != 0)
     {
-        vertTexturesCache[index].samplerState = std::static_pointer_cast<SamplerState>(samplerState);
+        vertTexturesCache[index].samplerState = samplerState;
         vertTexturesDirtyCache.set(index);
     }
     if ((target & BindTarget::BindTarget_Fragment) != 0)
     {
-        fragTexturesCache[index].samplerState = std::static_pointer_cast<SamplerState>(samplerState);
+        fragTexturesCache[index].samplerState = samplerState;
         fragTexturesDirtyCache.set(index);
     }
 }
 
+void GraphicsCommandBuffer::executePushConstants(const PushConstantBlock& block)
+{
+    // streamed by the next draw, the calls in between only replace the pending block
+    pendingPushConstants = &block;
+    setDirty(DirtyFlag::DirtyBits_PushConstants);
+}
+
 bool GraphicsCommandBuffer::isDirty(opengl::GraphicsCommandBuffer::DirtyFlag flag) const
 {
     return dirtyFlags & flag;
@@ -5,7 +5,9 @@
 #pragma once
 
 
+#include "CommandStream.h"
 #include "DepthStencilState.h"
+#include "DrawSorter.h"
 #include "GraphicsPipeline.h"
 #include "SamplerState.h"
 #include "Texture.h"
@@ -24,18 +26,31 @@
 #include <bitset>
 #include <set>
 #include <queue>
+#include <vector>
 
 namespace opengl {
 
+class CommandBufferList;
+
 class GraphicsCommandBuffer : public IGraphicsCommandBuffer
 {
+    friend class CommandBufferList;
+    friend class CommandQueue;
+    friend class CommandPool;
+
     struct TextureState
     {
-        std::shared_ptr<Texture> texture = nullptr;
-        std::shared_ptr<SamplerState> samplerState = nullptr;
+        Texture* texture = nullptr;
+        SamplerState* samplerState = nullptr;
         int textureUnit = -1;
     };
     using TextureStates = std::array<TextureState, MAX_TEXTURE_SAMPLERS>;
+    struct PushConstantBlock
+    {
+        std::array<std::byte, MAX_PUSH_CONSTANTS_SIZE> data = {};
+        // bytes written since begin(), rounded up to a vec4, only these are streamed
+        uint32_t size = 0;
+    };
 
     enum DirtyFlag : uint32_t
     {
@@ -44,6 +59,7 @@ class GraphicsCommandBuffer : public IGraphicsCommandBuffer
         DirtyBits_DepthStencilState = 1 << 2,
         DirtyBits_Viewport = 1 << 3,
         DirtyBits_Scissor = 1 << 4,
+        DirtyBits_PushConstants = 1 << 5,
     };
 
     enum class RecordState
@@ -57,30 +73,121 @@ public:
 
     explicit GraphicsCommandBuffer(const std::shared_ptr<Context>& context);
 
+    /**
+     * @brief Prepares the command buffer for a new recording, called by the command pool on acquire.
+     */
+    void begin(const CommandBufferDesc& desc);
+
+    /**
+     * @brief Replays the recorded commands of a deferred command buffer, must be called on the GL thread.
+     */
+    void execute();
+
+    [[nodiscard]] bool isDeferred() const
+    {
+        return recordingMode == RecordingMode::Deferred;
+    }
+
     void beginRenderPass(const RenderPassBeginDesc& renderPass) override;
     void endRenderPass() override;
     void bindGraphicsPipeline(std::shared_ptr<IGraphicsPipeline> pipeline) override;
     void bindBuffer(uint32_t index, std::shared_ptr<IBuffer> buffer, uint32_t offset) override;
     void draw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount) override;
-    void drawIndexed(PrimitiveType primitiveType, size_t indexCount, IndexFormat indexFormat, IBuffer& indexBuffer, size_t indexBufferOffset) override;
+    void drawIndexed(PrimitiveType primitiveType, size_t indexCount, IndexFormat indexFormat, IBuffer& indexBuffer, size_t indexBufferOffset, int32_t baseVertex) override;
+    void drawInstanced(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount, size_t instanceCount, size_t baseInstance) override;
+    void drawIndexedInstanced(PrimitiveType primitiveType, size_t indexCount, IndexFormat indexFormat, IBuffer& indexBuffer, size_t indexBufferOffset, int32_t baseVertex, size_t instanceCount, size_t baseInstance) override;
+    void drawIndirect(PrimitiveType primitiveType, IBuffer& indirectBuffer, size_t indirectBufferOffset, uint32_t drawCount, uint32_t stride) override;
+    void drawIndexedIndirect(PrimitiveType primitiveType, IndexFormat indexFormat, IBuffer& indexBuffer, IBuffer& indirectBuffer, size_t indirectBufferOffset, uint32_t drawCount, uint32_t stride) override;
     void bindViewport(const Viewport& viewport) override;
     void bindScissor(const ScissorRect& scissor) override;
     void bindDepthStencilState(const std::shared_ptr<IDepthStencilState>& depthStencilState) override;
     void bindTexture(uint32_t index, uint8_t target, std::shared_ptr<ITexture> texture) override;
     void bindSamplerState(uint32_t index, uint8_t target, std::shared_ptr<ISamplerState> samplerState) override;
+    void pushConstants(uint8_t target, uint32_t offset, const void* data, uint32_t size) override;
+    void memoryBarrier(uint32_t barriers) override;
+    void setDrawSortHint(const DrawSortHint& hint) override;
 
 private:
+    void executeBeginRenderPass(const RenderPassBeginDesc& desc);
+    void executeEndRenderPass();
+    void executeBindGraphicsPipeline(GraphicsPipeline* pipeline);
+    void executeBindBuffer(uint32_t index, Buffer* buffer, uint32_t offset);
+    void executeDraw(PrimitiveType primitiveType, size_t vertexStart, size_t vertexCount, uint32_t instanceCount, uint32_t baseInstance);
+    void executeDrawIndexed(PrimitiveType primitiveType, size_t indexCount, IndexFormat indexFormat, IBuffer& indexBuffer, size_t indexBufferOffset, int32_t baseVertex, uint32_t instanceCount, uint32_t baseInstance);
+    void executeDrawIndirect(PrimitiveType primitiveType, IBuffer& indirectBuffer, size_t indirectBufferOffset, uint32_t drawCount, uint32_t stride);
+    void executeDrawIndexedIndirect(PrimitiveType primitiveType, IndexFormat indexFormat, IBuffer& indexBuffer, IBuffer& indirectBuffer, size_t indirectBufferOffset, uint32_t drawCount, uint32_t stride);
+    void executeBindViewport(const Viewport& viewport);
+    void executeBindScissor(const ScissorRect& scissor);
+    void executeBindDepthStencilState(DepthStencilState* depthStencilState);
+    void executeBindTexture(uint32_t index, uint8_t target, Texture* texture);
+    void executeBindSamplerState(uint32_t index, uint8_t target, SamplerState* samplerState);
+    void executePushConstants(const PushConstantBlock& block);
+
+    // writes the draws of a reordered render pass to the command stream, with the binds each of them needs
+    void writeSortedDraws();
+    void writeStateChanges(const DrawSorter::DrawState* previous, const DrawSorter::DrawState& state);
+
+    // keeps a resource alive until the command buffer is recorded again, returns its slot in retainedResources. The
+    // resource is stored as a T, the shared pointer is only copied the first time it is retained.
+    template<typename T, typename U>
+    uint32_t retainResource(const std::shared_ptr<U>& resource)
+    {
+        if (!resource)
+        {
+            return INVALID_RESOURCE_SLOT;
+        }
+        auto* typed = static_cast<T*>(resource.get());
+        auto [it, inserted] = retainedResourceSlots.try_emplace(typed, static_cast<uint32_t>(retainedResources.size()));
+        if (inserted)
+        {
+            retainedResources.push_back(std::static_pointer_cast<T>(resource));
+        }
+        return it->second;
+    }
+    // retains a buffer passed by reference if a shared_ptr owns it, otherwise only its address is kept
+    uint32_t retainBuffer(IBuffer& buffer);
+    template<typename T>
+    T* getRetainedResource(uint32_t slot) const
+    {
+        return slot == INVALID_RESOURCE_SLOT ? nullptr : static_cast<T*>(retainedResources[slot].get());
+    }
+
     void clearPipelineResources(const std::shared_ptr<GraphicsPipeline>& newPipeline);
-    void prepareForDraw();
+    // returns false if the draw has to be skipped because the bound pipeline is not ready yet. Without
+    // allowBaseVertex the vertex attributes point at the data of sub-allocated vertex buffers directly, for draws
+    // whose parameters cannot be offset by a base vertex (e.g. indirect draws).
+    bool prepareForDraw(bool allowBaseVertex = true);
+    void bindVertexBuffers(bool allowBaseVertex);
+    // binds the GL buffer object of an Indirect buffer, returns the offset of indirectBufferOffset inside of it
+    const void* bindIndirectBuffer(IBuffer& indirectBuffer, size_t indirectBufferOffset);
 
     bool isDirty(DirtyFlag flag) const;
     void setDirty(DirtyFlag flag);
     void clearDirty(DirtyFlag flag);
 
 private:
+    static constexpr uint32_t INVALID_RESOURCE_SLOT = ~0u;
+
     std::shared_ptr<Context> context;
+
+    RecordingMode recordingMode = RecordingMode::Immediate;
+    uint32_t submissionOrder = 0;
+    CommandStream commands;
+    std::vector<std::shared_ptr<void>> retainedResources;
+    std::unordered_map<const void*, uint32_t> retainedResourceSlots;
+
+    DrawSorter drawSorter;
+    DrawSortHint drawSortHint;
+    // push constants seen by the next draw, and a copy of them for every pushConstants call of a deferred recording
+    PushConstantBlock pushConstantData = {};
+    std::vector<PushConstantBlock> pushConstantBlocks;
+    // block streamed by the next draw, pushConstantData or one of pushConstantBlocks during execute()
+    const PushConstantBlock* pendingPushConstants = nullptr;
     std::set<uint32_t> vertexBuffersDirtyCache;
-    std::unordered_map<uint32_t, std::shared_ptr<Buffer>> vertexBuffersCache;
+    // buffer and byte offset of each vertex buffer binding
+    std::unordered_map<uint32_t, std::pair<Buffer*, uint32_t>> vertexBuffersCache;
+    // first vertex of the bound sub-allocated vertex buffers inside of their heap buffer, added to every draw
+    GLint heapBaseVertex = 0;
 
     std::bitset<MAX_TEXTURE_SAMPLERS> vertTexturesDirtyCache;
     std::bitset<MAX_TEXTURE_SAMPLERS> fragTexturesDirtyCache;
@@ -91,9 +198,13 @@ private:
     std::queue<int> freeTextureUnits;
 
     // std::shared_ptr<Framebuffer> activeFramebuffer;
-    std::shared_ptr<GraphicsPipeline> activeGraphicsPipeline = nullptr;
+    GraphicsPipeline* activeGraphicsPipeline = nullptr;
+    // empty vertex array bound for pipelines without vertex input, the others use the one of their input state
     std::shared_ptr<VertexArrayObject> activeVAO = nullptr;
-    std::shared_ptr<DepthStencilState> activeDepthStencilState = nullptr;
+    VertexArrayObject* activeVertexArray = nullptr;
+    // vertex arrays bound during the render pass, their buffer bindings are only trusted until it ends
+    std::vector<VertexArrayObject*> renderPassVertexArrays;
+    DepthStencilState* activeDepthStencilState = nullptr;
 
     UniformBinder uniformBinder;
 
@@ -102,6 +213,13 @@ private:
     bool scissorEnabled = false;
 
     bool isRecordingRenderCommands = false;
+    // store actions are applied when the render pass ends
+    RenderPassBeginDesc activeRenderPass;
+
+    // hand-off state between a recording thread and the GL thread, see CommandQueue
+    GraphicsCommandBuffer* nextInList = nullptr;
+    uint64_t submissionKey = 0;
+    std::weak_ptr<CommandBufferList> recycleList;
 };
 
 }// namespace opengl
\ No newline at end of file
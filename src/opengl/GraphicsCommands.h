@@ -0,0 +1,161 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/Common.h"
+#include "graphicsAPI/common/RenderPass.h"
+#include "graphicsAPI/common/Util.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class IBuffer;
+
+namespace opengl {
+
+// Packets of the deferred command stream, resources are referenced through their retained resource slot
+enum class CommandType : uint16_t
+{
+    BeginRenderPass,
+    EndRenderPass,
+    BindGraphicsPipeline,
+    BindBuffer,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    DrawIndexedIndirect,
+    BindViewport,
+    BindScissor,
+    BindDepthStencilState,
+    BindTexture,
+    BindSamplerState,
+    PushConstants,
+    Barrier,
+};
+
+struct BeginRenderPassCommand
+{
+    static constexpr CommandType TYPE = CommandType::BeginRenderPass;
+    uint32_t framebuffer;
+    uint32_t colorAttachmentCount;
+    std::array<RenderPassDesc::ColorAttachmentDesc, MAX_COLOR_ATTACHMENTS> colorAttachments;
+    RenderPassDesc::DepthAttachmentDesc depthAttachment;
+    RenderPassDesc::StencilAttachmentDesc stencilAttachment;
+    ScissorRect renderArea;
+};
+
+struct EndRenderPassCommand
+{
+    static constexpr CommandType TYPE = CommandType::EndRenderPass;
+};
+
+struct BindGraphicsPipelineCommand
+{
+    static constexpr CommandType TYPE = CommandType::BindGraphicsPipeline;
+    uint32_t pipeline;
+};
+
+struct BindBufferCommand
+{
+    static constexpr CommandType TYPE = CommandType::BindBuffer;
+    uint32_t index;
+    uint32_t buffer;
+    uint32_t offset;
+};
+
+struct DrawCommand
+{
+    static constexpr CommandType TYPE = CommandType::Draw;
+    PrimitiveType primitiveType;
+    size_t vertexStart;
+    size_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t baseInstance;
+};
+
+struct DrawIndexedCommand
+{
+    static constexpr CommandType TYPE = CommandType::DrawIndexed;
+    PrimitiveType primitiveType;
+    IndexFormat indexFormat;
+    size_t indexCount;
+    uint32_t indexBuffer;
+    size_t indexBufferOffset;
+    int32_t baseVertex;
+    uint32_t instanceCount;
+    uint32_t baseInstance;
+};
+
+struct DrawIndirectCommand
+{
+    static constexpr CommandType TYPE = CommandType::DrawIndirect;
+    PrimitiveType primitiveType;
+    uint32_t indirectBuffer;
+    size_t indirectBufferOffset;
+    uint32_t drawCount;
+    uint32_t stride;
+};
+
+struct DrawIndexedIndirectCommand
+{
+    static constexpr CommandType TYPE = CommandType::DrawIndexedIndirect;
+    PrimitiveType primitiveType;
+    IndexFormat indexFormat;
+    uint32_t indexBuffer;
+    uint32_t indirectBuffer;
+    size_t indirectBufferOffset;
+    uint32_t drawCount;
+    uint32_t stride;
+};
+
+struct BindViewportCommand
+{
+    static constexpr CommandType TYPE = CommandType::BindViewport;
+    Viewport viewport;
+};
+
+struct BindScissorCommand
+{
+    static constexpr CommandType TYPE = CommandType::BindScissor;
+    ScissorRect scissor;
+};
+
+struct BindDepthStencilStateCommand
+{
+    static constexpr CommandType TYPE = CommandType::BindDepthStencilState;
+    uint32_t depthStencilState;
+};
+
+struct BindTextureCommand
+{
+    static constexpr CommandType TYPE = CommandType::BindTexture;
+    uint32_t index;
+    uint8_t target;
+    uint32_t texture;
+};
+
+struct BindSamplerStateCommand
+{
+    static constexpr CommandType TYPE = CommandType::BindSamplerState;
+    uint32_t index;
+    uint8_t target;
+    uint32_t samplerState;
+};
+
+struct PushConstantsCommand
+{
+    static constexpr CommandType TYPE = CommandType::PushConstants;
+    // index of the block in the push constant blocks of the command buffer
+    uint32_t block;
+};
+
+struct BarrierCommand
+{
+    static constexpr CommandType TYPE = CommandType::Barrier;
+    uint32_t barriers;
+};
+
+}// namespace opengl
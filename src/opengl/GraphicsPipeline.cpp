@@ -7,18 +7,37 @@
 #include "VertexInputState.h"
 #include "graphicsAPI/common/GraphicsCommandBuffer.h"
 
+#include <algorithm>
+
 namespace opengl {
 
 GraphicsPipeline::GraphicsPipeline(Context& context, const GraphicsPipelineDesc& desc_) : desc(desc_), WithContext(context)
 {
-    activeBindingAttribLocations.reserve(64);
-    unitSamplerLocations.fill(-1);
-    this->initialize();
+    vertexInputState = dynamic_cast<VertexInputState*>(desc.vertexInputState.get());
+
+    if (!dynamic_cast<const PipelineShaderStages*>(desc.shaderStages.get()))
+    {
+        throw std::runtime_error("GraphicsPipelineDesc::shaderStages is required");
+    }
+    // the program of linkAsync stages can still be linking, reflection has to wait until it is done
+    if (desc.shaderStages->isReady())
+    {
+        this->initialize();
+    }
+}
+
+bool GraphicsPipeline::isReady()
+{
+    if (!initialized && desc.shaderStages->isReady())
+    {
+        initialize();
+    }
+    return initialized;
 }
 
 void GraphicsPipeline::initialize()
 {
-    const auto& shaderStages = dynamic_cast<const PipelineShaderStages*>(desc.shaderStages.get());
+    auto* shaderStages = dynamic_cast<PipelineShaderStages*>(desc.shaderStages.get());
     if (!shaderStages)
     {
         throw std::runtime_error("GraphicsPipelineDesc::shaderStages is required");
@@ -29,55 +48,35 @@ void GraphicsPipeline::initialize()
         throw std::runtime_error("GraphicsPipelineDesc::shaderStages::program is required");
     }
 
-    reflection = std::make_shared<GraphicsPipelineReflection>(getContext(), *shaderStages);
+    reflection = shaderStages->getReflection();
 
-    // Setup the vertex attributes
-    const auto& vertexInput = dynamic_cast<const VertexInputState*>(desc.vertexInputState.get());
-    if (vertexInput)
+    // Setup the texture units, the slots of both stages share the texture unit of their index
+    samplerUnits.clear();
+    for (const auto* unitSamplerMap : {&desc.vertexUnitSamplerMap, &desc.fragmentUnitSamplerMap})
     {
-        for (const auto& [bindingIndex, bindingAttribs]: vertexInput->getBufferAttribMap())
+        for (const auto& [unit, samplerName] : *unitSamplerMap)
         {
-            for (int i = 0; i < bindingAttribs.size(); ++i)
+            GLint loc = reflection->getLocation(samplerName);
+            if (loc >= 0 && unit < MAX_TEXTURE_SAMPLERS)
             {
-                const auto& location = bindingAttribs[i].location;
-                if (location < 0)
-                {
-//                    throw std::runtime_error(fmt::format("Invalid location for vertex attribute: {}", location));
-                }
-                bindingAttribLocations[bindingIndex].push_back(location);
+                samplerUnits.emplace_back(loc, static_cast<GLint>(unit));
+            }
+            else
+            {
+                // log warning
+                std::cout << "Warning: No sampler found with name: " << samplerName << std::endl;
             }
         }
     }
-
-    // Setup the texture units
-    for (const auto& [unit, samplerName] : desc.fragmentUnitSamplerMap)
-    {
-        GLint loc = reflection->getLocation(samplerName);
-        if (loc >= 0)
-        {
-            unitSamplerLocations[unit] = loc;
-        }
-        else
-        {
-            // log warning
-            std::cout << "Warning: No sampler found with name: " << samplerName << std::endl;
-        }
-    }
-
-    // Setup the texture units
-    for (const auto& [unit, samplerName] : desc.vertexUnitSamplerMap)
+    // the maps are unordered, sort so that equal mappings hash the same
+    std::ranges::sort(samplerUnits);
+    samplerUnitsHash = 0;
+    for (const auto& [location, unit] : samplerUnits)
     {
-        GLint loc = reflection->getLocation(samplerName);
-        if (loc >= 0)
-        {
-            unitSamplerLocations[unit] = loc;
-        }
-        else
-        {
-            // log warning
-            std::cout << "Warning: No sampler found with name: " << samplerName << std::endl;
-        }
+        hash_combine(samplerUnitsHash, location);
+        hash_combine(samplerUnitsHash, unit);
     }
+    shaderStages->setSamplerUnits(samplerUnitsHash, samplerUnits);
 
     // Setup the blend state
     if (!desc.colorBlendAttachmentStates.empty())
@@ -107,6 +106,7 @@ void GraphicsPipeline::initialize()
     cullMode = desc.rasterizationState.cullMode;
     frontFace = desc.rasterizationState.frontFace;
     fillMode = desc.rasterizationState.polygonFillMode;
+    initialized = true;
 }
 
 void GraphicsPipeline::bind()
@@ -114,6 +114,7 @@ void GraphicsPipeline::bind()
     if (auto shaderStages = dynamic_cast<PipelineShaderStages*>(desc.shaderStages.get()))
     {
         shaderStages->bind();
+        shaderStages->setSamplerUnits(samplerUnitsHash, samplerUnits);
     }
 
     getContext().colorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
@@ -151,100 +152,6 @@ void GraphicsPipeline::unbind()
     }
 }
 
-void GraphicsPipeline::bindTextureUnit(const size_t unit, uint8_t bindTarget)
-{
-    if (!desc.shaderStages)
-    {
-        return;
-    }
-
-    if (unit >= MAX_TEXTURE_SAMPLERS)
-    {
-        return;
-    }
-
-    GLint samplerLocation = -1;
-    if (bindTarget == BindTarget::BindTarget_Vertex)
-    {
-        samplerLocation = unitSamplerLocations[unit]; // todo figure out what to do with this?
-    }
-    else
-    {
-        samplerLocation = unitSamplerLocations[unit];
-    }
-
-    if (samplerLocation >= 0)
-    {
-        getContext().uniform1i(samplerLocation, static_cast<GLint>(unit));
-        getContext().activeTexture(GL_TEXTURE0 + unit);
-    }
-    else
-    {
-        // log warning
-        std::cout << "Warning: No sampler found for texture unit: " << unit << std::endl;
-    }
-
-}
-
-int GraphicsPipeline::getTextureUnitLocation(const size_t unit, uint8_t bindTarget)
-{
-    if (unit >= MAX_TEXTURE_SAMPLERS)
-    {
-        return -1;
-    }
-
-    GLint samplerLocation = -1;
-    if (bindTarget == BindTarget::BindTarget_Vertex)
-    {
-        samplerLocation = unitSamplerLocations[unit];
-    }
-    else
-    {
-        samplerLocation = unitSamplerLocations[unit];
-    }
-
-    return samplerLocation;
-}
-
-void GraphicsPipeline::bindVertexAttributes(size_t bufferIndex, size_t offset)
-{
-    const auto& vertexInput = dynamic_cast<const VertexInputState*>(desc.vertexInputState.get());
-    if (vertexInput)
-    {
-        const auto& bindingAttribs = vertexInput->getBufferAttributes(bufferIndex);
-        auto& locations = bindingAttribLocations[bufferIndex];
-        for (int i = 0; i < bindingAttribs.size(); ++i)
-        {
-            const auto location = locations[i];
-            if (location < 0)
-            {
-                continue;
-            }
-            activeBindingAttribLocations.push_back(location);
-
-            const auto& attrib = bindingAttribs[i];
-            getContext().enableVertexAttribArray(location);
-            getContext().vertexAttribPointer(
-                    location,
-                    attrib.numComponents,
-                    attrib.type,
-                    attrib.normalized,
-                    attrib.stride,
-                    reinterpret_cast<const char*>(attrib.offset) + offset);
-//            std::cout << "Enabling vertex attrib array: " << location << std::endl;
-        }
-    }
-}
-
-void GraphicsPipeline::unbindVertexAttributes()
-{
-    for (const auto& location : activeBindingAttribLocations)
-    {
-//        std::cout << "Disabling vertex attrib array: " << location << std::endl;
-        getContext().disableVertexAttribArray(location);
-    }
-    activeBindingAttribLocations.clear();
-}
 GLenum GraphicsPipeline::convertBlendOp(BlendOp value) {
     // sets blending equation for both RGA and Alpha
     switch (value) {
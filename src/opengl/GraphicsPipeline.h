@@ -13,10 +13,13 @@
 #include <map>
 #include <array>
 #include <queue>
+#include <utility>
+#include <vector>
 
 namespace opengl
 {
 
+class VertexInputState;
 
 struct BlendMode {
     GLenum blendOpColor;
@@ -32,18 +35,20 @@ class GraphicsPipeline : public IGraphicsPipeline, public WithContext
 public:
     GraphicsPipeline(Context& context, const GraphicsPipelineDesc& desc_);
 
+    /**
+     * @brief Sets the pipeline up from its linked program, deferred until the shader stages are ready.
+     */
     void initialize();
 
+    [[nodiscard]] bool isReady() override;
+
     void bind();
     void unbind();
-    void bindTextureUnit(size_t unit, uint8_t bindTarget);
-    int getTextureUnitLocation(size_t unit, uint8_t bindTarget);
-
     void bindTextureSamplerAndUnit(size_t location, uint8_t bindTarget);
     void unbindTextureUnit(size_t location, uint8_t bindTarget);
 
-    void bindVertexAttributes(size_t bufferIndex, size_t offset);
-    void unbindVertexAttributes();
+    // nullptr if the pipeline has no vertex input
+    [[nodiscard]] VertexInputState* getVertexInputState() const { return vertexInputState; }
 
     [[nodiscard]] const GraphicsPipelineReflection& getReflection() const { return *reflection; }
     [[nodiscard]] const GraphicsPipelineDesc& getDesc() const override { return this->desc; }
@@ -54,11 +59,11 @@ public:
 private:
     GraphicsPipelineDesc desc;
 
-    std::map<uint32_t, std::vector<uint32_t>> bindingAttribLocations;
-    std::vector<uint32_t> activeBindingAttribLocations;
-    std::array<GLint, MAX_TEXTURE_SAMPLERS> unitSamplerLocations;
+    VertexInputState* vertexInputState = nullptr;
+    // {location, texture unit} of the sampler uniforms, written to the program once instead of on every bind
+    std::vector<std::pair<GLint, GLint>> samplerUnits;
+    size_t samplerUnitsHash = 0;
 
-//    std::vector<uint32_t> bindingAttribLocations;
     std::shared_ptr<GraphicsPipelineReflection> reflection;
 
     std::array<GLboolean, 4> colorMask = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
@@ -67,6 +72,7 @@ private:
     FrontFace frontFace = FrontFace::CounterClockwise;
     PolygonFillMode fillMode = PolygonFillMode::Fill;
     bool blendEnabled = false;
+    bool initialized = false;
 };
 
 }
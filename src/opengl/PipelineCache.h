@@ -0,0 +1,110 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/opengl/PipelineCacheStats.h"
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace opengl {
+
+/**
+ * @brief LRU cache of pipeline objects keyed on their full description.
+ *
+ * Descriptions are looked up by DescHash and compared with operator==, so a hash collision never returns the pipeline
+ * of another description. The cache owns a reference to its pipelines, the least recently used one is dropped once
+ * the capacity is exceeded (pipelines still referenced elsewhere stay alive, they are just created again on the next
+ * request).
+ */
+template<typename Desc, typename DescHash, typename Pipeline>
+class PipelineCache
+{
+public:
+    explicit PipelineCache(size_t capacity)
+        : capacity(capacity)
+    {}
+
+    /**
+     * @brief Returns the cached pipeline of desc, or creates it with create(desc) and caches it.
+     */
+    template<typename CreateFn>
+    std::shared_ptr<Pipeline> getOrCreate(const Desc& desc, CreateFn&& create)
+    {
+        if (capacity == 0)
+        {
+            ++stats.misses;
+            return create(desc);
+        }
+
+        if (auto it = entries.find(desc); it != entries.end())
+        {
+            ++stats.hits;
+            // most recently used entries are kept at the front
+            lru.splice(lru.begin(), lru, it->second.lruPosition);
+            return it->second.pipeline;
+        }
+
+        ++stats.misses;
+        auto pipeline = create(desc);
+        auto [it, inserted] = entries.try_emplace(desc, Entry{pipeline, {}});
+        lru.push_front(&it->first);
+        it->second.lruPosition = lru.begin();
+        evict();
+        return pipeline;
+    }
+
+    /**
+     * @brief Changes the maximum number of cached pipelines, 0 disables the cache.
+     */
+    void setCapacity(size_t capacity_)
+    {
+        capacity = capacity_;
+        evict();
+    }
+
+    void clear()
+    {
+        entries.clear();
+        lru.clear();
+        stats.size = 0;
+    }
+
+    [[nodiscard]] const PipelineCacheStats& getStats() const
+    {
+        return stats;
+    }
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<Pipeline> pipeline;
+        typename std::list<const Desc*>::iterator lruPosition;
+    };
+
+    void evict()
+    {
+        while (entries.size() > capacity)
+        {
+            entries.erase(*lru.back());
+            lru.pop_back();
+            ++stats.evictions;
+        }
+        stats.size = entries.size();
+    }
+
+private:
+    size_t capacity;
+    // keys of the entries, most recently used first. Node based map keys have stable addresses.
+    std::list<const Desc*> lru;
+    std::unordered_map<Desc, Entry, DescHash> entries;
+    PipelineCacheStats stats;
+};
+
+}// namespace opengl
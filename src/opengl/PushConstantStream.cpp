@@ -0,0 +1,78 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "PushConstantStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace opengl {
+
+PushConstantStream::PushConstantStream(Context& context)
+    : context(context)
+{
+}
+
+void PushConstantStream::initialize()
+{
+    isRing = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+    createBuffer(BUFFER_SIZE);
+
+    GLint offsetAlignment = 0;
+    context.getIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    alignment = std::max<uint32_t>(16, offsetAlignment);
+}
+
+void PushConstantStream::createBuffer(uint32_t size)
+{
+    BufferDesc desc;
+    desc.type = BufferDesc::BufferTypeBits::Uniform;
+    desc.size = size;
+    desc.storage = isRing ? ResourceStorage::Ring : ResourceStorage::Shared;
+    buffer = std::make_shared<ArrayBuffer>(context);
+    buffer->initialize(desc);
+}
+
+PushConstantStream::Range PushConstantStream::write(const void* data, uint32_t size)
+{
+    if (!buffer)
+    {
+        initialize();
+    }
+
+    if (isRing)
+    {
+        if (!retiredBuffers.empty() && context.getFrameIndex() != retiredFrameIndex)
+        {
+            retiredBuffers.clear();
+        }
+        auto allocation = buffer->tryAllocate(size);
+        while (!allocation)
+        {
+            // the pushes of this frame fill the ring, the GPU may still read all of it
+            if (buffer->getSize() >= MAX_BUFFER_SIZE)
+            {
+                throw std::runtime_error("Push constant stream too small for the pushes of a single frame");
+            }
+            retiredBuffers.push_back(buffer);
+            retiredFrameIndex = context.getFrameIndex();
+            createBuffer(static_cast<uint32_t>(buffer->getSize() * 2));
+            allocation = buffer->tryAllocate(size);
+        }
+        std::memcpy(allocation->data, data, size);
+        return {buffer, allocation->offset, size};
+    }
+
+    uint32_t offset = (head + alignment - 1) / alignment * alignment;
+    if (offset + size > BUFFER_SIZE)
+    {
+        offset = 0;
+    }
+    buffer->data(data, size, offset);
+    head = offset + size;
+    return {buffer, offset, size};
+}
+
+}// namespace opengl
@@ -0,0 +1,63 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/opengl/Buffer.h"
+#include "graphicsAPI/opengl/Context.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace opengl {
+
+/**
+ * @brief Streaming uniform buffer holding the push constants of the draws and dispatches of a frame.
+ *
+ * Every write copies the block into the next free range of the buffer, which the command buffers bind with its offset
+ * at PUSH_CONSTANTS_BINDING. The buffer is a ResourceStorage::Ring buffer when persistent mapping is available, so a
+ * write is a memcpy into mapped memory. A frame filling the ring moves on to a new ring of twice the size, the full one
+ * is released once the frame ends. Otherwise the ranges are written with bufferSubData and the buffer is consumed
+ * linearly, starting over at its beginning once it is full.
+ */
+class PushConstantStream
+{
+public:
+    static constexpr uint32_t BUFFER_SIZE = 4 * 1024 * 1024;
+    static constexpr uint32_t MAX_BUFFER_SIZE = 256 * 1024 * 1024;
+
+    struct Range
+    {
+        std::shared_ptr<Buffer> buffer;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    explicit PushConstantStream(Context& context);
+
+    /**
+     * @brief Copies size bytes of data into the buffer, must be called on the GL thread. The range stays valid until
+     * the end of the frame.
+     */
+    Range write(const void* data, uint32_t size);
+
+private:
+    void initialize();
+    void createBuffer(uint32_t size);
+
+private:
+    Context& context;
+
+    // created on first use, the stream is constructed with the context before GL is available
+    std::shared_ptr<ArrayBuffer> buffer;
+    // rings filled by the frame being recorded, their ranges stay bound until the frame ends
+    std::vector<std::shared_ptr<ArrayBuffer>> retiredBuffers;
+    uint64_t retiredFrameIndex = 0;
+    bool isRing = false;
+    uint32_t alignment = 0;
+    uint32_t head = 0;
+};
+
+}// namespace opengl
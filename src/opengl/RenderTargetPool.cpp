@@ -0,0 +1,189 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "RenderTargetPool.h"
+
+#include "graphicsAPI/opengl/Device.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace opengl {
+
+namespace {
+
+size_t estimateSize(const ITexture& texture)
+{
+    const auto properties = TextureFormatProperties::fromTextureFormat(texture.getFormat());
+    const size_t size = properties.getBytesPerRange(texture.getFullRange(0, texture.getNumMipLevels())) * texture.getSamples();
+    return texture.getType() == TextureType::TextureCube ? size * 6 : size;
+}
+
+bool references(const FramebufferDesc& desc, const ITexture* texture)
+{
+    auto attaches = [texture](const FramebufferAttachmentDesc& attachment) {
+        return attachment.texture.get() == texture || attachment.resolveTexture.get() == texture;
+    };
+    return attaches(desc.depthAttachment) || attaches(desc.stencilAttachment) ||
+           std::ranges::any_of(desc.colorAttachments, [&attaches](const auto& attachment) { return attaches(attachment.second); });
+}
+
+}// namespace
+
+RenderTargetPool::RenderTargetPool(Device& device)
+    : device(device)
+    , frameIndex(device.getContext().getFrameIndex())
+{
+}
+
+std::shared_ptr<ITexture> RenderTargetPool::acquireTexture(const TextureDesc& desc)
+{
+    updateFrame();
+
+    auto it = std::ranges::find_if(textures, [&desc](const TextureEntry& entry) {
+        return entry.lease.expired() && entry.desc == desc;
+    });
+    if (it != textures.end())
+    {
+        ++stats.hits;
+    }
+    else
+    {
+        auto texture = device.createTexture(desc);
+        if (!texture)
+        {
+            throw std::runtime_error("Failed to create render target texture");
+        }
+        const size_t size = estimateSize(*texture);
+        it = textures.insert(textures.end(), {desc, std::move(texture), {}, size, 0});
+        ++stats.misses;
+        stats.memory += size;
+        stats.textureCount = textures.size();
+    }
+
+    // the lease has its own reference count, the pooled texture is free again once every copy of it is released
+    std::shared_ptr<ITexture> lease(it->texture.get(), [texture = it->texture](ITexture*) {});
+    it->lease = lease;
+    it->lastUsedFrame = frameIndex;
+    return lease;
+}
+
+std::shared_ptr<IFramebuffer> RenderTargetPool::acquireFramebuffer(const FramebufferDesc& desc)
+{
+    updateFrame();
+
+    const FramebufferDesc resolvedDesc = resolveAttachments(desc);
+    auto it = std::ranges::find_if(framebuffers, [&resolvedDesc](const FramebufferEntry& entry) {
+        return entry.desc == resolvedDesc;
+    });
+    if (it != framebuffers.end())
+    {
+        ++stats.hits;
+        it->lastUsedFrame = frameIndex;
+        // framebuffers with the same attachments are interchangeable, share the one in use
+        if (auto lease = it->lease.lock())
+        {
+            return lease;
+        }
+    }
+    else
+    {
+        auto framebuffer = device.createFramebuffer(resolvedDesc);
+        it = framebuffers.insert(framebuffers.end(), {resolvedDesc, std::move(framebuffer), {}, frameIndex});
+        ++stats.misses;
+        stats.framebufferCount = framebuffers.size();
+    }
+
+    // holds the texture leases of desc, the attachments are not handed out while the framebuffer is in use
+    std::shared_ptr<IFramebuffer> lease(it->framebuffer.get(), [framebuffer = it->framebuffer, desc](IFramebuffer*) {});
+    it->lease = lease;
+    return lease;
+}
+
+void RenderTargetPool::setMaxIdleFrames(uint64_t frames)
+{
+    maxIdleFrames = frames;
+    evictIdle();
+}
+
+void RenderTargetPool::updateFrame()
+{
+    const uint64_t currentFrame = device.getContext().getFrameIndex();
+    if (currentFrame == frameIndex)
+    {
+        return;
+    }
+    frameIndex = currentFrame;
+
+    for (auto& entry : textures)
+    {
+        if (!entry.lease.expired())
+        {
+            entry.lastUsedFrame = frameIndex;
+        }
+    }
+    for (auto& entry : framebuffers)
+    {
+        if (!entry.lease.expired())
+        {
+            entry.lastUsedFrame = frameIndex;
+        }
+    }
+    evictIdle();
+}
+
+void RenderTargetPool::evictIdle()
+{
+    auto isIdle = [this](const auto& entry) {
+        return entry.lease.expired() && entry.lastUsedFrame + maxIdleFrames < frameIndex;
+    };
+
+    stats.evictions += std::erase_if(framebuffers, isIdle);
+    std::erase_if(textures, [&](const TextureEntry& entry) {
+        if (!isIdle(entry))
+        {
+            return false;
+        }
+        // the pooled framebuffers attaching the texture would keep it alive, they are not in use since the texture is not
+        stats.evictions += 1 + std::erase_if(framebuffers, [&entry](const FramebufferEntry& framebuffer) {
+            return references(framebuffer.desc, entry.texture.get());
+        });
+        stats.memory -= entry.size;
+        return true;
+    });
+
+    stats.textureCount = textures.size();
+    stats.framebufferCount = framebuffers.size();
+}
+
+FramebufferDesc RenderTargetPool::resolveAttachments(const FramebufferDesc& desc) const
+{
+    // pooled framebuffers must not hold texture leases, they would keep the textures in use
+    FramebufferDesc resolved = desc;
+    auto resolve = [this](FramebufferAttachmentDesc& attachment) {
+        attachment.texture = resolveTexture(attachment.texture);
+        attachment.resolveTexture = resolveTexture(attachment.resolveTexture);
+    };
+    for (auto& attachment : resolved.colorAttachments)
+    {
+        resolve(attachment.second);
+    }
+    resolve(resolved.depthAttachment);
+    resolve(resolved.stencilAttachment);
+    return resolved;
+}
+
+std::shared_ptr<ITexture> RenderTargetPool::resolveTexture(const std::shared_ptr<ITexture>& texture) const
+{
+    if (!texture)
+    {
+        return nullptr;
+    }
+    const auto it = std::ranges::find_if(textures, [&texture](const TextureEntry& entry) {
+        return entry.texture.get() == texture.get();
+    });
+    return it != textures.end() ? it->texture : texture;
+}
+
+}// namespace opengl
@@ -0,0 +1,81 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/Framebuffer.h"
+#include "graphicsAPI/common/Texture.h"
+#include "graphicsAPI/opengl/RenderTargetPoolStats.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace opengl {
+
+class Device;
+
+/**
+ * @brief Textures and framebuffers recycled across frames, for render targets that are created again every frame or
+ * on every resize.
+ *
+ * acquireTexture hands out a pooled texture of an equal description that nobody holds anymore, and acquireFramebuffer
+ * the pooled framebuffer with the same attachments. The returned pointers are leases of the pooled objects: once the
+ * last copy of a lease is released the object can be handed out again, a framebuffer lease keeps its attachments in use.
+ * Pooled objects that were not in use for more than maxIdleFrames are deleted on the next acquire of a later frame.
+ *
+ * Framebuffers keep their attachments alive while they are pooled, including textures not created by the pool.
+ */
+class RenderTargetPool
+{
+public:
+    static constexpr uint64_t DEFAULT_MAX_IDLE_FRAMES = 4;
+
+    explicit RenderTargetPool(Device& device);
+
+    [[nodiscard]] std::shared_ptr<ITexture> acquireTexture(const TextureDesc& desc);
+    [[nodiscard]] std::shared_ptr<IFramebuffer> acquireFramebuffer(const FramebufferDesc& desc);
+
+    void setMaxIdleFrames(uint64_t frames);
+
+    [[nodiscard]] const RenderTargetPoolStats& getStats() const
+    {
+        return stats;
+    }
+
+private:
+    struct TextureEntry
+    {
+        TextureDesc desc;
+        std::shared_ptr<ITexture> texture;
+        std::weak_ptr<ITexture> lease;
+        size_t size;
+        uint64_t lastUsedFrame;
+    };
+
+    struct FramebufferEntry
+    {
+        // attachments of the pooled textures are replaced with the pooled pointers, see resolveAttachments
+        FramebufferDesc desc;
+        std::shared_ptr<IFramebuffer> framebuffer;
+        std::weak_ptr<IFramebuffer> lease;
+        uint64_t lastUsedFrame;
+    };
+
+    void updateFrame();
+    void evictIdle();
+    [[nodiscard]] FramebufferDesc resolveAttachments(const FramebufferDesc& desc) const;
+    [[nodiscard]] std::shared_ptr<ITexture> resolveTexture(const std::shared_ptr<ITexture>& texture) const;
+
+private:
+    Device& device;
+    uint64_t maxIdleFrames = DEFAULT_MAX_IDLE_FRAMES;
+    uint64_t frameIndex = 0;
+
+    std::vector<TextureEntry> textures;
+    std::vector<FramebufferEntry> framebuffers;
+    RenderTargetPoolStats stats;
+};
+
+}// namespace opengl
@@ -35,6 +35,12 @@ void Renderbuffer::create(const TextureDesc& desc, bool hasStorageAlready)
     }
     glInternalFormat = formatDescGl.format;
 
+    width = desc.width;
+    height = desc.height;
+    type = desc.type;
+    numSamples = desc.numSamples;
+    storage = desc.storage;
+
     getContext().genRenderbuffers(1, &handle);
     if (!hasStorageAlready)
     {
@@ -73,7 +79,7 @@ size_t Renderbuffer::getUsage() const
 
 Texture::BufferType Renderbuffer::getBufferType() const
 {
-    return Texture::BufferType::TextureBuffer;
+    return Texture::BufferType::Renderbuffer;
 }
 
 GLuint Renderbuffer::getHandle() const
@@ -81,6 +87,11 @@ GLuint Renderbuffer::getHandle() const
     return handle;
 }
 
+GLenum Renderbuffer::getTarget() const
+{
+    return GL_RENDERBUFFER;
+}
+
 void Renderbuffer::bindImage(size_t unit, uint8_t accessFlags, uint32_t mipLevel, uint32_t layer)
 {
     throw std::runtime_error("Renderbuffer does not support binding as image");
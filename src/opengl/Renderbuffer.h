@@ -27,6 +27,7 @@ public:
 
     [[nodiscard]] BufferType getBufferType() const override;
     [[nodiscard]] GLuint getHandle() const override;
+    [[nodiscard]] GLenum getTarget() const override;
 
 private:
     GLuint handle = 0;
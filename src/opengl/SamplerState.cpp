@@ -9,99 +9,36 @@
 
 namespace opengl {
 
-namespace {
-bool isPowerOfTwo(size_t number) {
-    return (number & (number - 1)) == 0;
-}
-} // namespace
-
 SamplerState::SamplerState(Context& context, const SamplerStateDesc& desc)
     : WithContext(context),
-      minMipFilter_(convertMinMipFilter(desc.minFilter, desc.mipFilter)),
-      magFilter_(convertMagFilter(desc.magFilter)),
-      mipLodMin_(desc.mipLodMin),
-      mipLodMax_(desc.mipLodMax),
-      addressU_(convertAddressMode(desc.addressModeU)),
-      addressV_(convertAddressMode(desc.addressModeV)),
-      addressW_(convertAddressMode(desc.addressModeW)),
-      depthCompareFunction_(DepthStencilState::toOpenGLCompareOp(desc.depthCompareFunction)),
-      depthCompareEnabled_(desc.depthCompareEnabled)
+      desc_(desc)
 {
-    (void) mipLodMin_;
-    (void) mipLodMax_;
-    SamplerStateDescHash h;
-    hash_ = h(desc);
-}
-
-void SamplerState::bind(const std::shared_ptr<Texture>& texture) {
-    if (texture == nullptr) {
-        return;
-    }
-
-    if (texture->getSamplerHash() == hash_) {
-        return;
-    }
-    texture->setSamplerHash(hash_);
-
-    auto type = texture->getType();
-    auto target = Texture::getTextureTarget(type, texture->getSamples() > 1);
-    if (target == 0) {
-        return;
-    }
-
-    // From OpenGL ES 3.1 spec
-    // The effective internal format specified for the texture arrays is a sized internal depth or
-    // depth and stencil format (see table 8.14), the value of TEXTURE_COMPARE_MODE is NONE , and
-    // either the magnification filter is not NEAREST or the minification filter is neither
-    // NEAREST nor NEAREST_MIPMAP_NEAREST.
-    if (!depthCompareEnabled_ && texture->getProperties().isDepthOrStencil() &&
-        minMipFilter_ != GL_NEAREST && minMipFilter_ != GL_NEAREST_MIPMAP_NEAREST) {
-        auto supportedMode = GL_NEAREST;
-        if (minMipFilter_ == GL_LINEAR_MIPMAP_NEAREST || minMipFilter_ == GL_NEAREST_MIPMAP_LINEAR ||
-            minMipFilter_ == GL_LINEAR_MIPMAP_LINEAR) {
-            supportedMode = GL_NEAREST_MIPMAP_NEAREST;
-        }
-        getContext().texParameteri(target, GL_TEXTURE_MIN_FILTER, supportedMode);
-    } else {
-        getContext().texParameteri(target, GL_TEXTURE_MIN_FILTER, minMipFilter_);
-    }
-    if (!depthCompareEnabled_ && texture->getProperties().isDepthOrStencil() &&
-        magFilter_ != GL_NEAREST) {
-        getContext().texParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    } else {
-        getContext().texParameteri(target, GL_TEXTURE_MAG_FILTER, magFilter_);
+    getContext().genSamplers(1, &sampler_);
+    getContext().samplerParameteri(sampler_, GL_TEXTURE_MIN_FILTER, convertMinMipFilter(desc.minFilter, desc.mipFilter));
+    getContext().samplerParameteri(sampler_, GL_TEXTURE_MAG_FILTER, convertMagFilter(desc.magFilter));
+    getContext().samplerParameterf(sampler_, GL_TEXTURE_MIN_LOD, desc.mipLodMin);
+    getContext().samplerParameterf(sampler_, GL_TEXTURE_MAX_LOD, desc.mipLodMax);
+    getContext().samplerParameteri(sampler_, GL_TEXTURE_WRAP_S, convertAddressMode(desc.addressModeU));
+    getContext().samplerParameteri(sampler_, GL_TEXTURE_WRAP_T, convertAddressMode(desc.addressModeV));
+    getContext().samplerParameteri(sampler_, GL_TEXTURE_WRAP_R, convertAddressMode(desc.addressModeW));
+    getContext().samplerParameteri(sampler_,
+                                   GL_TEXTURE_COMPARE_MODE,
+                                   desc.depthCompareEnabled ? GL_COMPARE_REF_TO_TEXTURE : GL_NONE);
+    getContext().samplerParameteri(sampler_, GL_TEXTURE_COMPARE_FUNC, DepthStencilState::toOpenGLCompareOp(desc.depthCompareFunction));
+    if (desc.maxAnisotropic > 1 && (GLEW_VERSION_4_6 || GLEW_EXT_texture_filter_anisotropic))
+    {
+        getContext().samplerParameterf(sampler_, GL_TEXTURE_MAX_ANISOTROPY_EXT, desc.maxAnisotropic);
     }
+}
 
-    // See https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glTexParameter.xml
-    // for OpenGL version information.
-//    if (deviceFeatures.hasFeature(DeviceFeatures::SamplerMinMaxLod)) {
-        getContext().texParameteri(target, GL_TEXTURE_MIN_LOD, mipLodMin_);
-        getContext().texParameteri(target, GL_TEXTURE_MAX_LOD, mipLodMax_);
-//    }
+SamplerState::~SamplerState()
+{
+    getContext().deleteSamplers(1, &sampler_);
+}
 
-//    if (deviceFeatures.hasInternalFeature(InternalFeatures::TextureCompare)) {
-        getContext().texParameteri(target,
-                                   GL_TEXTURE_COMPARE_MODE,
-                                   depthCompareEnabled_ ? GL_COMPARE_REF_TO_TEXTURE : GL_NONE);
-        getContext().texParameteri(target, GL_TEXTURE_COMPARE_FUNC, depthCompareFunction_);
-//    }
-
-//    if (!deviceFeatures.hasFeature(DeviceFeatures::TextureNotPot)) {
-        if (!isPowerOfTwo(texture->getWidth()) || !isPowerOfTwo(texture->getHeight())) {
-            getContext().texParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            getContext().texParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        } else {
-            getContext().texParameteri(target, GL_TEXTURE_WRAP_S, addressU_);
-            getContext().texParameteri(target, GL_TEXTURE_WRAP_T, addressV_);
-        }
-//    } else {
-//        getContext().texParameteri(target, GL_TEXTURE_WRAP_S, addressU_);
-//        getContext().texParameteri(target, GL_TEXTURE_WRAP_T, addressV_);
-//    }
-
-    if (type == TextureType::Texture2DArray || type == TextureType::Texture3D) {
-        getContext().texParameteri(target, GL_TEXTURE_WRAP_R, addressW_);
-    }
+void SamplerState::bind(GLuint unit) const
+{
+    getContext().bindSampler(unit, sampler_);
 }
 
 // utility functions for converting from IGL sampler state enums to GL enums
@@ -14,11 +14,18 @@
 
 namespace opengl {
 
+/**
+ * @brief GL sampler object, bound to texture units independently of the textures they sample.
+ */
 class SamplerState final : public WithContext, public ISamplerState
 {
 public:
     SamplerState(Context& context, const SamplerStateDesc& desc);
-    void bind(const std::shared_ptr<Texture>& texture);
+    ~SamplerState() override;
+
+    void bind(GLuint unit) const;
+    [[nodiscard]] GLuint getId() const { return sampler_; }
+    [[nodiscard]] const SamplerStateDesc& getDesc() const { return desc_; }
 
     static GLint convertMinMipFilter(SamplerMinMagFilter minFilter, SamplerMipFilter mipFilter);
     static GLint convertMagFilter(SamplerMinMagFilter magFilter);
@@ -29,18 +36,8 @@ public:
     static SamplerMipFilter convertGLMipFilter(GLint minFilter);
 
 private:
-    size_t hash_ = std::numeric_limits<size_t>::max();
-    GLint minMipFilter_;
-    GLint magFilter_;
-    GLfloat mipLodMin_;
-    GLfloat mipLodMax_;
-
-    GLint addressU_;
-    GLint addressV_;
-    GLint addressW_;
-
-    GLint depthCompareFunction_;
-    bool depthCompareEnabled_;
+    SamplerStateDesc desc_;
+    GLuint sampler_ = 0;
 };
 
 } // namespace opengl
\ No newline at end of file
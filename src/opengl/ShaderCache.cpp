@@ -0,0 +1,234 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "ShaderCache.h"
+
+#include "ShaderModule.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace opengl {
+
+namespace {
+
+constexpr uint32_t PROGRAM_BINARY_MAGIC = 0x42504147; // "GAPB"
+constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+
+struct ProgramBinaryHeader
+{
+    uint32_t magic = PROGRAM_BINARY_MAGIC;
+    uint32_t version = PROGRAM_BINARY_VERSION;
+    uint64_t driverHash = 0;
+    uint64_t stagesHash = 0;
+    uint32_t format = 0;
+    uint32_t size = 0;
+};
+
+uint64_t hashValue(uint64_t hash, uint64_t value)
+{
+    return hashFnv1a(hash, std::string_view(reinterpret_cast<const char*>(&value), sizeof(value)));
+}
+
+uint64_t hashModule(uint64_t hash, const std::shared_ptr<IShaderModule>& module)
+{
+    const auto* glModule = dynamic_cast<const ShaderModule*>(module.get());
+    return hashValue(hash, glModule ? glModule->getContentHash() : 0);
+}
+
+}// namespace
+
+ShaderCache::ShaderCache(Context& context)
+    : context(context)
+{
+}
+
+std::shared_ptr<ShaderModule> ShaderCache::findModule(const ShaderModuleDesc& desc, uint64_t contentHash)
+{
+    auto it = modules.find(contentHash);
+    if (it != modules.end())
+    {
+        auto module = it->second.lock();
+        // the full comparison guards against hash collisions, it is cheap next to a compilation
+        if (module && module->getDesc().type == desc.type && module->getDesc().code == desc.code &&
+            module->getDesc().defines == desc.defines)
+        {
+            ++stats.moduleHits;
+            return module;
+        }
+    }
+    ++stats.moduleMisses;
+    return nullptr;
+}
+
+void ShaderCache::addModule(const std::shared_ptr<ShaderModule>& module)
+{
+    modules[module->getContentHash()] = module;
+
+    // drop the entries of destroyed modules once in a while, so that the map does not grow forever
+    if (modules.size() % 256 == 0)
+    {
+        std::erase_if(modules, [](const auto& entry) { return entry.second.expired(); });
+    }
+}
+
+void ShaderCache::setProgramBinaryDirectory(const std::filesystem::path& directory)
+{
+    programBinaryDirectory.clear();
+    if (directory.empty())
+    {
+        return;
+    }
+    if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary)
+    {
+        std::cerr << "Program binaries are not supported, the program binary cache stays disabled" << std::endl;
+        return;
+    }
+    GLint formatCount = 0;
+    context.getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0)
+    {
+        std::cerr << "The driver has no program binary format, the program binary cache stays disabled" << std::endl;
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "Failed to create the program binary cache directory " << directory << ": " << error.message() << std::endl;
+        return;
+    }
+
+    driverHash = FNV1A_OFFSET_BASIS;
+    for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        const auto* value = reinterpret_cast<const char*>(context.getString(name));
+        driverHash = hashFnv1a(driverHash, value ? value : "");
+        driverHash = hashFnv1a(driverHash, std::string_view("\0", 1));
+    }
+    programBinaryDirectory = directory;
+}
+
+bool ShaderCache::isProgramBinaryEnabled() const
+{
+    return !programBinaryDirectory.empty();
+}
+
+uint64_t ShaderCache::hashStages(const PipelineShaderStagesDesc& desc) const
+{
+    uint64_t hash = hashValue(FNV1A_OFFSET_BASIS, static_cast<uint64_t>(desc.type));
+    hash = hashModule(hash, desc.vertexModule);
+    hash = hashModule(hash, desc.geometryModule);
+    hash = hashModule(hash, desc.fragmentModule);
+    hash = hashModule(hash, desc.computeModule);
+    return hash;
+}
+
+std::filesystem::path ShaderCache::getProgramPath(uint64_t stagesHash) const
+{
+    char name[40];
+    std::snprintf(name, sizeof(name), "%016llx_%016llx.bin",
+                  static_cast<unsigned long long>(stagesHash), static_cast<unsigned long long>(driverHash));
+    return programBinaryDirectory / name;
+}
+
+GLuint ShaderCache::loadProgram(uint64_t stagesHash)
+{
+    if (!isProgramBinaryEnabled())
+    {
+        return 0;
+    }
+
+    std::ifstream file(getProgramPath(stagesHash), std::ios::binary);
+    ProgramBinaryHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        ++stats.programBinaryMisses;
+        return 0;
+    }
+    std::error_code error;
+    const auto fileSize = std::filesystem::file_size(getProgramPath(stagesHash), error);
+    std::vector<char> binary;
+    // the size is checked against the file before allocating, a corrupted header must not request gigabytes
+    if (header.magic == PROGRAM_BINARY_MAGIC && header.version == PROGRAM_BINARY_VERSION &&
+        header.driverHash == driverHash && header.stagesHash == stagesHash && !error &&
+        header.size <= fileSize - sizeof(header))
+    {
+        binary.resize(header.size);
+        file.read(binary.data(), header.size);
+    }
+    if (binary.empty() || !file)
+    {
+        ++stats.programBinaryRejects;
+        return 0;
+    }
+
+    GLuint program = context.createProgram();
+    context.programBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint success = 0;
+    context.getProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        // e.g. a driver update that kept the version string, the caller links from source and stores a new binary
+        context.deleteProgram(program);
+        ++stats.programBinaryRejects;
+        return 0;
+    }
+    ++stats.programBinaryHits;
+    return program;
+}
+
+void ShaderCache::storeProgram(uint64_t stagesHash, GLuint program)
+{
+    if (!isProgramBinaryEnabled())
+    {
+        return;
+    }
+
+    GLint size = 0;
+    context.getProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0)
+    {
+        return;
+    }
+    ProgramBinaryHeader header;
+    header.driverHash = driverHash;
+    header.stagesHash = stagesHash;
+    std::vector<char> binary(size);
+    GLsizei length = 0;
+    GLenum format = 0;
+    context.getProgramBinary(program, size, &length, &format, binary.data());
+    if (length <= 0)
+    {
+        return;
+    }
+    header.format = format;
+    header.size = static_cast<uint32_t>(length);
+
+    // written next to the final file and renamed, so that a crash never leaves a truncated binary behind
+    const auto path = getProgramPath(stagesHash);
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file)
+        {
+            std::cerr << "Failed to write the program binary " << tempPath << std::endl;
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+}// namespace opengl
@@ -0,0 +1,93 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/ShaderStage.h"
+#include "graphicsAPI/opengl/Context.h"
+#include "graphicsAPI/opengl/ShaderCacheStats.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace opengl {
+
+class ShaderModule;
+
+// 64 bit FNV-1a, unlike std::hash its value is the same across runs and standard libraries
+constexpr uint64_t FNV1A_OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+inline uint64_t hashFnv1a(uint64_t hash, std::string_view data)
+{
+    for (const char c : data)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Two level cache in front of shader compilation and program linking.
+ *
+ * Compiled shader modules are deduplicated in-process by the content hash of their stage, source and defines.
+ * Linked programs are stored on disk as glGetProgramBinary blobs keyed by the content hashes of their stages and the
+ * driver (vendor, renderer and version strings), and are loaded back with glProgramBinary. A binary the driver rejects
+ * falls back to a link from source, which replaces the stored binary.
+ */
+class ShaderCache
+{
+public:
+    explicit ShaderCache(Context& context);
+
+    /**
+     * @brief Returns the live module compiled from the same description, or nullptr. The module may still be
+     * compiling, or have failed, if it was created with ShaderModuleDesc::compileAsync.
+     */
+    [[nodiscard]] std::shared_ptr<ShaderModule> findModule(const ShaderModuleDesc& desc, uint64_t contentHash);
+    void addModule(const std::shared_ptr<ShaderModule>& module);
+
+    /**
+     * @brief Enables the program binary cache in the given directory, which is created if needed. An empty path
+     * disables it.
+     */
+    void setProgramBinaryDirectory(const std::filesystem::path& directory);
+    [[nodiscard]] bool isProgramBinaryEnabled() const;
+
+    [[nodiscard]] uint64_t hashStages(const PipelineShaderStagesDesc& desc) const;
+    /**
+     * @brief Creates a program from the stored binary of the stage set, returns 0 if there is none or it was rejected.
+     */
+    [[nodiscard]] GLuint loadProgram(uint64_t stagesHash);
+    /**
+     * @brief Stores the binary of a program linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT.
+     */
+    void storeProgram(uint64_t stagesHash, GLuint program);
+
+    [[nodiscard]] const ShaderCacheStats& getStats() const
+    {
+        return stats;
+    }
+
+private:
+    [[nodiscard]] std::filesystem::path getProgramPath(uint64_t stagesHash) const;
+
+private:
+    Context& context;
+
+    // not owning, modules nobody uses anymore are compiled again
+    std::unordered_map<uint64_t, std::weak_ptr<ShaderModule>> modules;
+
+    std::filesystem::path programBinaryDirectory;
+    // hash of the vendor, renderer and version strings, binaries of another driver are never loaded
+    uint64_t driverHash = 0;
+
+    ShaderCacheStats stats;
+};
+
+}// namespace opengl
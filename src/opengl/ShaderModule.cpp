@@ -3,6 +3,9 @@
 //
 
 #include "ShaderModule.h"
+#include "ShaderCache.h"
+
+#include <iostream>
 #include <stdexcept>
 
 namespace opengl {
@@ -17,8 +20,50 @@ static GLenum ShaderTypeToOpenGLType(ShaderModuleType type) {
     return 0;
 }
 
+// inserts the defines after the #version directive, which has to stay the first statement of the source
+static std::string applyDefines(const std::string& glsl, const std::vector<std::string>& defines)
+{
+    if (defines.empty())
+    {
+        return glsl;
+    }
+    std::string block;
+    for (const auto& define : defines)
+    {
+        block += "#define " + define + "\n";
+    }
+    const size_t version = glsl.find("#version");
+    if (version == std::string::npos)
+    {
+        return block + glsl;
+    }
+    const size_t lineEnd = glsl.find('\n', version);
+    if (lineEnd == std::string::npos)
+    {
+        return glsl + "\n" + block;
+    }
+    std::string result = glsl;
+    result.insert(lineEnd + 1, block);
+    return result;
+}
+
+uint64_t ShaderModule::hashDesc(const ShaderModuleDesc& desc)
+{
+    uint64_t hash = FNV1A_OFFSET_BASIS;
+    const auto type = static_cast<char>(desc.type);
+    hash = hashFnv1a(hash, std::string_view(&type, 1));
+    hash = hashFnv1a(hash, desc.code);
+    for (const auto& define : desc.defines)
+    {
+        // the separator keeps {"A", "B"} and {"AB"} apart
+        hash = hashFnv1a(hash, std::string_view("\0", 1));
+        hash = hashFnv1a(hash, define);
+    }
+    return hash;
+}
+
 ShaderModule::ShaderModule(Context& context, const ShaderModuleDesc& desc)
-    : WithContext(context), IShaderModule(desc), shaderType(ShaderTypeToOpenGLType(desc.type))
+    : WithContext(context), IShaderModule(desc), shaderType(ShaderTypeToOpenGLType(desc.type)), contentHash(hashDesc(desc))
 {
 }
 
@@ -46,20 +91,85 @@ void ShaderModule::create(const std::string& glsl)
 
     GLuint tempShader = getContext().createShader(shaderType);
 
-    const GLchar* code = glsl.c_str();
+    const std::string source = applyDefines(glsl, desc.defines);
+    const GLchar* code = source.c_str();
     getContext().shaderSource(tempShader, 1, &code, nullptr);
     getContext().compileShader(tempShader);
+    shader = tempShader;
+    isCompiled = true;
+
+    if (desc.compileAsync)
+    {
+        return;
+    }
+    finishCompile();
+    if (status == CompileStatus::Failed)
+    {
+        throw std::runtime_error("Shader compilation failed: " + infoLog);
+    }
+}
+
+GLuint ShaderModule::getOrCreateShader()
+{
+    create(desc.code);
+    return shader;
+}
 
+void ShaderModule::waitUntilCompiled()
+{
+    if (!isCompiled)
+    {
+        return;
+    }
+    if (status == CompileStatus::Pending)
+    {
+        finishCompile();
+    }
+    if (status == CompileStatus::Failed)
+    {
+        throw std::runtime_error("Shader compilation failed: " + infoLog);
+    }
+}
+
+bool ShaderModule::isReady()
+{
+    if (!isCompiled)
+    {
+        create(desc.code);
+    }
+    if (status == CompileStatus::Pending && isCompiled)
+    {
+        if (getContext().hasParallelShaderCompile())
+        {
+            GLint completed = GL_FALSE;
+            getContext().getShaderiv(shader, GL_COMPLETION_STATUS_KHR, &completed);
+            if (!completed)
+            {
+                return false;
+            }
+        }
+        finishCompile();
+        if (status == CompileStatus::Failed)
+        {
+            std::cerr << "Shader compilation failed: " << infoLog << std::endl;
+        }
+    }
+    return status == CompileStatus::Ready;
+}
+
+void ShaderModule::finishCompile()
+{
     GLint success = 0;
-    getContext().getShaderiv(tempShader, GL_COMPILE_STATUS, &success);
+    getContext().getShaderiv(shader, GL_COMPILE_STATUS, &success);
     if (!success)
     {
-        GLchar infoLog[512];
-        getContext().getShaderInfoLog(tempShader, 512, nullptr, infoLog);
-        throw std::runtime_error("Shader compilation failed: " + std::string(infoLog));
+        GLchar log[512];
+        getContext().getShaderInfoLog(shader, 512, nullptr, log);
+        infoLog = log;
+        status = CompileStatus::Failed;
+        return;
     }
-    shader = tempShader;
-    isCompiled = true;
+    status = CompileStatus::Ready;
 }
 
 }// namespace opengl
@@ -10,7 +10,9 @@
 #include "ShaderModuleReflection.h"
 #include "graphicsAPI/opengl/Context.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
 
 namespace opengl {
 
@@ -21,20 +23,57 @@ public:
     ~ShaderModule() override;
 
 //    std::string compileAndParseGLSL(spirv_cross::Compiler& compiler);
+    /**
+     * @brief Compiles the module, waits for the compiler and throws on failure unless ShaderModuleDesc::compileAsync.
+     * Does nothing once the module was compiled.
+     */
     void create(const std::string& glsl);
+    /**
+     * @brief Compiles the module from its description if create() was deferred, returns the shader object.
+     */
+    GLuint getOrCreateShader();
+    /**
+     * @brief Waits for a pending compilation and throws if it failed, for synchronous requests sharing an asynchronous
+     * module. A deferred compilation stays deferred.
+     */
+    void waitUntilCompiled();
+
+    [[nodiscard]] bool isReady() override;
 
     [[nodiscard]] std::shared_ptr<ShaderModuleReflection> getReflection() const { return reflection; }
 
     GLenum getShaderType() const { return shaderType; }
     GLuint getShader() const { return shader; }
 
+    [[nodiscard]] const ShaderModuleDesc& getDesc() const { return desc; }
+    /**
+     * @brief Hash of the stage, source and defines of the module, stable across runs and builds.
+     */
+    [[nodiscard]] uint64_t getContentHash() const { return contentHash; }
+
+    [[nodiscard]] static uint64_t hashDesc(const ShaderModuleDesc& desc);
+
+private:
+    enum class CompileStatus
+    {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    // reads the compile status, blocks if the compiler is still running
+    void finishCompile();
+
 private:
     GLenum shaderType;
     GLuint shader = -1;
+    uint64_t contentHash = 0;
 
     std::shared_ptr<ShaderModuleReflection> reflection;
 
     bool isCompiled = false;
+    CompileStatus status = CompileStatus::Pending;
+    std::string infoLog;
 };
 
 }// namespace opengl
@@ -3,8 +3,13 @@
 //
 
 #include "ShaderStage.h"
+#include "GraphicsPipelineReflection.h"
+#include "ShaderCache.h"
 #include "ShaderModule.h"
 
+#include <iostream>
+#include <stdexcept>
+
 namespace opengl {
 
 PipelineShaderStages::PipelineShaderStages(Context& context, const PipelineShaderStagesDesc& desc)
@@ -20,123 +25,159 @@ PipelineShaderStages::~PipelineShaderStages()
     }
 }
 
-void PipelineShaderStages::createProgram()
+void PipelineShaderStages::createProgram(std::shared_ptr<ShaderCache> shaderCache_)
 {
+    const bool useProgramBinary = shaderCache_ && shaderCache_->isProgramBinaryEnabled();
+    if (useProgramBinary)
+    {
+        stagesHash = shaderCache_->hashStages(desc);
+        if (const GLuint cachedProgram = shaderCache_->loadProgram(stagesHash); cachedProgram != 0)
+        {
+            if (program != -1)
+            {
+                getContext().deleteProgram(program);
+            }
+            program = cachedProgram;
+            status = LinkStatus::Ready;
+            return;
+        }
+        shaderCache = std::move(shaderCache_);
+    }
+
     switch (desc.type)
     {
     case ShaderStagesType::Graphics:
-        createRenderProgram();
+        createRenderProgram(useProgramBinary);
         break;
     case ShaderStagesType::Compute:
-        createComputeProgram();
+        createComputeProgram(useProgramBinary);
         break;
     }
-}
 
-void PipelineShaderStages::createRenderProgram()
-{
-    if (program != -1)
+    if (!desc.linkAsync)
     {
-        getContext().deleteProgram(program);
+        waitUntilLinked();
     }
+}
 
-    program = getContext().createProgram();
-
-    GLuint vertexShader = -1;
-    GLuint fragmentShader = -1;
-    GLuint geometryShader = -1;
-
-    if (desc.vertexModule)
-    {
-        vertexShader = dynamic_cast<ShaderModule*>(desc.vertexModule.get())->getShader();
-    }
-    if (desc.fragmentModule)
+void PipelineShaderStages::createRenderProgram(bool binaryRetrievable)
+{
+    // modules are compiled here when their compilation was deferred to the first link
+    for (auto* module : {desc.vertexModule.get(), desc.fragmentModule.get(), desc.geometryModule.get()})
     {
-        fragmentShader = dynamic_cast<ShaderModule*>(desc.fragmentModule.get())->getShader();
+        if (module)
+        {
+            attachedShaders.push_back(dynamic_cast<ShaderModule*>(module)->getOrCreateShader());
+        }
     }
-    if (desc.geometryModule)
+    linkProgram(binaryRetrievable);
+}
+
+void PipelineShaderStages::createComputeProgram(bool binaryRetrievable)
+{
+    if (desc.computeModule)
     {
-        geometryShader = dynamic_cast<ShaderModule*>(desc.geometryModule.get())->getShader();
+        attachedShaders.push_back(dynamic_cast<ShaderModule*>(desc.computeModule.get())->getOrCreateShader());
     }
+    linkProgram(binaryRetrievable);
+}
 
-    if (vertexShader != -1)
+void PipelineShaderStages::linkProgram(bool binaryRetrievable)
+{
+    if (program != -1)
     {
-        getContext().attachShader(program, vertexShader);
+        getContext().deleteProgram(program);
     }
-    if (fragmentShader != -1)
+
+    program = getContext().createProgram();
+    status = LinkStatus::Pending;
+    reflection = nullptr;
+    if (binaryRetrievable)
     {
-        getContext().attachShader(program, fragmentShader);
+        getContext().programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     }
-    if (geometryShader != -1)
+
+    for (GLuint shader : attachedShaders)
     {
-        getContext().attachShader(program, geometryShader);
+        getContext().attachShader(program, shader);
     }
 
+    // with parallel shader compilation this returns right away, the status queries are what blocks
     getContext().linkProgram(program);
+}
 
+void PipelineShaderStages::finishLink()
+{
     GLint success = 0;
     getContext().getProgramiv(program, GL_LINK_STATUS, &success);
     if (!success)
     {
-        GLchar infoLog[512];
-        getContext().getProgramInfoLog(program, 512, nullptr, infoLog);
+        GLchar log[512];
+        getContext().getProgramInfoLog(program, 512, nullptr, log);
+        infoLog = log;
         getContext().deleteProgram(program);
         program = -1;
-        throw std::runtime_error("Shader program linking failed: " + std::string(infoLog));
+        attachedShaders.clear();
+        shaderCache = nullptr;
+        status = LinkStatus::Failed;
+        return;
     }
 
-    if (vertexShader != -1)
+    for (GLuint shader : attachedShaders)
     {
-        getContext().detachShader(program, vertexShader);
+        getContext().detachShader(program, shader);
     }
-    if (fragmentShader != -1)
-    {
-        getContext().detachShader(program, fragmentShader);
-    }
-    if (geometryShader != -1)
+    attachedShaders.clear();
+
+    if (shaderCache)
     {
-        getContext().detachShader(program, geometryShader);
+        shaderCache->storeProgram(stagesHash, program);
+        shaderCache = nullptr;
     }
+    status = LinkStatus::Ready;
 }
 
-void PipelineShaderStages::createComputeProgram()
+bool PipelineShaderStages::isReady()
 {
-    if (program != -1)
-    {
-        getContext().deleteProgram(program);
-    }
-
-    program = getContext().createProgram();
-
-    GLuint computeShader = -1;
-
-    if (desc.computeModule)
-    {
-        computeShader = dynamic_cast<ShaderModule*>(desc.computeModule.get())->getShader();
-    }
+    if (status == LinkStatus::Pending && program != -1)
+    {
+        if (getContext().hasParallelShaderCompile())
+        {
+            GLint completed = GL_FALSE;
+            getContext().getProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+            if (!completed)
+            {
+                return false;
+            }
+        }
+        finishLink();
+        if (status == LinkStatus::Failed)
+        {
+            std::cerr << "Shader program linking failed: " << infoLog << std::endl;
+        }
+    }
+    return status == LinkStatus::Ready;
+}
 
-    if (computeShader != -1)
+void PipelineShaderStages::waitUntilLinked()
+{
+    if (status == LinkStatus::Pending && program != -1)
     {
-        getContext().attachShader(program, computeShader);
+        finishLink();
     }
-
-    getContext().linkProgram(program);
-
-    GLint success = 0;
-    getContext().getProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success)
+    if (status != LinkStatus::Ready)
     {
-        GLchar infoLog[512];
-        getContext().getProgramInfoLog(program, 512, nullptr, infoLog);
-        getContext().deleteProgram(program);
-        program = -1;
-        throw std::runtime_error("Shader program linking failed: " + std::string(infoLog));
+        throw std::runtime_error("Shader program linking failed: " + infoLog);
     }
+}
 
-    if (computeShader != -1)
+const std::shared_ptr<GraphicsPipelineReflection>& PipelineShaderStages::getReflection()
+{
+    if (!reflection)
     {
-        getContext().detachShader(program, computeShader);
+        reflection = std::make_shared<GraphicsPipelineReflection>(getContext(), *this);
     }
+    return reflection;
 }
 
 const std::shared_ptr<IShaderModule>& PipelineShaderStages::getVertexShader() const
@@ -167,6 +208,20 @@ void PipelineShaderStages::bind()
     }
 }
 
+void PipelineShaderStages::setSamplerUnits(size_t hash, const std::vector<std::pair<GLint, GLint>>& units)
+{
+    if (samplerUnitsHash == hash)
+    {
+        return;
+    }
+    samplerUnitsHash = hash;
+    bind();
+    for (const auto& [location, unit] : units)
+    {
+        getContext().uniform1i(location, unit);
+    }
+}
+
 void PipelineShaderStages::unbind()
 {
     if (program != -1)
@@ -7,15 +7,35 @@
 #include "graphicsAPI/common/ShaderStage.h"
 #include "graphicsAPI/opengl/Context.h"
 
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace opengl {
 
+class GraphicsPipelineReflection;
+class ShaderCache;
+
 class PipelineShaderStages : public IPipelineShaderStages, public WithContext
 {
 public:
     PipelineShaderStages(Context& context, const PipelineShaderStagesDesc& desc);
     ~PipelineShaderStages() override;
 
-    void createProgram();
+    /**
+     * @brief Links the program, or loads it from the program binary cache of shaderCache if there is one.
+     *
+     * Waits for the linker and throws on failure unless PipelineShaderStagesDesc::linkAsync.
+     */
+    void createProgram(std::shared_ptr<ShaderCache> shaderCache = nullptr);
+
+    [[nodiscard]] bool isReady() override;
+    /**
+     * @brief Waits for a pending link to finish, throws if it failed.
+     */
+    void waitUntilLinked();
 
     [[nodiscard]] const std::shared_ptr<IShaderModule>& getVertexShader() const override;
     [[nodiscard]] const std::shared_ptr<IShaderModule>& getFragmentShader() const override;
@@ -29,14 +49,48 @@ public:
 
     [[nodiscard]] GLuint getProgram() const { return program; }
 
+    /**
+     * @brief Points the sampler uniforms at their texture units, given as {location, unit} pairs identified by hash.
+     *
+     * Nothing is done if the program already uses the units of hash. Pipelines sharing these stages can map their
+     * samplers differently, the program then keeps the units of the last pipeline bound. The program gets bound.
+     */
+    void setSamplerUnits(size_t hash, const std::vector<std::pair<GLint, GLint>>& units);
+
+    /**
+     * @brief Reflection of the linked program, created on first use and shared by every pipeline of these stages.
+     */
+    [[nodiscard]] const std::shared_ptr<GraphicsPipelineReflection>& getReflection();
+
 private:
-    void createRenderProgram();
-    void createComputeProgram();
+    enum class LinkStatus
+    {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    // binaryRetrievable asks the driver to keep the binary of the program around for the program binary cache
+    void createRenderProgram(bool binaryRetrievable);
+    void createComputeProgram(bool binaryRetrievable);
+    void linkProgram(bool binaryRetrievable);
+    // reads the link status, blocks if the linker is still running
+    void finishLink();
 
 private:
     PipelineShaderStagesDesc desc;
 
     GLuint program = -1;
+    LinkStatus status = LinkStatus::Pending;
+    std::string infoLog;
+    // shaders attached until the link finished
+    std::vector<GLuint> attachedShaders;
+    // the program binary is stored once the link finished
+    std::shared_ptr<ShaderCache> shaderCache;
+    uint64_t stagesHash = 0;
+
+    std::shared_ptr<GraphicsPipelineReflection> reflection;
+    std::optional<size_t> samplerUnitsHash;
 };
 
 }// namespace opengl
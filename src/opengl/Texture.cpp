@@ -3,6 +3,7 @@
 //
 
 #include "Texture.h"
+#include "TextureUploadQueue.h"
 
 namespace opengl {
 
@@ -19,6 +20,12 @@ void Texture::uploadCube(const void* data, TextureCubeFace face, const TextureRa
 {
 }
 
+std::future<void> Texture::uploadAsync(const void* data, const TextureRangeDesc& range, size_t bytesPerRow, std::function<void()> onComplete) const
+{
+    auto texture = std::static_pointer_cast<const Texture>(shared_from_this());
+    return getContext().getTextureUploadQueue().enqueue(std::move(texture), data, range, bytesPerRow, std::move(onComplete));
+}
+
 bool Texture::toFormatDescGL(TextureFormat textureFormat, TextureDesc::TextureUsage usage, FormatDescGL& outFormatGL)
 {
     bool sampled = (usage & TextureDesc::TextureUsageBits::Sampled) != 0;
@@ -825,16 +832,6 @@ TextureFormat Texture::getFormat() const
     return formatProperties.format;
 }
 
-size_t Texture::getSamplerHash() const
-{
-    return samplerHash;
-}
-
-void Texture::setSamplerHash(size_t hash)
-{
-    samplerHash = hash;
-}
-
 GLenum Texture::getTextureTarget(TextureType type, bool isMultisampled)
 {
     switch (type)
@@ -31,6 +31,7 @@ public:
 
     void upload(const void* data, const TextureRangeDesc& range, size_t bytesPerRow) const override;
     void uploadCube(const void* data, TextureCubeFace face, const TextureRangeDesc& range, size_t bytesPerRow) const override;
+    std::future<void> uploadAsync(const void* data, const TextureRangeDesc& range, size_t bytesPerRow, std::function<void()> onComplete) const override;
 
     virtual void create(const TextureDesc& desc, bool hasStorageAlready) = 0;
     virtual void bind() =  0;
@@ -39,6 +40,7 @@ public:
 
     [[nodiscard]] virtual BufferType getBufferType() const = 0;
     [[nodiscard]] virtual GLuint getHandle() const = 0;
+    [[nodiscard]] virtual GLenum getTarget() const = 0;
 
     static bool toFormatDescGL(TextureFormat textureFormat,
                                TextureDesc::TextureUsage usage,
@@ -61,14 +63,17 @@ public:
     [[nodiscard]] std::pair<bool, bool> validateRange(const TextureRangeDesc &range) const override;
     [[nodiscard]] GLint getAlignment(size_t stride, size_t mipLevel = 0) const;
 
-    void setSamplerHash(size_t hash);
-    [[nodiscard]] size_t getSamplerHash() const;
+    /**
+     * @brief Created with ResourceStorage::Memoryless, the content never outlives a render pass.
+     */
+    [[nodiscard]] bool isMemoryless() const
+    {
+        return storage == ResourceStorage::Memoryless;
+    }
 
     static GLenum getTextureTarget(TextureType type, bool isMultisampled = false);
 
 protected:
-    size_t samplerHash = std::numeric_limits<size_t>::max();
-
     GLsizei width = 0;
     GLsizei height = 0;
     GLsizei depth = 1;
@@ -78,6 +83,7 @@ protected:
 
     GLenum glInternalFormat;
     TextureType type = TextureType::Invalid;
+    ResourceStorage storage = ResourceStorage::Invalid;
 
     TextureFormatProperties formatProperties;
 };
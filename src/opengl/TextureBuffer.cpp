@@ -39,6 +39,7 @@ void TextureBuffer::create(const TextureDesc& desc, bool hasStorageAlready)
     numLayers = desc.numLayers;
     numSamples = desc.numSamples;
     numMipLevels = desc.numMipLevels;
+    storage = desc.storage;
 
     auto isSampledOrStorage = (desc.usage & (TextureDesc::TextureUsageBits::Sampled | TextureDesc::TextureUsageBits::Storage)) != 0;
     if (isSampledOrStorage || desc.type != TextureType::Texture2D)
@@ -25,7 +25,7 @@ public:
     [[nodiscard]] TextureFormatProperties getProperties() const override;
 
     size_t getUsage() const override;
-    [[nodiscard]] GLenum getTarget() const;
+    [[nodiscard]] GLenum getTarget() const override;
     [[nodiscard]] TextureType getType() const override;
 
     void bind() override;
@@ -0,0 +1,141 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "TextureResidency.h"
+
+#include "SamplerState.h"
+#include "Texture.h"
+
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace opengl {
+
+TextureResidency::TextureResidency(Context& context)
+    : context(context)
+    , frameIndex(context.getFrameIndex())
+{
+}
+
+TextureResidency::~TextureResidency()
+{
+    while (!lru.empty())
+    {
+        makeNonResident(std::prev(lru.end()));
+    }
+    for (const auto& [frame, fence] : frameFences)
+    {
+        context.deleteSync(fence);
+    }
+}
+
+uint64_t TextureResidency::getHandle(const std::shared_ptr<Texture>& texture, const std::shared_ptr<SamplerState>& samplerState)
+{
+    if (!texture || texture->getBufferType() != Texture::BufferType::TextureBuffer)
+    {
+        throw std::runtime_error("Only sampled textures have bindless handles");
+    }
+
+    if (const uint64_t currentFrame = context.getFrameIndex(); currentFrame != frameIndex)
+    {
+        // the previous frame requested handles, its commands are submitted by now
+        if (!entries.empty())
+        {
+            frameFences.emplace_back(frameIndex, context.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        }
+        frameIndex = currentFrame;
+        evictIdle();
+    }
+
+    const Key key = {texture.get(), samplerState.get()};
+    if (auto it = entries.find(key); it != entries.end())
+    {
+        it->second.lastUsedFrame = frameIndex;
+        lru.splice(lru.begin(), lru, it->second.lruPosition);
+        return it->second.handle;
+    }
+
+    // the texture and sampler parameters are immutable once a handle exists, the sampler states are interned and
+    // never change, textures only set theirs at creation
+    const GLuint64 handle = samplerState ? context.getTextureSamplerHandle(texture->getHandle(), samplerState->getId())
+                                         : context.getTextureHandle(texture->getHandle());
+    if (handle == 0)
+    {
+        throw std::runtime_error("Failed to create bindless texture handle");
+    }
+    context.makeTextureHandleResident(handle);
+
+    lru.push_front(key);
+    entries.try_emplace(key, Entry{texture, samplerState, handle, frameIndex, lru.begin()});
+    evictOverBudget();
+    return handle;
+}
+
+void TextureResidency::setBudget(size_t budget_)
+{
+    budget = budget_;
+    evictOverBudget();
+}
+
+void TextureResidency::evictIdle()
+{
+    while (!lru.empty())
+    {
+        const auto last = std::prev(lru.end());
+        const uint64_t lastUsedFrame = entries.at(*last).lastUsedFrame;
+        if (lastUsedFrame + MAX_IDLE_FRAMES >= frameIndex)
+        {
+            break;
+        }
+        waitForFrame(lastUsedFrame);
+        makeNonResident(last);
+    }
+}
+
+void TextureResidency::evictOverBudget()
+{
+    while (entries.size() > budget)
+    {
+        const auto last = std::prev(lru.end());
+        const uint64_t lastUsedFrame = entries.at(*last).lastUsedFrame;
+        if (lastUsedFrame == frameIndex)
+        {
+            // everything left is used by the current frame
+            break;
+        }
+        // the frames in flight may still sample the handle
+        waitForFrame(lastUsedFrame);
+        makeNonResident(last);
+    }
+}
+
+void TextureResidency::waitForFrame(uint64_t frame)
+{
+    while (!frameFences.empty() && frameFences.front().first <= frame)
+    {
+        const GLsync fence = frameFences.front().second;
+        GLenum result = GL_TIMEOUT_EXPIRED;
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = context.clientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+        if (result == GL_WAIT_FAILED)
+        {
+            std::cerr << "Failed to wait for bindless residency fence" << std::endl;
+        }
+        context.deleteSync(fence);
+        frameFences.pop_front();
+    }
+}
+
+void TextureResidency::makeNonResident(std::list<Key>::iterator position)
+{
+    auto it = entries.find(*position);
+    context.makeTextureHandleNonResident(it->second.handle);
+    entries.erase(it);
+    lru.erase(position);
+}
+
+}// namespace opengl
@@ -0,0 +1,100 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/opengl/Context.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace opengl {
+
+class SamplerState;
+class Texture;
+
+/**
+ * @brief Bindless handles of texture and sampler pairs, kept resident with an LRU.
+ *
+ * A handle is made resident when it is requested and stays resident while it is requested every few frames. Handles
+ * idle for more than MAX_IDLE_FRAMES are made non-resident, and once more than budget handles are resident the least
+ * recently used ones are, except for those requested during the current frame. A handle is only made non-resident
+ * once the GPU completed the last frame requesting it, the eviction waits for the fence of that frame if needed.
+ * Resident entries keep their texture and sampler state alive, GL deletes the handles of a texture together with it.
+ */
+class TextureResidency
+{
+public:
+    static constexpr size_t DEFAULT_BUDGET = 4096;
+    static constexpr uint64_t MAX_IDLE_FRAMES = 60;
+
+    explicit TextureResidency(Context& context);
+    ~TextureResidency();
+
+    /**
+     * @brief Returns the resident handle of texture sampled with samplerState, nullptr uses the sampling parameters of
+     * the texture. Must be called on the GL thread.
+     */
+    [[nodiscard]] uint64_t getHandle(const std::shared_ptr<Texture>& texture, const std::shared_ptr<SamplerState>& samplerState);
+
+    /**
+     * @brief Maximum number of resident handles, handles requested during the current frame are never evicted.
+     */
+    void setBudget(size_t budget);
+
+    [[nodiscard]] size_t getResidentCount() const
+    {
+        return entries.size();
+    }
+
+private:
+    struct Key
+    {
+        const Texture* texture;
+        const SamplerState* samplerState;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<const void*>()(key.texture) ^ (std::hash<const void*>()(key.samplerState) << 1);
+        }
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<Texture> texture;
+        std::shared_ptr<SamplerState> samplerState;
+        GLuint64 handle;
+        uint64_t lastUsedFrame;
+        std::list<Key>::iterator lruPosition;
+    };
+
+    void evictIdle();
+    void evictOverBudget();
+    void makeNonResident(std::list<Key>::iterator position);
+    // waits until the GPU completed frame and the frames before it
+    void waitForFrame(uint64_t frame);
+
+private:
+    Context& context;
+    size_t budget = DEFAULT_BUDGET;
+    uint64_t frameIndex = 0;
+    // fences inserted after the frames requesting handles, oldest first
+    std::deque<std::pair<uint64_t, GLsync>> frameFences;
+
+    // most recently used first
+    std::list<Key> lru;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+};
+
+}// namespace opengl
@@ -0,0 +1,208 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "TextureUploadQueue.h"
+
+#include "Texture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace opengl {
+
+TextureUploadQueue::TextureUploadQueue(Context& context)
+    : context(context)
+{
+}
+
+TextureUploadQueue::~TextureUploadQueue()
+{
+    for (auto& batch : batches)
+    {
+        context.deleteSync(batch.fence);
+    }
+    for (auto& buffer : stagingBuffers)
+    {
+        context.deleteBuffers(1, &buffer.id);
+    }
+}
+
+void TextureUploadQueue::createStagingBuffers()
+{
+    if (!GLEW_VERSION_4_4 && !GLEW_ARB_buffer_storage)
+    {
+        return;
+    }
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    stagingBuffers.resize(STAGING_BUFFER_COUNT);
+    for (auto& buffer : stagingBuffers)
+    {
+        context.genBuffers(1, &buffer.id);
+        context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+        context.bufferStorage(GL_PIXEL_UNPACK_BUFFER, STAGING_BUFFER_SIZE, nullptr, flags);
+        buffer.memory = static_cast<std::byte*>(context.mapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, STAGING_BUFFER_SIZE, flags));
+    }
+    context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (std::ranges::any_of(stagingBuffers, [](const auto& buffer) { return buffer.memory == nullptr; }))
+    {
+        std::cerr << "Failed to map texture staging buffers, uploading from client memory" << std::endl;
+        for (auto& buffer : stagingBuffers)
+        {
+            context.deleteBuffers(1, &buffer.id);
+        }
+        stagingBuffers.clear();
+    }
+}
+
+bool TextureUploadQueue::reserve(size_t size, uint32_t& stagingBuffer, uint32_t& offset)
+{
+    if (stagingBuffers.empty() || size > STAGING_BUFFER_SIZE - STAGING_ALIGNMENT)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < stagingBuffers.size(); ++i)
+    {
+        auto& buffer = stagingBuffers[currentStagingBuffer];
+        if (buffer.pendingUploads == 0)
+        {
+            buffer.head = STAGING_ALIGNMENT;
+        }
+        const size_t start = (buffer.head + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT * STAGING_ALIGNMENT;
+        if (start + size <= STAGING_BUFFER_SIZE)
+        {
+            buffer.head = static_cast<uint32_t>(start + size);
+            ++buffer.pendingUploads;
+            stagingBuffer = currentStagingBuffer;
+            offset = static_cast<uint32_t>(start);
+            return true;
+        }
+        currentStagingBuffer = (currentStagingBuffer + 1) % stagingBuffers.size();
+    }
+    return false;
+}
+
+std::future<void> TextureUploadQueue::enqueue(std::shared_ptr<const Texture> texture,
+                                              const void* data,
+                                              const TextureRangeDesc& range,
+                                              size_t bytesPerRow,
+                                              std::function<void()> onComplete)
+{
+    Upload upload;
+    auto future = upload.promise.get_future();
+    if (data == nullptr || !texture)
+    {
+        upload.promise.set_value();
+        if (onComplete)
+        {
+            onComplete();
+        }
+        return future;
+    }
+
+    size_t size = texture->getProperties().getBytesPerRange(range);
+    if (bytesPerRow != 0)
+    {
+        size = std::max(size, bytesPerRow * range.height * range.depth * range.numLayers);
+    }
+
+    upload.texture = std::move(texture);
+    upload.range = range;
+    upload.bytesPerRow = bytesPerRow;
+    upload.onComplete = std::move(onComplete);
+
+    std::byte* staging = nullptr;
+    {
+        std::lock_guard lock(mutex);
+        if (reserve(size, upload.stagingBuffer, upload.offset))
+        {
+            staging = stagingBuffers[upload.stagingBuffer].memory + upload.offset;
+        }
+    }
+    // the copy runs outside of the lock, so that several threads can fill staging memory at once
+    if (staging)
+    {
+        std::memcpy(staging, data, size);
+    }
+    else
+    {
+        upload.stagingBuffer = ~0u;
+        upload.clientData.assign(static_cast<const std::byte*>(data), static_cast<const std::byte*>(data) + size);
+    }
+
+    std::lock_guard lock(mutex);
+    queuedUploads.push_back(std::move(upload));
+    return future;
+}
+
+void TextureUploadQueue::process()
+{
+    // complete the batches the GPU is done with, in the order they were issued
+    while (!batches.empty())
+    {
+        auto& batch = batches.front();
+        if (context.clientWaitSync(batch.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            break;
+        }
+        context.deleteSync(batch.fence);
+        {
+            std::lock_guard lock(mutex);
+            for (auto& upload : batch.uploads)
+            {
+                if (upload.stagingBuffer < stagingBuffers.size())
+                {
+                    --stagingBuffers[upload.stagingBuffer].pendingUploads;
+                }
+            }
+        }
+        for (auto& upload : batch.uploads)
+        {
+            upload.promise.set_value();
+            if (upload.onComplete)
+            {
+                upload.onComplete();
+            }
+        }
+        batches.pop_front();
+    }
+
+    std::vector<Upload> uploads;
+    {
+        std::lock_guard lock(mutex);
+        if (!stagingBuffersCreated)
+        {
+            createStagingBuffers();
+            stagingBuffersCreated = true;
+        }
+        uploads.swap(queuedUploads);
+    }
+    if (uploads.empty())
+    {
+        return;
+    }
+
+    for (auto& upload : uploads)
+    {
+        const void* data = upload.clientData.data();
+        if (upload.stagingBuffer < stagingBuffers.size())
+        {
+            context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBuffers[upload.stagingBuffer].id);
+            data = reinterpret_cast<const void*>(static_cast<uintptr_t>(upload.offset));
+        }
+        else
+        {
+            context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        upload.texture->upload(data, upload.range, upload.bytesPerRow);
+        // the driver copied client memory before the call returned
+        upload.clientData = {};
+    }
+    context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    batches.push_back({context.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), std::move(uploads)});
+}
+
+}// namespace opengl
@@ -0,0 +1,103 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#pragma once
+
+#include "graphicsAPI/common/TextureStructures.h"
+#include "graphicsAPI/opengl/Context.h"
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace opengl {
+
+class Texture;
+
+/**
+ * @brief Queue of the texture uploads started with ITexture::uploadAsync.
+ *
+ * The data is copied into one of a pool of persistently mapped pixel buffers on the calling thread, the GL thread
+ * issues the texture uploads from the pixel buffer in process() and completes them once their fence is signaled.
+ * Uploads that do not fit into a free staging buffer are copied into client memory and uploaded from there.
+ */
+class TextureUploadQueue
+{
+public:
+    static constexpr uint32_t STAGING_BUFFER_SIZE = 8 * 1024 * 1024;
+    static constexpr uint32_t STAGING_BUFFER_COUNT = 4;
+
+    explicit TextureUploadQueue(Context& context);
+    ~TextureUploadQueue();
+
+    /**
+     * @brief Copies the data of the upload into staging memory and queues the upload, may be called from any thread.
+     */
+    std::future<void> enqueue(std::shared_ptr<const Texture> texture,
+                              const void* data,
+                              const TextureRangeDesc& range,
+                              size_t bytesPerRow,
+                              std::function<void()> onComplete);
+
+    /**
+     * @brief Issues the queued uploads and completes the ones the GPU is done with, must be called on the GL thread.
+     */
+    void process();
+
+private:
+    // offsets start here, a pixel buffer offset of 0 would read as a null data pointer to Texture::upload
+    static constexpr uint32_t STAGING_ALIGNMENT = 16;
+
+    struct StagingBuffer
+    {
+        GLuint id = 0;
+        std::byte* memory = nullptr;
+        uint32_t head = STAGING_ALIGNMENT;
+        // uploads copied into the buffer that have not completed yet, the buffer is reused once it drops to 0
+        uint32_t pendingUploads = 0;
+    };
+
+    struct Upload
+    {
+        std::shared_ptr<const Texture> texture;
+        TextureRangeDesc range;
+        size_t bytesPerRow = 0;
+        // staging buffer and offset of the data, or the data itself if no staging memory was available
+        uint32_t stagingBuffer = ~0u;
+        uint32_t offset = 0;
+        std::vector<std::byte> clientData;
+        std::promise<void> promise;
+        std::function<void()> onComplete;
+    };
+
+    // uploads issued together, completed by a single fence
+    struct Batch
+    {
+        GLsync fence = nullptr;
+        std::vector<Upload> uploads;
+    };
+
+    void createStagingBuffers();
+    // reserves size bytes of staging memory, returns false if no staging buffer has room
+    bool reserve(size_t size, uint32_t& stagingBuffer, uint32_t& offset);
+
+private:
+    Context& context;
+
+    std::mutex mutex;
+    // created on the GL thread by the first process() call
+    bool stagingBuffersCreated = false;
+    std::vector<StagingBuffer> stagingBuffers;
+    uint32_t currentStagingBuffer = 0;
+    std::vector<Upload> queuedUploads;
+
+    // GL thread only
+    std::deque<Batch> batches;
+};
+
+}// namespace opengl
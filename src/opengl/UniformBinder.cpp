@@ -4,51 +4,73 @@
 
 #include "UniformBinder.h"
 
+#include <bit>
+#include <iostream>
+
 namespace opengl {
 
-UniformBinder::UniformBinder()
+UniformBinder::UniformBinder(GLenum target)
+    : target(target)
 {
-    uniformBufferCache.reserve(MAX_UNIFORM_BUFFERS);
-    uniformBuffersDirtyMask = 0;
 }
 
-void UniformBinder::setBuffer(uint32_t index, const std::shared_ptr<Buffer>& buffer, uint32_t offset)
+void UniformBinder::setBuffer(uint32_t index, Buffer* buffer, uint32_t offset, uint32_t size)
 {
-    if (index >= 0 && index < MAX_UNIFORM_BUFFERS)
+    if (index >= MAX_BUFFER_BINDINGS)
     {
-        uniformBufferCache[index] = std::make_pair(buffer, offset);
-        uniformBuffersDirtyMask |= 1 << index;
+        std::cerr << "Buffer binding " << index << " is out of range" << std::endl;
+        return;
     }
-    else
+    auto& slot = slots[index];
+    // an empty range fails glBindBuffersRange and would drop the whole run, the slot is unbound instead
+    if (buffer && (offset >= buffer->getSize() || static_cast<size_t>(offset) + size > buffer->getSize()))
     {
-        // handle error
+        std::cerr << "Buffer binding " << index << " range is out of the buffer bounds" << std::endl;
+        buffer = nullptr;
     }
+    slot.buffer = buffer;
+    slot.offset = offset;
+    slot.size = size;
+    dirtyMask |= 1u << index;
 }
 
 void UniformBinder::bindBuffers(Context& context)
 {
-    for (auto& [bufferIndex, bindingInfo] : uniformBufferCache)
+    std::array<GLuint, MAX_BUFFER_BINDINGS> buffers;
+    std::array<GLintptr, MAX_BUFFER_BINDINGS> offsets;
+    std::array<GLsizeiptr, MAX_BUFFER_BINDINGS> sizes;
+
+    while (dirtyMask != 0)
     {
-        if (uniformBuffersDirtyMask & (1 << bufferIndex))
+        const auto first = static_cast<uint32_t>(std::countr_zero(dirtyMask));
+        const auto count = static_cast<uint32_t>(std::countr_one(dirtyMask >> first));
+        for (uint32_t i = 0; i < count; ++i)
         {
-            if (bindingInfo.second > 0)
-            {
-                auto* bufferObject = static_cast<ArrayBuffer*>(bindingInfo.first.get());
-                bufferObject->bindRange(bufferIndex, bindingInfo.second);
-            }
-            else
+            const auto& slot = slots[first + i];
+            if (!slot.buffer)
             {
-                auto* bufferObject = static_cast<ArrayBuffer*>(bindingInfo.first.get());
-                bufferObject->bindBase(bufferIndex);
+                buffers[i] = 0;
+                offsets[i] = 0;
+                sizes[i] = 0;
+                continue;
             }
+            // sub-allocated buffers are bound as their range of the heap buffer
+            const auto& storage = slot.buffer->getStorageBuffer();
+            const size_t bufferSize = slot.buffer->getSize();
+            buffers[i] = storage.getId();
+            offsets[i] = static_cast<GLintptr>(slot.buffer->getStorageOffset() + slot.offset);
+            sizes[i] = static_cast<GLsizeiptr>(slot.size != 0 ? slot.size : bufferSize - slot.offset);
         }
+        context.bindBuffersRange(target, first, static_cast<GLsizei>(count), buffers.data(), offsets.data(), sizes.data());
+        dirtyMask &= count == 32 ? 0u : ~(((1u << count) - 1) << first);
     }
-    uniformBuffersDirtyMask = 0;
 }
 
 void UniformBinder::clearDirtyBufferCache()
 {
-    uniformBuffersDirtyMask = 0;
+    // the buffers are not retained, none of them may outlive the command buffer that bound it
+    slots = {};
+    dirtyMask = 0;
 }
 
 }// namespace opengl
@@ -8,26 +8,44 @@
 
 #include "graphicsAPI/opengl/Context.h"
 #include "graphicsAPI/opengl/Buffer.h"
+#include <array>
 #include <memory>
-#include <unordered_map>
 
 namespace opengl {
 
+/**
+ * @brief Indexed buffer bindings of a command buffer, flushed to GL before a draw or dispatch.
+ *
+ * Bindings live in a fixed slot array and only the slots set since the last flush are bound again, each contiguous
+ * span of them with a single Context::bindBuffersRange call.
+ */
 class UniformBinder
 {
 public:
-    UniformBinder();
+    explicit UniformBinder(GLenum target = GL_UNIFORM_BUFFER);
     ~UniformBinder() = default;
 
-    void setBuffer(uint32_t index, const std::shared_ptr<Buffer>& buffer, uint32_t offset);
+    /**
+     * @brief Binds size bytes of buffer from offset to the binding point index, a size of 0 binds the rest of the buffer.
+     * The buffer is not retained, it must stay alive until bindBuffers.
+     */
+    void setBuffer(uint32_t index, Buffer* buffer, uint32_t offset, uint32_t size = 0);
     void bindBuffers(Context& context);
     void clearDirtyBufferCache();
 
-private:
-    static const uint32_t MAX_UNIFORM_BUFFERS = 16;
+    static constexpr uint32_t MAX_BUFFER_BINDINGS = 32;
 
-    std::unordered_map<uint32_t, std::pair<std::shared_ptr<Buffer>, uint32_t>> uniformBufferCache;
-    uint32_t uniformBuffersDirtyMask = 0;
+private:
+    struct Slot
+    {
+        Buffer* buffer = nullptr;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    GLenum target;
+    std::array<Slot, MAX_BUFFER_BINDINGS> slots;
+    uint32_t dirtyMask = 0;
 };
 
 }// namespace opengl
@@ -4,6 +4,8 @@
 
 #include "VertexArrayObject.h"
 
+#include "VertexInputState.h"
+
 namespace opengl {
 
 VertexArrayObject::~VertexArrayObject()
@@ -33,4 +35,73 @@ void VertexArrayObject::unbind() const
     getContext().bindVertexArray(0);
 }
 
+void VertexArrayObject::setVertexInput(const VertexInputState& vertexInput)
+{
+    separateAttribFormat = getContext().hasVertexAttribBinding();
+    for (const auto& [binding, attributes] : vertexInput.getBufferAttribMap())
+    {
+        if (binding >= MAX_VERTEX_BUFFERS || attributes.empty())
+        {
+            continue;
+        }
+        bindingAttributes[binding] = &attributes;
+        bindingStrides[binding] = attributes.front().stride;
+
+        // all the attributes of a binding share its input rate
+        if (separateAttribFormat)
+        {
+            getContext().vertexBindingDivisor(binding, attributes.front().divisor);
+        }
+        for (const auto& attrib : attributes)
+        {
+            getContext().enableVertexAttribArray(attrib.location);
+            if (separateAttribFormat)
+            {
+                getContext().vertexAttribFormat(attrib.location, attrib.numComponents, attrib.type, attrib.normalized, static_cast<GLuint>(attrib.offset));
+                getContext().vertexAttribBinding(attrib.location, binding);
+            }
+            else
+            {
+                getContext().vertexAttribDivisor(attrib.location, attrib.divisor);
+            }
+        }
+    }
+}
+
+void VertexArrayObject::bindVertexBuffer(uint32_t binding, GLuint buffer, uint32_t offset)
+{
+    if (binding >= MAX_VERTEX_BUFFERS || !bindingAttributes[binding])
+    {
+        return;
+    }
+    const BufferBinding value = {buffer, offset};
+    if (bufferBindings[binding] == value)
+    {
+        return;
+    }
+    bufferBindings[binding] = value;
+
+    if (separateAttribFormat)
+    {
+        getContext().bindVertexBuffer(binding, buffer, offset, bindingStrides[binding]);
+        return;
+    }
+    // the attribute pointers capture the buffer bound to GL_ARRAY_BUFFER
+    getContext().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (const auto& attrib : *bindingAttributes[binding])
+    {
+        getContext().vertexAttribPointer(attrib.location,
+                                         attrib.numComponents,
+                                         attrib.type,
+                                         attrib.normalized,
+                                         attrib.stride,
+                                         reinterpret_cast<const char*>(attrib.offset) + offset);
+    }
+}
+
+void VertexArrayObject::resetBufferBindings()
+{
+    bufferBindings = {};
+}
+
 } // namespace opengl
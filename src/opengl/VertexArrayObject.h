@@ -5,10 +5,18 @@
 #pragma once
 
 
+#include "graphicsAPI/common/Common.h"
 #include "graphicsAPI/opengl/Context.h"
 
+#include <array>
+#include <optional>
+#include <vector>
+
 namespace opengl {
 
+class VertexInputState;
+struct OpenGLAttributeDesc;
+
 class VertexArrayObject final : public WithContext {
     friend class Device;
 
@@ -20,8 +28,41 @@ public:
     void bind() const;
     void unbind() const;
 
+    /**
+     * @brief Enables and describes the attributes of a vertex input state, once after create(). The vertex array has
+     * to be bound.
+     */
+    void setVertexInput(const VertexInputState& vertexInput);
+    /**
+     * @brief Sources a buffer binding from offset bytes into buffer, nothing is done if it already is. The vertex
+     * array has to be bound.
+     *
+     * With separate attribute formats this is a single glBindVertexBuffer, otherwise the attribute pointers of the
+     * binding are specified again.
+     */
+    void bindVertexBuffer(uint32_t binding, GLuint buffer, uint32_t offset);
+    /**
+     * @brief Forgets the tracked buffer bindings, so that the next bindVertexBuffer calls reach GL. Deleted buffer
+     * names can be reused while a vertex array that is not bound still sources from the old buffer.
+     */
+    void resetBufferBindings();
+
 private:
+    struct BufferBinding
+    {
+        GLuint buffer = 0;
+        uint32_t offset = 0;
+
+        bool operator==(const BufferBinding&) const = default;
+    };
+
     GLuint vertexAttriuteObject_ = ~0;
+    bool separateAttribFormat = false;
+    // attributes and stride of each binding of the vertex input state, nullptr for bindings without attributes
+    std::array<const std::vector<OpenGLAttributeDesc>*, MAX_VERTEX_BUFFERS> bindingAttributes = {};
+    std::array<GLsizei, MAX_VERTEX_BUFFERS> bindingStrides = {};
+    // buffer each binding currently sources from, part of the vertex array state
+    std::array<std::optional<BufferBinding>, MAX_VERTEX_BUFFERS> bufferBindings;
 };
 
 } // namespace opengl
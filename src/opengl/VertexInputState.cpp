@@ -3,6 +3,10 @@
 //
 
 #include "VertexInputState.h"
+
+#include "VertexArrayObject.h"
+
+#include <algorithm>
 #include <stdexcept>
 
 namespace opengl {
@@ -217,11 +221,26 @@ static void toOGLAttribute(const VertexInputAttributeDesc& attrib,
     }
 }
 
-VertexInputState::VertexInputState(const VertexInputStateDesc& desc)
+VertexInputState::VertexInputState(Context& context, const VertexInputStateDesc& desc)
+    : WithContext(context)
 {
     this->populateBufferAttributes(desc);
 }
 
+VertexInputState::~VertexInputState() = default;
+
+VertexArrayObject& VertexInputState::getVertexArray() const
+{
+    if (!vertexArray)
+    {
+        vertexArray = std::make_unique<VertexArrayObject>(getContext());
+        vertexArray->create();
+        vertexArray->bind();
+        vertexArray->setVertexInput(*this);
+    }
+    return *vertexArray;
+}
+
 const std::vector<OpenGLAttributeDesc>& VertexInputState::getBufferAttributes(size_t bufferIndex) const
 {
     auto it = bufferAttribMap.find(bufferIndex);
@@ -248,9 +267,22 @@ void VertexInputState::populateBufferAttributes(const VertexInputStateDesc& desc
 
         attribDesc.location = attributeDesc.location; // todo: remove when we have a better way to query the location of the attribute in the shader program
         attribDesc.name = attributeDesc.name;
-        attribDesc.stride = bindingDescs[attributeDesc.binding].stride;
         attribDesc.offset = attributeDesc.offset;
 
+        // attributes refer to their binding by number, which is not necessarily its index in the list
+        auto bindingIt = std::ranges::find(bindingDescs, attributeDesc.binding, &VertexInputBindingDesc::binding);
+        if (bindingIt == bindingDescs.end())
+        {
+            throw std::runtime_error("Vertex attribute refers to an unknown binding");
+        }
+        attribDesc.stride = static_cast<GLsizei>(bindingIt->stride);
+        attribDesc.divisor = bindingIt->inputRate == VertexInputRate::INSTANCE ? 1 : 0;
+        if (attributeDesc.binding < bindingStrides.size())
+        {
+            bindingStrides[attributeDesc.binding] = bindingIt->stride;
+            instanceBindings[attributeDesc.binding] = bindingIt->inputRate == VertexInputRate::INSTANCE;
+        }
+
         toOGLAttribute(attributeDesc, attribDesc.numComponents, attribDesc.type, attribDesc.normalized);
 
         bufferAttribMap[attributeDesc.binding].push_back(attribDesc);
@@ -7,7 +7,10 @@
 #include "graphicsAPI/common/VertexInputState.h"
 #include "graphicsAPI/opengl/Context.h"
 
+#include <array>
+#include <bitset>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace opengl {
@@ -20,22 +23,46 @@ struct OpenGLAttributeDesc
     GLint numComponents = 0;
     GLenum type = GL_FLOAT;
     GLboolean normalized = false;
+    GLuint divisor = 0; // 0 advances per vertex, 1 per instance
     GLuint location = 0; // todo: remove when we have a better way to query the location of the attribute in the shader program
 };
 
-class VertexInputState : public IVertexInputState
+class VertexArrayObject;
+
+class VertexInputState : public IVertexInputState, public WithContext
 {
 public:
-    explicit VertexInputState(const VertexInputStateDesc& desc);
+    VertexInputState(Context& context, const VertexInputStateDesc& desc);
+    ~VertexInputState() override;
 
     [[nodiscard]] const std::vector<OpenGLAttributeDesc>& getBufferAttributes(size_t bufferIndex = 0) const;
     [[nodiscard]] const std::map<size_t, std::vector<OpenGLAttributeDesc>>& getBufferAttribMap() const { return bufferAttribMap; }
+    // stride of the vertices of a buffer binding, 0 if the binding has no attributes
+    [[nodiscard]] uint32_t getBindingStride(size_t bufferIndex) const
+    {
+        return bufferIndex < bindingStrides.size() ? bindingStrides[bufferIndex] : 0;
+    }
+    // whether the attributes of a buffer binding advance per instance, the base vertex of a draw does not offset them
+    [[nodiscard]] bool isInstanceBinding(size_t bufferIndex) const
+    {
+        return bufferIndex < instanceBindings.size() && instanceBindings[bufferIndex];
+    }
+
+    /**
+     * @brief Returns the vertex array holding the attribute setup of this input state, created and set up on first use.
+     * It is shared by every pipeline using this input state, and only its buffer bindings change between draws.
+     */
+    [[nodiscard]] VertexArrayObject& getVertexArray() const;
 
 private:
     void populateBufferAttributes(const VertexInputStateDesc& desc);
 
 private:
     std::map<size_t, std::vector<OpenGLAttributeDesc>> bufferAttribMap;
+    std::array<uint32_t, MAX_VERTEX_BUFFERS> bindingStrides = {};
+    std::bitset<MAX_VERTEX_BUFFERS> instanceBindings;
+    // created lazily, vertex arrays need a current context and are not shared between contexts
+    mutable std::unique_ptr<VertexArrayObject> vertexArray;
 };
 
 }// namespace OpenGL
@@ -0,0 +1,305 @@
+//
+// Created by Jonathan Richard on 2026-10-17.
+//
+
+#include "graphicsAPI/common/FrameGraph.h"
+#include "graphicsAPI/null/Device.h"
+
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+// throws so that a failed check ends its test, the other tests still run
+#define CHECK(condition)                                                                                          \
+    do                                                                                                            \
+    {                                                                                                             \
+        if (!(condition))                                                                                         \
+        {                                                                                                         \
+            throw std::runtime_error(std::string(__FILE__) + ":" + std::to_string(__LINE__) + ": " + #condition); \
+        }                                                                                                         \
+    } while (false)
+
+TextureDesc colorDesc(size_t width = 256, size_t height = 256)
+{
+    auto desc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8, width, height,
+                                   TextureDesc::TextureUsageBits::Attachment | TextureDesc::TextureUsageBits::Sampled);
+    desc.storage = ResourceStorage::Private;
+    return desc;
+}
+
+std::shared_ptr<IBuffer> createStorageBuffer(IDevice& device)
+{
+    BufferDesc desc;
+    desc.type = BufferDesc::BufferTypeBits::Storage | BufferDesc::BufferTypeBits::Vertex | BufferDesc::BufferTypeBits::Uniform;
+    desc.size = 1024;
+    desc.storage = ResourceStorage::Private;
+    return device.createBuffer(desc);
+}
+
+// renders into a transient texture, read by nothing
+uint32_t addUnusedPass(FrameGraph& graph, const std::string& name)
+{
+    const auto texture = graph.createTexture(name + "Target", colorDesc());
+    return graph.addGraphicsPass(name, [&](FrameGraphBuilder& builder) {
+        builder.setColorAttachment(0, texture, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+}
+
+// samples a resource and renders the result into the backbuffer
+uint32_t addPresentPass(FrameGraph& graph, const std::string& name, FrameGraphResource& backbuffer, FrameGraphResource input)
+{
+    return graph.addGraphicsPass(name, [&](FrameGraphBuilder& builder) {
+        builder.read(input);
+        backbuffer = builder.setColorAttachment(0, backbuffer);
+    }, {});
+}
+
+void testUnreadPassesAreCulled()
+{
+    null::Device device;
+    FrameGraph graph(device);
+    auto backbuffer = graph.importBackbuffer("Backbuffer");
+
+    const uint32_t unused = addUnusedPass(graph, "Unused");
+
+    FrameGraphResource scene = graph.createTexture("Scene", colorDesc());
+    const uint32_t scenePass = graph.addGraphicsPass("Scene", [&](FrameGraphBuilder& builder) {
+        scene = builder.setColorAttachment(0, scene, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+
+    // a chain whose end is never read is culled as a whole
+    FrameGraphResource chainStart = graph.createTexture("ChainStart", colorDesc());
+    const uint32_t chainFirst = graph.addGraphicsPass("ChainFirst", [&](FrameGraphBuilder& builder) {
+        chainStart = builder.setColorAttachment(0, chainStart, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    FrameGraphResource chainEnd = graph.createTexture("ChainEnd", colorDesc());
+    const uint32_t chainSecond = graph.addGraphicsPass("ChainSecond", [&](FrameGraphBuilder& builder) {
+        builder.read(chainStart);
+        chainEnd = builder.setColorAttachment(0, chainEnd, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+
+    FrameGraphResource readback = graph.createTexture("Readback", colorDesc());
+    const uint32_t sideEffect = graph.addGraphicsPass("SideEffect", [&](FrameGraphBuilder& builder) {
+        readback = builder.setColorAttachment(0, readback, Color(0.0f, 0.0f, 0.0f));
+        builder.setSideEffect();
+    }, {});
+
+    const uint32_t present = addPresentPass(graph, "Present", backbuffer, scene);
+
+    graph.compile();
+    CHECK(graph.isPassCulled(unused));
+    CHECK(!graph.isPassCulled(scenePass));
+    CHECK(graph.isPassCulled(chainFirst));
+    CHECK(graph.isPassCulled(chainSecond));
+    CHECK(!graph.isPassCulled(sideEffect));
+    CHECK(!graph.isPassCulled(present));
+    // the textures of the culled passes are never allocated
+    CHECK(graph.getTexture(chainStart) == nullptr);
+    CHECK(graph.getTexture(scene) != nullptr);
+}
+
+void testDisjointLifetimesAlias()
+{
+    null::Device device;
+    FrameGraph graph(device);
+    auto backbuffer = graph.importBackbuffer("Backbuffer");
+
+    FrameGraphResource first = graph.createTexture("First", colorDesc());
+    graph.addGraphicsPass("WriteFirst", [&](FrameGraphBuilder& builder) {
+        first = builder.setColorAttachment(0, first, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    addPresentPass(graph, "PresentFirst", backbuffer, first);
+
+    // same description, created after the last use of first
+    FrameGraphResource second = graph.createTexture("Second", colorDesc());
+    graph.addGraphicsPass("WriteSecond", [&](FrameGraphBuilder& builder) {
+        second = builder.setColorAttachment(0, second, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    // different description, cannot share a texture
+    FrameGraphResource small = graph.createTexture("Small", colorDesc(64, 64));
+    graph.addGraphicsPass("WriteSmall", [&](FrameGraphBuilder& builder) {
+        builder.read(second);
+        small = builder.setColorAttachment(0, small, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    addPresentPass(graph, "PresentSmall", backbuffer, small);
+
+    graph.compile();
+    CHECK(graph.getTexture(first) != nullptr);
+    CHECK(graph.getTexture(first) == graph.getTexture(second));
+    CHECK(graph.getTexture(small) != graph.getTexture(second));
+    CHECK(graph.getTransientTextureCount() == 2);
+}
+
+void testOverlappingLifetimesDoNotAlias()
+{
+    null::Device device;
+    FrameGraph graph(device);
+    auto backbuffer = graph.importBackbuffer("Backbuffer");
+
+    FrameGraphResource first = graph.createTexture("First", colorDesc());
+    graph.addGraphicsPass("WriteFirst", [&](FrameGraphBuilder& builder) {
+        first = builder.setColorAttachment(0, first, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    FrameGraphResource second = graph.createTexture("Second", colorDesc());
+    graph.addGraphicsPass("WriteSecond", [&](FrameGraphBuilder& builder) {
+        second = builder.setColorAttachment(0, second, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    graph.addGraphicsPass("Combine", [&](FrameGraphBuilder& builder) {
+        builder.read(first);
+        builder.read(second);
+        backbuffer = builder.setColorAttachment(0, backbuffer);
+    }, {});
+
+    graph.compile();
+    CHECK(graph.getTexture(first) != graph.getTexture(second));
+    CHECK(graph.getTransientTextureCount() == 2);
+}
+
+void testBarriersFollowStores()
+{
+    null::Device device;
+    FrameGraph graph(device);
+    auto backbuffer = graph.importBackbuffer("Backbuffer");
+    auto particles = graph.importBuffer("Particles", createStorageBuffer(device));
+
+    const uint32_t simulate = graph.addComputePass("Simulate", [&](FrameGraphBuilder& builder) {
+        particles = builder.write(particles, FrameGraphAccess::StorageWrite);
+    }, {});
+    const uint32_t draw = graph.addGraphicsPass("Draw", [&](FrameGraphBuilder& builder) {
+        builder.read(particles, FrameGraphAccess::VertexBuffer);
+        backbuffer = builder.setColorAttachment(0, backbuffer, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    // the store is already visible to vertex fetches, only the uniform reads need a barrier
+    const uint32_t drawAgain = graph.addGraphicsPass("DrawAgain", [&](FrameGraphBuilder& builder) {
+        builder.read(particles, FrameGraphAccess::VertexBuffer);
+        builder.read(particles, FrameGraphAccess::UniformBuffer);
+        backbuffer = builder.setColorAttachment(0, backbuffer);
+    }, {});
+    // attachment writes are ordered by the API, the next pass needs no barrier
+    const uint32_t overlay = graph.addGraphicsPass("Overlay", [&](FrameGraphBuilder& builder) {
+        backbuffer = builder.setColorAttachment(0, backbuffer);
+    }, {});
+
+    graph.compile();
+    CHECK(graph.getPassBarriers(simulate) == 0);
+    CHECK(graph.getPassBarriers(draw) == Barrier_VertexBuffer);
+    CHECK(graph.getPassBarriers(drawAgain) == Barrier_UniformBuffer);
+    CHECK(graph.getPassBarriers(overlay) == 0);
+
+    // the barriers are recorded in front of the render passes
+    auto commandPool = device.createCommandPool({});
+    graph.execute(*commandPool);
+    std::vector<uint32_t> recordedBarriers;
+    for (const auto& entry : device.getCommandLog())
+    {
+        if (const auto* barrier = std::get_if<null::command::Barrier>(&entry.command))
+        {
+            recordedBarriers.push_back(barrier->barriers);
+        }
+        CHECK(!std::holds_alternative<null::command::ComputeBarrier>(entry.command));
+    }
+    CHECK((recordedBarriers == std::vector<uint32_t>{Barrier_VertexBuffer, Barrier_UniformBuffer}));
+}
+
+// a pool like the deferred pools of the OpenGL backend
+class GraphicsOnlyCommandPool : public ICommandPool
+{
+public:
+    explicit GraphicsOnlyCommandPool(std::shared_ptr<ICommandPool> pool)
+        : pool(std::move(pool))
+    {
+    }
+
+    std::unique_ptr<IGraphicsCommandBuffer> acquireGraphicsCommandBuffer(const CommandBufferDesc& desc) override
+    {
+        ++acquireCount;
+        return pool->acquireGraphicsCommandBuffer(desc);
+    }
+    void submitCommandBuffer(std::unique_ptr<IGraphicsCommandBuffer> commandBuffer) override
+    {
+        pool->submitCommandBuffer(std::move(commandBuffer));
+    }
+    std::unique_ptr<IComputeCommandBuffer> acquireComputeCommandBuffer(const CommandBufferDesc& desc) override
+    {
+        throw std::runtime_error("No compute command buffers");
+    }
+    void submitCommandBuffer(std::unique_ptr<IComputeCommandBuffer> commandBuffer) override
+    {
+        pool->submitCommandBuffer(std::move(commandBuffer));
+    }
+    [[nodiscard]] bool hasComputeCommandBuffers() const override
+    {
+        return false;
+    }
+
+    uint32_t acquireCount = 0;
+
+private:
+    std::shared_ptr<ICommandPool> pool;
+};
+
+void testComputePassesNeedComputeCommandBuffers()
+{
+    null::Device device;
+    FrameGraph graph(device);
+    auto backbuffer = graph.importBackbuffer("Backbuffer");
+    auto particles = graph.importBuffer("Particles", createStorageBuffer(device));
+
+    graph.addGraphicsPass("Clear", [&](FrameGraphBuilder& builder) {
+        backbuffer = builder.setColorAttachment(0, backbuffer, Color(0.0f, 0.0f, 0.0f));
+    }, {});
+    graph.addComputePass("Simulate", [&](FrameGraphBuilder& builder) {
+        particles = builder.write(particles, FrameGraphAccess::StorageWrite);
+    }, {});
+
+    GraphicsOnlyCommandPool commandPool(device.createCommandPool({}));
+    bool threw = false;
+    try
+    {
+        graph.execute(commandPool);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+    // rejected before the graphics pass was recorded
+    CHECK(commandPool.acquireCount == 0);
+    CHECK(device.getCommandLog().empty());
+}
+
+}// namespace
+
+int main()
+{
+    const std::vector<std::pair<const char*, std::function<void()>>> tests = {
+            {"UnreadPassesAreCulled", testUnreadPassesAreCulled},
+            {"DisjointLifetimesAlias", testDisjointLifetimesAlias},
+            {"OverlappingLifetimesDoNotAlias", testOverlappingLifetimesDoNotAlias},
+            {"BarriersFollowStores", testBarriersFollowStores},
+            {"ComputePassesNeedComputeCommandBuffers", testComputePassesNeedComputeCommandBuffers},
+    };
+
+    int failures = 0;
+    for (const auto& [name, test] : tests)
+    {
+        try
+        {
+            test();
+            std::cout << "[ OK ] " << name << std::endl;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[FAIL] " << name << ": " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}